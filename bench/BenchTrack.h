@@ -0,0 +1,37 @@
+#ifndef BENCHTRACK_H
+#define BENCHTRACK_H
+
+#include "AudioTrack.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * BenchTrack - minimal AudioTrack used by the benchmarks
+ * No logging and (by default) no waveform, so timings measure the
+ * data structure under test rather than track construction.
+ */
+class BenchTrack : public AudioTrack {
+public:
+    BenchTrack(const std::string& title, int bpm = 128, size_t waveform_samples = 0,
+               const std::string& artist = "Bench Artist")
+        : AudioTrack(title, std::vector<std::string>(1, artist), 300, bpm, waveform_samples) {}
+
+    void load() override {}
+    void analyze_beatgrid() override {}
+    void prepare() const override {}
+    double get_quality_score() const override { return 100.0; }
+    PointerWrapper<AudioTrack> clone() const override {
+        return PointerWrapper<AudioTrack>(new BenchTrack(*this));
+    }
+};
+
+/**
+ * Monotonic wall clock in nanoseconds
+ */
+inline double bench_now_ns() {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+#endif // BENCHTRACK_H
@@ -0,0 +1,134 @@
+/**
+ * Batch analysis benchmark
+ * Writes a library of stereo 16-bit WAV drum loops of uneven length
+ * (10-120 s, so per-track cost varies twelvefold) to a scratch directory,
+ * then pre-analyzes it with BatchAnalyzer at 1, 2, 4 ... threads up to
+ * twice the hardware threads (or max_threads). Each run starts from fresh tracks and an
+ * empty AnalysisCache. Reports wall time, speedup over one thread,
+ * parallel efficiency and steals, and checks that the sidecar file reads
+ * back identically.
+ *
+ * Usage: bin/bench_batch_analysis [tracks] [scratch_dir] [max_threads]
+ */
+#include "AnalysisCache.h"
+#include "BatchAnalyzer.h"
+#include "WAVTrack.h"
+#include "LogSink.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const int RATE = 44100;
+
+static void put_u16(std::vector<unsigned char>& out, unsigned value) {
+    out.push_back(value & 0xFF);
+    out.push_back((value >> 8) & 0xFF);
+}
+
+static void put_u32(std::vector<unsigned char>& out, unsigned value) {
+    put_u16(out, value & 0xFFFF);
+    put_u16(out, value >> 16);
+}
+
+// Kick drum on every beat over a little noise
+static bool write_loop(const std::string& path, double bpm, double seconds, unsigned seed) {
+    size_t frames = static_cast<size_t>(seconds * RATE);
+    std::vector<unsigned char> bytes;
+    bytes.reserve(44 + frames * 4);
+    bytes.insert(bytes.end(), {'R', 'I', 'F', 'F'});
+    put_u32(bytes, static_cast<unsigned>(36 + frames * 4));
+    bytes.insert(bytes.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+    put_u32(bytes, 16);
+    put_u16(bytes, 1);
+    put_u16(bytes, 2);
+    put_u32(bytes, RATE);
+    put_u32(bytes, RATE * 4);
+    put_u16(bytes, 4);
+    put_u16(bytes, 16);
+    bytes.insert(bytes.end(), {'d', 'a', 't', 'a'});
+    put_u32(bytes, static_cast<unsigned>(frames * 4));
+
+    double period = 60.0 / bpm;
+    unsigned state = seed * 2654435761u + 1;
+    for (size_t i = 0; i < frames; ++i) {
+        double t = std::fmod(i / static_cast<double>(RATE), period);
+        state = state * 1664525u + 1013904223u;
+        double x = 0.8 * std::exp(-t * 18.0) * std::sin(6.283185307 * 55.0 * t)
+                 + 0.05 * (static_cast<int>(state >> 16) % 2001 - 1000) / 1000.0;
+        unsigned v = static_cast<unsigned>(static_cast<int>(x * 32767.0)) & 0xFFFF;
+        put_u16(bytes, v);
+        put_u16(bytes, v);
+    }
+    FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) return false;
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), out) == bytes.size();
+    return std::fclose(out) == 0 && ok;
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 24;
+    std::string dir = argc > 2 ? argv[2] : "/tmp";
+    if (count == 0) count = 1;
+
+    std::vector<std::string> paths;
+    double audio_seconds = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        double seconds = 10.0 + (i * 37) % 111;        // 10..120 s, shuffled
+        std::string path = dir + "/bench_batch_" + std::to_string(i) + ".wav";
+        if (!write_loop(path, 118.0 + (i * 7) % 30, seconds, static_cast<unsigned>(i))) {
+            std::printf("cannot write %s\n", path.c_str());
+            return 1;
+        }
+        paths.push_back(path);
+        audio_seconds += seconds;
+    }
+    unsigned hardware = std::thread::hardware_concurrency();
+    if (hardware == 0) hardware = 1;
+    std::printf("%zu tracks, %.0f s of audio, %u hardware threads\n", count, audio_seconds, hardware);
+    size_t max_threads = argc > 3 ? static_cast<size_t>(std::atoi(argv[3])) : 2 * hardware;
+
+    std::ostringstream discard;
+    LogSink::Capture quiet(discard);
+    double single_wall = 0.0;
+    BatchReport last;
+    for (size_t threads = 1; threads <= max_threads && threads <= 64; threads *= 2) {
+        AnalysisCache::instance().clear();
+        std::vector<AudioTrack*> tracks;
+        for (size_t i = 0; i < count; ++i) {
+            tracks.push_back(new WAVTrack("Loop " + std::to_string(i), std::vector<std::string>(1, "Bench"),
+                                          0, 120, RATE, 16, paths[i]));
+        }
+        BatchReport report = BatchAnalyzer(threads).run(tracks);
+        if (threads == 1) single_wall = report.wall_seconds;
+        size_t measured = 0;
+        for (const BatchTrackResult& r : report.results) measured += r.grid.valid() ? 1 : 0;
+        double speedup = single_wall / report.wall_seconds;
+        std::printf("%2zu threads: %8.1f ms wall, %6.0fx realtime, speedup %.2fx, efficiency %3.0f%%, %zu steals, %zu/%zu grids\n",
+                    threads, report.wall_seconds * 1e3, audio_seconds / report.wall_seconds, speedup,
+                    100.0 * speedup / threads, report.steals, measured, count);
+        for (AudioTrack* track : tracks) delete track;
+        last = report;
+    }
+
+    std::string sidecar = dir + "/bench_batch.bin";
+    std::vector<BatchTrackResult> back;
+    bool round_trip = BatchAnalyzer::write_sidecar(sidecar, last.results) && BatchAnalyzer::read_sidecar(sidecar, back)
+                      && back.size() == last.results.size();
+    for (size_t i = 0; round_trip && i < back.size(); ++i) {
+        round_trip = back[i].title == last.results[i].title && back[i].bpm == last.results[i].bpm
+                  && back[i].grid.beat_count == last.results[i].grid.beat_count
+                  && std::fabs(back[i].grid.bpm - last.results[i].grid.bpm) < 1e-3;
+    }
+    std::ifstream written(sidecar.c_str(), std::ios::binary | std::ios::ate);
+    std::printf("sidecar: %ld bytes for %zu tracks, read back %s\n", static_cast<long>(written.tellg()),
+                count, round_trip ? "identical" : "DIFFERENT");
+
+    std::remove(sidecar.c_str());
+    for (const std::string& path : paths) std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,114 @@
+/**
+ * Beat analysis benchmark
+ * Synthesizes stereo 16-bit drum loops (kick on every beat, hi-hat on the
+ * off-beats, noise floor) at several tempos and runs BeatAnalyzer over
+ * them with the scalar and the SIMD kernels. Reports the detected tempo
+ * and phase for each loop, then the analysis speed as seconds of audio
+ * analyzed per second of CPU time, both from mono float samples and from
+ * 16-bit PCM through PcmView (decode + downmix + analysis). Pure noise
+ * must not produce a grid.
+ *
+ * Usage: bin/bench_beat_analysis [seconds]
+ */
+#include "BeatAnalyzer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <random>
+#include <vector>
+
+static const int RATE = 44100;
+static const double TWO_PI = 6.283185307179586;
+
+// Mono loop in [-1, 1]; the first kick lands at offset seconds
+static std::vector<float> drum_loop(double bpm, double offset, double seconds, unsigned seed) {
+    size_t n = static_cast<size_t>(seconds * RATE);
+    std::vector<float> out(n);
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    double period = 60.0 / bpm;
+    for (size_t i = 0; i < n; ++i) {
+        double t = i / static_cast<double>(RATE) - offset;
+        double x = 0.05 * noise(gen);
+        if (t >= 0.0) {
+            double in_beat = std::fmod(t, period);
+            x += 0.8 * std::exp(-in_beat * 18.0) * std::sin(TWO_PI * 55.0 * in_beat);
+            double in_off = std::fmod(t + period / 2, period);
+            x += 0.2 * std::exp(-in_off * 60.0) * noise(gen);
+        }
+        out[i] = static_cast<float>(x);
+    }
+    return out;
+}
+
+static std::vector<unsigned char> to_pcm16_stereo(const std::vector<float>& mono) {
+    std::vector<unsigned char> bytes(mono.size() * 4);
+    for (size_t i = 0; i < mono.size(); ++i) {
+        long v = std::lround(std::max(-1.0f, std::min(1.0f, mono[i])) * 32767.0);
+        for (int c = 0; c < 2; ++c) {
+            bytes[4 * i + 2 * c] = static_cast<unsigned char>(v & 0xFF);
+            bytes[4 * i + 2 * c + 1] = static_cast<unsigned char>((v >> 8) & 0xFF);
+        }
+    }
+    return bytes;
+}
+
+static PcmView view_of(const std::vector<unsigned char>& bytes) {
+    PcmView view;
+    view.bytes = bytes.data();
+    view.frames = bytes.size() / 4;
+    view.channels = 2;
+    view.bits_per_sample = 16;
+    view.block_align = 4;
+    return view;
+}
+
+static double cpu_seconds() {
+    return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? std::atof(argv[1]) : 180.0;
+    if (seconds < 10.0) seconds = 10.0;
+    std::printf("SIMD kernels in this build: %s\n", BeatAnalyzer::vectorized_build() ? "SSE2" : "none");
+
+    // Accuracy over a few tempos
+    const double tempos[] = {90.0, 124.0, 128.0, 140.0, 174.0};
+    const double offset = 0.25;
+    for (double bpm : tempos) {
+        std::vector<float> loop = drum_loop(bpm, offset, 30.0, static_cast<unsigned>(bpm));
+        BeatGrid scalar = BeatAnalyzer(false).analyze(loop.data(), loop.size(), RATE);
+        BeatGrid simd = BeatAnalyzer(true).analyze(loop.data(), loop.size(), RATE);
+        std::printf("%6.1f BPM loop: detected %7.2f BPM (scalar %7.2f), first beat %.3f s, %zu beats, confidence %.2f\n",
+                    bpm, simd.bpm, scalar.bpm, simd.first_beat, simd.beat_count, simd.confidence);
+    }
+    std::vector<float> hiss(static_cast<size_t>(30.0 * RATE));
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+    for (float& x : hiss) x = noise(gen);
+    BeatGrid none = BeatAnalyzer().analyze(hiss.data(), hiss.size(), RATE);
+    std::printf("noise: %s\n", none.valid() ? "UNEXPECTED GRID" : "no grid (as expected)");
+
+    // Throughput
+    std::vector<float> mono = drum_loop(128.0, offset, seconds, 1);
+    std::vector<unsigned char> pcm = to_pcm16_stereo(mono);
+    PcmView view = view_of(pcm);
+    std::printf("\n%.0f s of 44.1 kHz audio, audio seconds analyzed per CPU second:\n", seconds);
+    for (int pass = 0; pass < 2; ++pass) {
+        bool simd = pass == 1;
+        BeatAnalyzer analyzer(simd);
+        const int reps = 5;
+        BeatGrid grid;
+        double t0 = cpu_seconds();
+        for (int r = 0; r < reps; ++r) grid = analyzer.analyze(mono.data(), mono.size(), RATE);
+        double mono_s = (cpu_seconds() - t0) / reps;
+        t0 = cpu_seconds();
+        for (int r = 0; r < reps; ++r) grid = analyzer.analyze(view, RATE);
+        double pcm_s = (cpu_seconds() - t0) / reps;
+        std::printf("  %-6s mono float %8.0fx realtime   16-bit stereo PCM %7.0fx realtime   (%.2f BPM)\n",
+                    simd ? "SIMD" : "scalar", seconds / mono_s, seconds / pcm_s, grid.bpm);
+    }
+    return 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * Deck count benchmark
+ * Renders 2, 4, 8 and 16 decks layered on top of each other (every deck
+ * audible, as with stems), free-running into a null sink at 256-frame
+ * blocks. Even decks play a 48 kHz stereo WAV loop resampled to 44.1 kHz,
+ * odd decks a click track synced to a different BPM. Reports render time
+ * per block and per deck, and deck-seconds rendered per CPU-second.
+ *
+ * Usage: bin/bench_deck_count [seconds_per_run] [scratch_dir]
+ */
+#include "AudioRenderer.h"
+#include "BenchTrack.h"
+#include "LogSink.h"
+#include "WAVTrack.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const int SOURCE_RATE = 48000;
+static const int OUTPUT_RATE = 44100;
+static const size_t BLOCK = 256;
+
+static void put_u16(std::vector<unsigned char>& out, unsigned value) {
+    out.push_back(value & 0xFF);
+    out.push_back((value >> 8) & 0xFF);
+}
+
+static void put_u32(std::vector<unsigned char>& out, unsigned value) {
+    put_u16(out, value & 0xFFFF);
+    put_u16(out, value >> 16);
+}
+
+// Kick drum on every beat, stereo 16-bit
+static bool write_loop(const std::string& path, double bpm, double seconds) {
+    size_t frames = static_cast<size_t>(seconds * SOURCE_RATE);
+    std::vector<unsigned char> bytes;
+    bytes.insert(bytes.end(), {'R', 'I', 'F', 'F'});
+    put_u32(bytes, static_cast<unsigned>(36 + frames * 4));
+    bytes.insert(bytes.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+    put_u32(bytes, 16);
+    put_u16(bytes, 1);
+    put_u16(bytes, 2);
+    put_u32(bytes, SOURCE_RATE);
+    put_u32(bytes, SOURCE_RATE * 4);
+    put_u16(bytes, 4);
+    put_u16(bytes, 16);
+    bytes.insert(bytes.end(), {'d', 'a', 't', 'a'});
+    put_u32(bytes, static_cast<unsigned>(frames * 4));
+    double period = 60.0 / bpm;
+    for (size_t i = 0; i < frames; ++i) {
+        double t = std::fmod(i / static_cast<double>(SOURCE_RATE), period);
+        double x = 0.8 * std::exp(-t * 18.0) * std::sin(6.283185307 * 55.0 * t);
+        unsigned v = static_cast<unsigned>(static_cast<int>(x * 32767.0)) & 0xFFFF;
+        put_u16(bytes, v);
+        put_u16(bytes, v);
+    }
+    FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) return false;
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), out) == bytes.size();
+    return std::fclose(out) == 0 && ok;
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? std::atof(argv[1]) : 0.5;
+    std::string dir = argc > 2 ? argv[2] : "/tmp";
+    if (seconds <= 0.0) seconds = 0.5;
+
+    std::string path = dir + "/bench_deck_count.wav";
+    if (!write_loop(path, 124.0, 30.0)) {
+        std::printf("cannot write %s\n", path.c_str());
+        return 1;
+    }
+    std::ostringstream discard;
+    LogSink::Capture quiet(discard);
+    WAVTrack loop("Loop", std::vector<std::string>(1, "Bench"), 0, 124, SOURCE_RATE, 16, path);
+    loop.load();
+    BenchTrack click("Click", 128);
+
+    std::printf("%zu-frame blocks (%.0f us of audio), every deck audible\n", BLOCK, BLOCK * 1e6 / OUTPUT_RATE);
+    size_t counts[] = {2, 4, 8, 16};
+    for (size_t decks : counts) {
+        AudioRenderer renderer(new NullSink(), BLOCK, OUTPUT_RATE, decks, false);
+        for (size_t d = 0; d < decks; ++d) {
+            renderer.load_deck(d, d % 2 == 0 ? static_cast<const AudioTrack&>(loop) : click);
+            renderer.set_deck_bpm(d, 120 + static_cast<int>(d));
+            renderer.layer_deck(d, 0.0);
+        }
+        double start = bench_now_ns();
+        renderer.start();
+        size_t reload = 0;
+        while (bench_now_ns() - start < seconds * 1e9) {
+            // Restart a WAV deck now and then so none runs out of audio
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            renderer.load_deck(reload, loop);
+            renderer.set_deck_bpm(reload, 120 + static_cast<int>(reload));
+            reload = (reload + 2) % decks;
+        }
+        renderer.stop();
+        RenderStats stats = renderer.get_stats();
+        double deck_seconds = stats.frames * static_cast<double>(decks) / OUTPUT_RATE;
+        std::printf("%2zu decks: %6.2f us/block, %5.2f us/deck/block, p99 %3.0f us, %6.0f deck-seconds per CPU-second, "
+                    "%zu blocks over budget\n",
+                    decks, stats.mean_us, stats.mean_us / decks, stats.p99_us,
+                    deck_seconds / (stats.mean_us * stats.blocks / 1e6), stats.deadline_misses);
+    }
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,136 @@
+/**
+ * HarmonicIndex benchmark at library scale
+ * Builds N synthetic tracks (default 1M; BPM 70-180, a Camelot key on 90%
+ * and an energy 1-10 on 80% of them) and answers "what can I mix next?"
+ * top-K queries (BPM +-tolerance, compatible key, energy +-2) through the
+ * index and through a linear scan scoring every track the same way.
+ * Checks that both return the same tracks and reports latency percentiles.
+ *
+ * Usage: bin/bench_harmonic_index [tracks] [queries] [k] [bpm_tolerance]
+ */
+#include "HarmonicIndex.h"
+#include "BenchTrack.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+static double percentile(std::vector<double> samples, double pct) {
+    if (samples.empty()) return 0.0;
+    std::sort(samples.begin(), samples.end());
+    size_t rank = static_cast<size_t>(pct / 100.0 * (samples.size() - 1) + 0.5);
+    return samples[rank];
+}
+
+struct Scored {
+    double score;
+    size_t order;
+};
+
+// Reference answer: score every library track as HarmonicIndex does (no half/double time)
+static std::vector<AudioTrack*> scan(const std::vector<AudioTrack*>& library, const MixQuery& query, size_t k) {
+    std::vector<Scored> kept;
+    for (size_t i = 0; i < library.size(); ++i) {
+        const AudioTrack* track = library[i];
+        if (track == query.exclude) continue;
+        int gap = std::abs(track->get_bpm() - query.bpm);
+        if (gap > query.bpm_tolerance) continue;
+        double score = gap / (query.bpm_tolerance + 1.0);
+        if (query.key >= 0 && track->get_key() >= 0) {
+            int distance = HarmonicIndex::key_distance(query.key, track->get_key());
+            if (distance > 1) continue;
+            score += distance;
+        } else {
+            score += HarmonicIndex::UNKNOWN_KEY_COST;
+        }
+        if (query.energy > 0 && track->get_energy() > 0) {
+            int energy_gap = std::abs(track->get_energy() - query.energy);
+            if (energy_gap > query.energy_tolerance) continue;
+            score += energy_gap / (query.energy_tolerance + 1.0);
+        } else {
+            score += HarmonicIndex::UNKNOWN_ENERGY_COST;
+        }
+        kept.push_back(Scored{score, i});
+    }
+    size_t n = std::min(k, kept.size());
+    std::partial_sort(kept.begin(), kept.begin() + n, kept.end(), [](const Scored& a, const Scored& b) {
+        return a.score != b.score ? a.score < b.score : a.order < b.order;
+    });
+    std::vector<AudioTrack*> result;
+    for (size_t i = 0; i < n; ++i) result.push_back(library[kept[i].order]);
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    size_t tracks = (argc > 1) ? static_cast<size_t>(std::atol(argv[1])) : 1000000;
+    size_t queries = (argc > 2) ? static_cast<size_t>(std::atol(argv[2])) : 10000;
+    size_t k = (argc > 3) ? static_cast<size_t>(std::atol(argv[3])) : 10;
+    int tolerance = (argc > 4) ? std::atoi(argv[4]) : 6;
+    size_t scan_queries = 50;
+
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<int> bpm_dist(70, 180);
+    std::uniform_int_distribution<int> key_dist(0, HarmonicIndex::KEY_COUNT - 1);
+    std::uniform_int_distribution<int> energy_dist(1, HarmonicIndex::MAX_ENERGY);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<size_t> track_dist(0, tracks - 1);
+
+    std::vector<AudioTrack*> library;
+    library.reserve(tracks);
+    for (size_t i = 0; i < tracks; ++i) {
+        AudioTrack* track = new BenchTrack("track_" + std::to_string(i), bpm_dist(gen));
+        if (percent(gen) < 90) track->set_key(key_dist(gen));
+        if (percent(gen) < 80) track->set_energy(energy_dist(gen));
+        library.push_back(track);
+    }
+
+    HarmonicIndex index;
+    double t0 = bench_now_ns();
+    index.build(library);
+    std::printf("tracks=%zu k=%zu bpm_tolerance=%d build=%.1f ms\n", tracks, k, tolerance, (bench_now_ns() - t0) / 1e6);
+
+    std::vector<MixQuery> batch;
+    for (size_t i = 0; i < queries; ++i) {
+        const AudioTrack* playing = library[track_dist(gen)];
+        MixQuery query;
+        query.bpm = playing->get_bpm();
+        query.key = playing->get_key();
+        query.energy = playing->get_energy();
+        query.bpm_tolerance = tolerance;
+        query.exclude = playing;
+        batch.push_back(query);
+    }
+
+    std::vector<double> indexed_us;
+    size_t found = 0;
+    for (const MixQuery& query : batch) {
+        t0 = bench_now_ns();
+        found += index.find_compatible(query, k).size();
+        indexed_us.push_back((bench_now_ns() - t0) / 1e3);
+    }
+
+    std::vector<double> scan_us;
+    size_t mismatches = 0;
+    for (size_t q = 0; q < scan_queries && q < batch.size(); ++q) {
+        t0 = bench_now_ns();
+        std::vector<AudioTrack*> expected = scan(library, batch[q], k);
+        scan_us.push_back((bench_now_ns() - t0) / 1e3);
+        std::vector<MixCandidate> got = index.find_compatible(batch[q], k);
+        bool same = got.size() == expected.size();
+        for (size_t i = 0; same && i < got.size(); ++i) same = got[i].track == expected[i];
+        mismatches += same ? 0 : 1;
+    }
+
+    std::printf("%-8s %10s %10s %10s %10s\n", "query", "p50 us", "p99 us", "max us", "queries");
+    std::printf("%-8s %10.1f %10.1f %10.1f %10zu\n", "indexed", percentile(indexed_us, 50), percentile(indexed_us, 99),
+                percentile(indexed_us, 100), indexed_us.size());
+    std::printf("%-8s %10.1f %10.1f %10.1f %10zu\n", "scan", percentile(scan_us, 50), percentile(scan_us, 99),
+                percentile(scan_us, 100), scan_us.size());
+    std::printf("mean results %.1f, %zu of %zu checked queries differ from the scan\n",
+                found / static_cast<double>(queries), mismatches, scan_us.size());
+
+    for (AudioTrack* track : library) delete track;
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,51 @@
+/**
+ * Library startup benchmark
+ * Times DJLibraryService::buildLibrary over N synthetic MP3/WAV entries
+ * (each track seeds its RNG and fills a 1000-sample waveform) for 1..16
+ * build threads. Console output is discarded while timing.
+ *
+ * Usage: bin/bench_library_build [tracks]
+ */
+#include "DJLibraryService.h"
+#include "BenchTrack.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    size_t tracks = (argc > 1) ? static_cast<size_t>(std::atol(argv[1])) : 20000;
+    const size_t thread_counts[] = {1, 2, 4, 8, 16};
+
+    std::vector<SessionConfig::TrackInfo> infos(tracks);
+    for (size_t i = 0; i < tracks; ++i) {
+        SessionConfig::TrackInfo& info = infos[i];
+        info.type = (i % 3 == 0) ? "WAV" : "MP3";
+        info.title = "track_" + std::to_string(i);
+        info.artists.push_back("artist_" + std::to_string(i % 997));
+        info.duration_seconds = 180 + static_cast<int>(i % 240);
+        info.bpm = 90 + static_cast<int>(i % 60);
+        info.extra_param1 = (info.type == "WAV") ? 44100 : 320;
+        info.extra_param2 = (info.type == "WAV") ? 16 : 1;
+    }
+
+    std::printf("tracks=%zu hw_threads=%u\n", tracks, std::thread::hardware_concurrency());
+    std::printf("%8s %12s %10s\n", "threads", "build ms", "speedup");
+    double serial_ms = 0;
+    for (size_t threads : thread_counts) {
+        std::streambuf* console = std::cout.rdbuf(nullptr);
+        double ms;
+        {
+            DJLibraryService library;
+            double t0 = bench_now_ns();
+            library.buildLibrary(infos, threads);
+            ms = (bench_now_ns() - t0) / 1e6;
+        }
+        std::cout.rdbuf(console);
+        if (threads == 1) serial_ms = ms;
+        std::printf("%8zu %12.1f %9.2fx\n", threads, ms, serial_ms / ms);
+    }
+    return 0;
+}
@@ -0,0 +1,102 @@
+/**
+ * LibraryIndex benchmark at library scale
+ * Builds N synthetic tracks (default 1M; 5000 artists, BPM 70-180) and
+ * compares indexed title / artist / BPM-range lookups with the linear
+ * scans they replace. Linear scans run on fewer queries since each one
+ * walks the whole library.
+ *
+ * Usage: bin/bench_library_index [tracks] [queries]
+ */
+#include "LibraryIndex.h"
+#include "BenchTrack.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    size_t tracks = (argc > 1) ? static_cast<size_t>(std::atol(argv[1])) : 1000000;
+    size_t queries = (argc > 2) ? static_cast<size_t>(std::atol(argv[2])) : 100000;
+    size_t scan_queries = 20;
+    const size_t artists = 5000;
+
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> bpm_dist(70, 180);
+    std::uniform_int_distribution<size_t> track_dist(0, tracks - 1);
+    std::uniform_int_distribution<size_t> artist_dist(0, artists - 1);
+
+    std::vector<AudioTrack*> library;
+    library.reserve(tracks);
+    for (size_t i = 0; i < tracks; ++i) {
+        int bpm = bpm_dist(gen);
+        library.push_back(new BenchTrack("track_" + std::to_string(i), bpm, 0,
+                                         "artist_" + std::to_string(artist_dist(gen))));
+    }
+
+    LibraryIndex index;
+    double t0 = bench_now_ns();
+    index.build(library);
+    double build_ms = (bench_now_ns() - t0) / 1e6;
+    std::printf("tracks=%zu artists=%zu build=%.1f ms\n", tracks, artists, build_ms);
+    std::printf("%-22s %14s %14s\n", "query", "indexed ns", "linear ns");
+
+    std::vector<std::string> titles, names;
+    for (size_t i = 0; i < queries; ++i) {
+        titles.push_back("track_" + std::to_string(track_dist(gen)));
+        names.push_back("artist_" + std::to_string(artist_dist(gen)));
+    }
+    size_t sink = 0;
+
+    // title
+    t0 = bench_now_ns();
+    for (const std::string& t : titles) sink += index.find_title(t) != nullptr;
+    double title_ns = (bench_now_ns() - t0) / queries;
+    t0 = bench_now_ns();
+    for (size_t q = 0; q < scan_queries; ++q) {
+        for (AudioTrack* track : library) {
+            if (track->get_title() == titles[q]) { sink++; break; }
+        }
+    }
+    double title_scan_ns = (bench_now_ns() - t0) / scan_queries;
+    std::printf("%-22s %14.1f %14.1f\n", "title", title_ns, title_scan_ns);
+
+    // artist
+    t0 = bench_now_ns();
+    for (const std::string& a : names) sink += index.find_artist(a).size();
+    double artist_ns = (bench_now_ns() - t0) / queries;
+    t0 = bench_now_ns();
+    for (size_t q = 0; q < scan_queries; ++q) {
+        for (AudioTrack* track : library) {
+            for (const std::string& a : track->get_artists()) sink += a == names[q];
+        }
+    }
+    double artist_scan_ns = (bench_now_ns() - t0) / scan_queries;
+    std::printf("%-22s %14.1f %14.1f\n", "artist", artist_ns, artist_scan_ns);
+
+    // BPM +-2 count (no result copy) and +-2 listing
+    std::vector<int> centers;
+    for (size_t i = 0; i < queries; ++i) centers.push_back(bpm_dist(gen));
+    t0 = bench_now_ns();
+    for (int bpm : centers) sink += index.count_bpm(bpm, 2);
+    double bpm_count_ns = (bench_now_ns() - t0) / queries;
+    t0 = bench_now_ns();
+    for (size_t q = 0; q < scan_queries; ++q) {
+        for (AudioTrack* track : library) {
+            int d = track->get_bpm() - centers[q];
+            sink += (d >= -2 && d <= 2);
+        }
+    }
+    double bpm_scan_ns = (bench_now_ns() - t0) / scan_queries;
+    std::printf("%-22s %14.1f %14.1f\n", "bpm +-2 (count)", bpm_count_ns, bpm_scan_ns);
+
+    size_t list_queries = queries / 100 ? queries / 100 : 1;
+    t0 = bench_now_ns();
+    for (size_t q = 0; q < list_queries; ++q) sink += index.find_bpm(centers[q], 2).size();
+    double bpm_list_ns = (bench_now_ns() - t0) / list_queries;
+    std::printf("%-22s %14.1f %14s\n", "bpm +-2 (list)", bpm_list_ns, "-");
+
+    if (sink == 0) std::printf("(unexpected: no results)\n");
+    for (AudioTrack* track : library) delete track;
+    return 0;
+}
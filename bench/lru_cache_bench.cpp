@@ -0,0 +1,76 @@
+/**
+ * LRUCache microbenchmark
+ * Measures per-operation latency of get/put/contains/size/evictLRU for
+ * capacities from 8 to 100k slots. With the hash index and intrusive
+ * recency list the numbers should stay flat as capacity grows.
+ *
+ * Usage: bin/bench_lru_cache [ops_per_phase]
+ */
+#include "LRUCache.h"
+#include "BenchTrack.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::string key_for(size_t n) {
+    return "track_" + std::to_string(n);
+}
+
+int main(int argc, char* argv[]) {
+    size_t ops = (argc > 1) ? static_cast<size_t>(std::atol(argv[1])) : 200000;
+    const size_t capacities[] = {8, 64, 512, 4096, 32768, 100000};
+
+    std::printf("%10s %12s %12s %12s %12s %12s\n",
+                "capacity", "get ns/op", "put ns/op", "contains", "size", "evict");
+
+    for (size_t capacity : capacities) {
+        LRUCache cache(capacity);
+        std::mt19937 gen(42);
+
+        // Pre-build every track outside the timed region
+        std::vector<AudioTrack*> fill;
+        for (size_t i = 0; i < capacity; ++i) fill.push_back(new BenchTrack(key_for(i)));
+        for (AudioTrack* t : fill) cache.put(PointerWrapper<AudioTrack>(t));
+
+        std::vector<std::string> hit_keys;
+        std::uniform_int_distribution<size_t> pick(0, capacity - 1);
+        for (size_t i = 0; i < ops; ++i) hit_keys.push_back(key_for(pick(gen)));
+
+        // get(): always a hit
+        double t0 = bench_now_ns();
+        size_t found = 0;
+        for (const std::string& k : hit_keys) found += cache.get(k) != nullptr;
+        double get_ns = (bench_now_ns() - t0) / ops;
+
+        // contains(): always a hit
+        t0 = bench_now_ns();
+        for (const std::string& k : hit_keys) found += cache.contains(k);
+        double contains_ns = (bench_now_ns() - t0) / ops;
+
+        // size()
+        t0 = bench_now_ns();
+        size_t total = 0;
+        for (size_t i = 0; i < ops; ++i) total += cache.size();
+        double size_ns = (bench_now_ns() - t0) / ops;
+
+        // put(): every insert is new and evicts the LRU entry
+        std::vector<AudioTrack*> fresh;
+        for (size_t i = 0; i < ops; ++i) fresh.push_back(new BenchTrack(key_for(capacity + i)));
+        t0 = bench_now_ns();
+        for (AudioTrack* t : fresh) cache.put(PointerWrapper<AudioTrack>(t));
+        double put_ns = (bench_now_ns() - t0) / ops;
+
+        // evictLRU(): drain the cache
+        size_t drained = cache.size();
+        t0 = bench_now_ns();
+        while (cache.evictLRU()) {}
+        double evict_ns = (bench_now_ns() - t0) / (drained ? drained : 1);
+
+        std::printf("%10zu %12.1f %12.1f %12.1f %12.1f %12.1f\n",
+                    capacity, get_ns, put_ns, contains_ns, size_ns, evict_ns);
+        if (found == 0 || total == 0) std::printf("  (unexpected: no hits)\n");
+    }
+    return 0;
+}
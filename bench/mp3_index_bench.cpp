@@ -0,0 +1,143 @@
+/**
+ * MP3 frame index benchmark
+ * Synthesizes an MPEG-1 Layer III stream (44.1 kHz stereo, default 10
+ * minutes, VBR) with a 64 KB ID3v2 tag, a Xing frame, a burst of junk in the
+ * middle and an ID3v1 tag, then reports:
+ *   - in-memory scan throughput of Mp3FrameIndex::build()
+ *   - seek lookups (binary search) against a linear scan of the table
+ *   - Mp3File open (mmap + scan) from disk, and that loading many clones of
+ *     one MP3Track indexes the file only once
+ *
+ * Usage: bin/bench_mp3_index [minutes] [scratch_dir]
+ */
+#include "MP3Track.h"
+#include "BenchTrack.h"
+#include "LogSink.h"
+#include "Mp3FrameIndex.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static const int V1_L3_KBPS[16] = {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 0};
+
+static void append_frame(std::vector<unsigned char>& out, int bitrate_index, bool xing, std::mt19937& gen) {
+    size_t bytes = 144 * V1_L3_KBPS[bitrate_index] * 1000 / 44100;
+    bool pad = (144 * V1_L3_KBPS[bitrate_index] * 1000) % 44100 != 0 && gen() % 2;
+    if (pad) ++bytes;
+    size_t start = out.size();
+    out.push_back(0xFF);
+    out.push_back(0xFB);                                            // MPEG-1, Layer III, no CRC
+    out.push_back(static_cast<unsigned char>((bitrate_index << 4) | (pad ? 0x2 : 0)));  // 44.1 kHz
+    out.push_back(0x00);                                            // stereo
+    for (size_t i = 4; i < bytes; ++i) out.push_back(static_cast<unsigned char>(gen()));
+    if (xing) {
+        std::memset(&out[start + 4], 0, 32);
+        std::memcpy(&out[start + 4 + 32], "Xing", 4);
+    }
+}
+
+// Returns the number of audio frames written
+static size_t synthesize(std::vector<unsigned char>& out, double minutes) {
+    std::mt19937 gen(1234);
+    out.clear();
+    const size_t tag = 64 * 1024;
+    const unsigned char id3[10] = {'I', 'D', '3', 4, 0, 0,
+        static_cast<unsigned char>((tag >> 21) & 0x7F), static_cast<unsigned char>((tag >> 14) & 0x7F),
+        static_cast<unsigned char>((tag >> 7) & 0x7F), static_cast<unsigned char>(tag & 0x7F)};
+    out.insert(out.end(), id3, id3 + 10);
+    out.resize(out.size() + tag, 0);
+
+    append_frame(out, 9, true, gen);
+    size_t frames = static_cast<size_t>(minutes * 60 * 44100 / 1152);
+    for (size_t i = 0; i < frames; ++i) {
+        if (i == frames / 2) {
+            for (int j = 0; j < 417; ++j) out.push_back(static_cast<unsigned char>(j * 7));   // junk
+        }
+        append_frame(out, 9 + static_cast<int>(gen() % 6), false, gen);
+    }
+    const char id3v1[128] = "TAG";
+    out.insert(out.end(), id3v1, id3v1 + 128);
+    return frames;
+}
+
+int main(int argc, char* argv[]) {
+    double minutes = (argc > 1) ? std::atof(argv[1]) : 10.0;
+    std::string dir = (argc > 2) ? argv[2] : "/tmp";
+
+    std::vector<unsigned char> stream;
+    size_t expected = synthesize(stream, minutes);
+    std::printf("stream: %.1f min, %.1f MB, %zu audio frames\n", minutes, stream.size() / 1e6, expected);
+
+    Mp3FrameIndex index;
+    std::string error;
+    const int passes = 20;
+    double t0 = bench_now_ns();
+    for (int p = 0; p < passes; ++p) index.build(stream.data(), stream.size(), true, error);
+    double scan_s = (bench_now_ns() - t0) / 1e9 / passes;
+    std::printf("scan: %.2f ms, %.0f MB/s, %.1f M frames/s\n", scan_s * 1e3, stream.size() / 1e6 / scan_s,
+                index.frame_count() / 1e6 / scan_s);
+    std::printf("index: %zu frames (%s), %.1f s, avg %d kbps %s, id3 %zu B, resynced over %zu B, table %zu B\n",
+                index.frame_count(), index.frame_count() == expected ? "matches" : "MISMATCH",
+                index.duration_seconds(), index.average_bitrate_kbps(), index.is_vbr() ? "VBR" : "CBR",
+                index.get_id3_bytes(), index.get_skipped_bytes(), index.memory_bytes());
+
+    // Seeks: binary search vs walking the table
+    const size_t seeks = 1000000;
+    std::mt19937 gen(99);
+    std::uniform_real_distribution<double> when(0.0, index.duration_seconds());
+    std::vector<double> times(seeks);
+    for (double& t : times) t = when(gen);
+    size_t checksum = 0;
+    t0 = bench_now_ns();
+    for (double t : times) checksum += index.offset_at(t);
+    double seek_ns = (bench_now_ns() - t0) / seeks;
+    size_t linear_checksum = 0;
+    const size_t linear_seeks = 2000;
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < linear_seeks; ++i) {
+        uint32_t target = static_cast<uint32_t>(times[i] * index.get_sample_rate());
+        size_t f = 0;
+        while (f + 1 < index.frame_count() && index.frame(f + 1).first_sample <= target) ++f;
+        linear_checksum += index.frame(f).offset;
+    }
+    size_t binary_checksum = 0;
+    for (size_t i = 0; i < linear_seeks; ++i) binary_checksum += index.offset_at(times[i]);
+    double linear_ns = (bench_now_ns() - t0) / linear_seeks;
+    std::printf("seek: %.1f ns (binary search) vs %.0f ns (linear), results %s (checksum %zu)\n", seek_ns,
+                linear_ns, binary_checksum == linear_checksum ? "agree" : "DIFFER", checksum % 1000);
+
+    // From disk, through tracks
+    std::string path = dir + "/bench_mp3_index.mp3";
+    FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) {
+        std::printf("cannot write %s\n", path.c_str());
+        return 1;
+    }
+    std::fwrite(stream.data(), 1, stream.size(), out);
+    std::fclose(out);
+
+    std::ostringstream discard;
+    LogSink::Capture quiet(discard);
+    size_t builds_before = Mp3File::index_builds();
+    MP3Track original("Bench MP3", std::vector<std::string>(1, "Bench Artist"), 0, 128, 0, true, path);
+    t0 = bench_now_ns();
+    original.load();
+    double open_ms = (bench_now_ns() - t0) / 1e6;
+    t0 = bench_now_ns();
+    const int clones = 1000;
+    for (int i = 0; i < clones; ++i) {
+        PointerWrapper<AudioTrack> copy = original.clone();
+        copy->load();
+    }
+    double clone_load_us = (bench_now_ns() - t0) / 1e3 / clones;
+    std::printf("file: first load %.2f ms (mmap + scan), %d clone loads %.1f us each, index builds %zu\n",
+                open_ms, clones, clone_load_us, Mp3File::index_builds() - builds_before);
+    std::printf("track: %d kbps, %d s, seek to 60 s at byte %zu\n", original.get_bitrate(),
+                original.get_duration(), original.seek_offset(60.0));
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,141 @@
+/**
+ * Playlist benchmark: contiguous store vs. the old push-front linked list
+ * Times append, find, remove and a full iteration (via getTracks()) at
+ * 100k tracks. LegacyPlaylist below is the previous implementation with
+ * the same logging, kept here only for comparison. Console output of
+ * add/remove is discarded while timing.
+ *
+ * Usage: bin/bench_playlist [tracks] [lookups]
+ */
+#include "Playlist.h"
+#include "BenchTrack.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+struct LegacyNode {
+    AudioTrack* track;
+    LegacyNode* next;
+
+    explicit LegacyNode(AudioTrack* t) : track(t), next(nullptr) {}
+};
+
+class LegacyPlaylist {
+private:
+    LegacyNode* head;
+    std::string playlist_name;
+    int track_count;
+
+    LegacyPlaylist(const LegacyPlaylist&);
+    LegacyPlaylist& operator=(const LegacyPlaylist&);
+
+public:
+    explicit LegacyPlaylist(const std::string& name) : head(nullptr), playlist_name(name), track_count(0) {}
+
+    ~LegacyPlaylist() {
+        while (head) {
+            LegacyNode* next = head->next;
+            delete head->track;
+            delete head;
+            head = next;
+        }
+    }
+
+    void add_track(AudioTrack* track) {
+        LegacyNode* node = new LegacyNode(track);
+        node->next = head;
+        head = node;
+        track_count++;
+        std::cout << "Added '" << track->get_title() << "' to playlist '" << playlist_name << "'" << std::endl;
+    }
+
+    void remove_track(const std::string& title) {
+        LegacyNode* current = head;
+        LegacyNode* prev = nullptr;
+        while (current && current->track->get_title() != title) {
+            prev = current;
+            current = current->next;
+        }
+        if (!current) return;
+        if (prev) prev->next = current->next;
+        else head = current->next;
+        delete current->track;
+        delete current;
+        track_count--;
+        std::cout << "Removed '" << title << "' from playlist" << std::endl;
+    }
+
+    AudioTrack* find_track(const std::string& title) const {
+        for (LegacyNode* current = head; current; current = current->next) {
+            if (current->track->get_title() == title) return current->track;
+        }
+        return nullptr;
+    }
+
+    std::vector<AudioTrack*> getTracks() const {
+        std::vector<AudioTrack*> tracks;
+        for (LegacyNode* current = head; current; current = current->next) tracks.push_back(current->track);
+        return tracks;
+    }
+};
+
+static std::string key_for(size_t n) {
+    return "track_" + std::to_string(n);
+}
+
+// Runs the same workload on either playlist type; times in ns per operation
+template <typename PlaylistT, typename TracksT>
+static void run(const char* label, size_t tracks, const std::vector<std::string>& lookups,
+                TracksT (PlaylistT::*get_tracks)() const) {
+    std::vector<AudioTrack*> fresh;
+    for (size_t i = 0; i < tracks; ++i) fresh.push_back(new BenchTrack(key_for(i), 120));
+
+    std::streambuf* console = std::cout.rdbuf(nullptr);
+    PlaylistT playlist("bench");
+
+    double t0 = bench_now_ns();
+    for (AudioTrack* t : fresh) playlist.add_track(t);
+    double append_ns = (bench_now_ns() - t0) / tracks;
+
+    t0 = bench_now_ns();
+    size_t found = 0;
+    for (const std::string& k : lookups) found += playlist.find_track(k) != nullptr;
+    double find_ns = (bench_now_ns() - t0) / lookups.size();
+
+    const size_t passes = 20;
+    t0 = bench_now_ns();
+    long total = 0;
+    for (size_t pass = 0; pass < passes; ++pass) {
+        for (AudioTrack* t : (playlist.*get_tracks)()) {
+            if (t) total += t->get_duration();
+        }
+    }
+    double iterate_ns = (bench_now_ns() - t0) / (passes * tracks);
+
+    t0 = bench_now_ns();
+    for (const std::string& k : lookups) playlist.remove_track(k);
+    double remove_ns = (bench_now_ns() - t0) / lookups.size();
+    std::cout.rdbuf(console);
+
+    std::printf("%-10s %12.1f %12.1f %12.2f %12.1f\n", label, append_ns, find_ns, iterate_ns, remove_ns);
+    if (found == 0 || total == 0) std::printf("  (unexpected: nothing found)\n");
+}
+
+int main(int argc, char* argv[]) {
+    size_t tracks = (argc > 1) ? static_cast<size_t>(std::atol(argv[1])) : 100000;
+    size_t lookups = (argc > 2) ? static_cast<size_t>(std::atol(argv[2])) : 2000;
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<size_t> pick(0, tracks - 1);
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < lookups; ++i) keys.push_back(key_for(pick(gen)));
+
+    std::printf("tracks=%zu lookups/removes=%zu\n", tracks, lookups);
+    std::printf("%-10s %12s %12s %12s %12s\n", "impl", "append ns", "find ns", "iterate ns", "remove ns");
+    run<LegacyPlaylist>("linked", tracks, keys, &LegacyPlaylist::getTracks);
+    run<Playlist>("contiguous", tracks, keys, &Playlist::getTracks);
+    return 0;
+}
@@ -0,0 +1,64 @@
+/**
+ * PlaylistOptimizer benchmark
+ * Shuffled playlists of N synthetic tracks (BPM 70-180, a Camelot key on
+ * 90% of them) at N = 100, 1000 and 5000. Reports the transition cost and
+ * forced syncs of the given order, of a plain sort by BPM, after the
+ * nearest-neighbour construction and after 2-opt/Or-opt, with the solver
+ * time. Checks that the result is a permutation that keeps the opener.
+ *
+ * Usage: bin/bench_playlist_optimizer [bpm_tolerance]
+ */
+#include "PlaylistOptimizer.h"
+#include "BenchTrack.h"
+#include "HarmonicIndex.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    int tolerance = argc > 1 ? std::atoi(argv[1]) : 10;
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<int> bpm_dist(70, 180);
+    std::uniform_int_distribution<int> key_dist(0, HarmonicIndex::KEY_COUNT - 1);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    std::printf("bpm_tolerance=%d\n", tolerance);
+    std::printf("%6s %22s %22s %22s %22s %9s %7s %9s\n", "tracks", "given (syncs)", "bpm sort (syncs)",
+                "nearest", "2-opt/or-opt (syncs)", "moves", "passes", "ms");
+    size_t sizes[] = {100, 1000, 5000};
+    int failures = 0;
+    for (size_t n : sizes) {
+        std::vector<AudioTrack*> playlist;
+        for (size_t i = 0; i < n; ++i) {
+            AudioTrack* track = new BenchTrack("track_" + std::to_string(i), bpm_dist(gen));
+            if (percent(gen) < 90) track->set_key(key_dist(gen));
+            playlist.push_back(track);
+        }
+
+        PlaylistOptimizer optimizer(tolerance);
+        std::vector<AudioTrack*> sorted(playlist.begin() + 1, playlist.end());
+        std::stable_sort(sorted.begin(), sorted.end(),
+                         [](const AudioTrack* a, const AudioTrack* b) { return a->get_bpm() < b->get_bpm(); });
+        sorted.insert(sorted.begin(), playlist[0]);
+
+        PlaylistPlan plan = optimizer.optimize(playlist);
+        std::set<AudioTrack*> seen(plan.order.begin(), plan.order.end());
+        bool valid = plan.order.size() == n && seen.size() == n && plan.order[0] == playlist[0];
+        if (!valid) failures++;
+
+        char given[32], by_bpm[32], after[32];
+        std::snprintf(given, sizeof(given), "%.0f (%zu)", plan.cost_before, plan.syncs_before);
+        std::snprintf(by_bpm, sizeof(by_bpm), "%.0f (%zu)", optimizer.sequence_cost(sorted),
+                      optimizer.sequence_syncs(sorted));
+        std::snprintf(after, sizeof(after), "%.0f (%zu)", plan.cost_after, plan.syncs_after);
+        std::printf("%6zu %22s %22s %22.0f %22s %4zu+%-4zu %7zu %9.1f%s\n", n, given, by_bpm, plan.cost_nearest, after,
+                    plan.two_opt_moves, plan.or_opt_moves, plan.passes, plan.milliseconds,
+                    valid ? "" : "  INVALID ORDER");
+        for (AudioTrack* track : playlist) delete track;
+    }
+    return failures == 0 ? 0 : 1;
+}
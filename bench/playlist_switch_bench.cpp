@@ -0,0 +1,176 @@
+/**
+ * Playlist switch benchmark
+ * Builds a library of WAV files on disk whose configured BPM, duration and
+ * format differ from what the files contain (plus file-less MP3 tracks),
+ * then loads random playlists from it through DJLibraryService. Reports
+ * the time per switch and checks that the switches copy no track
+ * (AudioTrack::get_allocation_stats().track_copies) and that library
+ * metadata (title, BPM, duration, quality, beat grid) and the contents of
+ * both indexes (BPM range queries and mix candidates for every track) are
+ * the same before and after them. Console output of the loads is discarded.
+ *
+ * Usage: bin/bench_playlist_switch [tracks] [playlist_length] [switches] [scratch_dir]
+ */
+#include "DJLibraryService.h"
+#include "BenchTrack.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+static const int SAMPLE_RATE = 44100;
+
+static void put_u16(std::vector<unsigned char>& out, unsigned value) {
+    out.push_back(value & 0xFF);
+    out.push_back((value >> 8) & 0xFF);
+}
+
+static void put_u32(std::vector<unsigned char>& out, unsigned value) {
+    put_u16(out, value & 0xFFFF);
+    put_u16(out, value >> 16);
+}
+
+// Kick drum on every beat, stereo 16-bit
+static bool write_loop(const std::string& path, double bpm, double seconds) {
+    size_t frames = static_cast<size_t>(seconds * SAMPLE_RATE);
+    std::vector<unsigned char> bytes;
+    bytes.insert(bytes.end(), {'R', 'I', 'F', 'F'});
+    put_u32(bytes, static_cast<unsigned>(36 + frames * 4));
+    bytes.insert(bytes.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+    put_u32(bytes, 16);
+    put_u16(bytes, 1);
+    put_u16(bytes, 2);
+    put_u32(bytes, SAMPLE_RATE);
+    put_u32(bytes, SAMPLE_RATE * 4);
+    put_u16(bytes, 4);
+    put_u16(bytes, 16);
+    bytes.insert(bytes.end(), {'d', 'a', 't', 'a'});
+    put_u32(bytes, static_cast<unsigned>(frames * 4));
+    double period = 60.0 / bpm;
+    for (size_t i = 0; i < frames; ++i) {
+        double t = std::fmod(i / static_cast<double>(SAMPLE_RATE), period);
+        double x = 0.8 * std::exp(-t * 18.0) * std::sin(6.283185307 * 55.0 * t);
+        unsigned v = static_cast<unsigned>(static_cast<int>(x * 32767.0)) & 0xFFFF;
+        put_u16(bytes, v);
+        put_u16(bytes, v);
+    }
+    FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) return false;
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), out) == bytes.size();
+    return std::fclose(out) == 0 && ok;
+}
+
+static void append_titles(std::ostringstream& out, const std::vector<AudioTrack*>& tracks) {
+    for (AudioTrack* track : tracks) out << " " << track->get_title();
+}
+
+// Everything a library query can observe: per-track metadata, then the
+// BPM-range and mix-candidate answers for every track
+static std::string snapshot(const DJLibraryService& service) {
+    std::ostringstream out;
+    const std::vector<AudioTrack*>& library = service.getLibrary();
+    for (AudioTrack* track : library) {
+        out << track->get_title() << " bpm=" << track->get_bpm() << " duration=" << track->get_duration()
+            << " quality=" << track->get_quality_score() << " grid=" << (track->get_beat_grid() ? 1 : 0) << "\n";
+    }
+    for (AudioTrack* track : library) {
+        out << "range " << track->get_title() << ":";
+        append_titles(out, service.findTracksInBpmRange(track->get_bpm(), 4));
+        out << " (" << service.countTracksInBpmRange(track->get_bpm(), 4) << ")\n";
+
+        MixQuery query;
+        query.bpm = track->get_bpm();
+        query.key = track->get_key();
+        query.energy = track->get_energy();
+        query.bpm_tolerance = 6;
+        query.half_double = track->get_beat_grid() != nullptr;
+        query.exclude = track;
+        out << "mix " << track->get_title() << ":";
+        for (const MixCandidate& candidate : service.findMixCandidates(query, 5)) {
+            out << " " << candidate.track->get_title() << (candidate.half_double ? "(x2)" : "");
+        }
+        out << "\n";
+    }
+    return out.str();
+}
+
+int main(int argc, char* argv[]) {
+    size_t track_count = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 32;
+    size_t length = argc > 2 ? static_cast<size_t>(std::atol(argv[2])) : 16;
+    int switches = argc > 3 ? std::atoi(argv[3]) : 20;
+    std::string dir = (argc > 4 ? argv[4] : "/tmp") + std::string("/bench_playlist_switch");
+    if (track_count < 2) track_count = 32;
+    if (switches < 1) switches = 1;
+
+    // even tracks: WAV files configured at half their real tempo and a
+    // different format; odd tracks: MP3 without a file
+    mkdir(dir.c_str(), 0755);
+    std::vector<std::string> files;
+    std::vector<SessionConfig::TrackInfo> infos;
+    for (size_t i = 0; i < track_count; ++i) {
+        SessionConfig::TrackInfo info;
+        info.title = "Track " + std::to_string(i + 1);
+        info.artists.push_back("Bench Artist");
+        info.duration_seconds = 300;
+        info.key = static_cast<int>(i % 4);
+        info.energy = 5 + static_cast<int>(i % 3);
+        if (i % 2 == 0) {
+            double real_bpm = 110.0 + 2.0 * (i % 10);
+            files.push_back(dir + "/loop_" + std::to_string(i) + ".wav");
+            if (!write_loop(files.back(), real_bpm, 8.0)) {
+                std::printf("cannot write %s\n", files.back().c_str());
+                return 1;
+            }
+            info.type = "WAV";
+            info.bpm = static_cast<int>(real_bpm / 2.0);
+            info.extra_param1 = 48000;
+            info.extra_param2 = 24;
+            info.file_path = files.back();
+        } else {
+            info.type = "MP3";
+            info.bpm = 60 + static_cast<int>(i % 70);
+            info.extra_param1 = 320;
+            info.extra_param2 = 1;
+        }
+        infos.push_back(info);
+    }
+
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<int> pick(1, static_cast<int>(track_count));
+    std::ostringstream discarded;
+    std::streambuf* previous = std::cout.rdbuf(discarded.rdbuf());
+
+    DJLibraryService service;
+    service.buildLibrary(infos);
+    std::string before = snapshot(service);
+
+    size_t copies_before = AudioTrack::get_allocation_stats().track_copies;
+    double start = bench_now_ns();
+    for (int s = 0; s < switches; ++s) {
+        std::vector<int> indices;
+        for (size_t i = 0; i < length; ++i) indices.push_back(pick(gen));
+        service.loadPlaylistFromIndices("Switch " + std::to_string(s), indices);
+    }
+    double ms = (bench_now_ns() - start) / 1e6;
+    size_t copies = AudioTrack::get_allocation_stats().track_copies - copies_before;
+
+    std::string after = snapshot(service);
+    std::cout.rdbuf(previous);
+
+    bool same = before == after;
+    bool copy_free = copies == 0;
+    std::printf("tracks=%zu playlist=%zu switches=%d\n", track_count, length, switches);
+    std::printf("%.3f ms per switch (first switch analyzes the files)\n", ms / switches);
+    std::printf("%zu track copies made by the switches%s\n", copies, copy_free ? "" : " (expected none)");
+    std::printf("library metadata and indexes %s after the switches\n", same ? "unchanged" : "CHANGED");
+
+    for (const std::string& file : files) std::remove(file.c_str());
+    rmdir(dir.c_str());
+    return same && copy_free ? 0 : 1;
+}
@@ -0,0 +1,76 @@
+/**
+ * Controller prefetch benchmark
+ * Plays a playlist of distinct tracks whose load() takes load_us. Between
+ * transitions the deck "plays" for play_us, which is the time the
+ * prefetcher has to prepare the next tracks. The table reports the time
+ * spent in loadTrackToCache per transition for several lookahead depths.
+ *
+ * Usage: bin/bench_prefetch [tracks] [load_us] [play_us]
+ */
+#include "DJControllerService.h"
+#include "BenchTrack.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+// BenchTrack whose load() stands in for decoding and analysis
+class SlowTrack : public BenchTrack {
+private:
+    int load_us;
+
+public:
+    SlowTrack(const std::string& title, int load_us) : BenchTrack(title), load_us(load_us) {}
+
+    void load() override { std::this_thread::sleep_for(std::chrono::microseconds(load_us)); }
+    PointerWrapper<AudioTrack> clone() const override {
+        return PointerWrapper<AudioTrack>(new SlowTrack(*this));
+    }
+};
+
+static double pct(std::vector<double> v, double p) {
+    size_t rank = static_cast<size_t>(p / 100.0 * (v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + rank, v.end());
+    return v[rank];
+}
+
+int main(int argc, char* argv[]) {
+    size_t tracks = (argc > 1) ? static_cast<size_t>(std::atol(argv[1])) : 200;
+    int load_us = (argc > 2) ? std::atoi(argv[2]) : 2000;
+    int play_us = (argc > 3) ? std::atoi(argv[3]) : 3000;
+    const size_t depths[] = {0, 1, 2, 4};
+
+    std::vector<PointerWrapper<AudioTrack>> library;
+    for (size_t i = 0; i < tracks; ++i) {
+        library.push_back(PointerWrapper<AudioTrack>(new SlowTrack("track_" + std::to_string(i), load_us)));
+    }
+
+    std::printf("tracks=%zu load=%dus play=%dus\n", tracks, load_us, play_us);
+    std::printf("%6s %10s %10s %10s %10s %8s %8s\n", "depth", "p50 us", "p95 us", "p99 us", "total ms", "hits", "wasted");
+    for (size_t depth : depths) {
+        DJControllerService controller(8);
+        controller.set_prefetch_depth(depth);
+        std::vector<double> latency;
+
+        double start = bench_now_ns();
+        for (size_t i = 0; i < tracks; ++i) {
+            for (size_t ahead = i + 1; ahead <= i + depth && ahead < tracks; ++ahead) {
+                controller.prefetchTrack(*library[ahead]);
+            }
+            double t0 = bench_now_ns();
+            controller.loadTrackToCache(*library[i]);
+            latency.push_back((bench_now_ns() - t0) / 1000.0);
+            std::this_thread::sleep_for(std::chrono::microseconds(play_us));
+        }
+        controller.finish_prefetch();
+        double total_ms = (bench_now_ns() - start) / 1e6;
+
+        PrefetchStats stats = controller.get_prefetch_stats();
+        std::printf("%6zu %10.1f %10.1f %10.1f %10.1f %8zu %8zu\n", depth,
+                    pct(latency, 50), pct(latency, 95), pct(latency, 99), total_ms, stats.hits, stats.wasted);
+    }
+    return 0;
+}
@@ -0,0 +1,185 @@
+/**
+ * Render engine benchmark
+ * 1. Command queue: one producer thread passes 4M commands-sized items to
+ *    one consumer through SpscQueue and through a mutex-guarded deque.
+ * 2. Free-running render of two decks (a 48 kHz stereo WAV loop resampled
+ *    to 44.1 kHz, and a click deck) inside one long crossfade, so every
+ *    block mixes both, at 128 and 256 frame blocks: render time per block
+ *    and speed against real time. The WAV deck is reloaded every 2 ms so it
+ *    never runs out of audio.
+ * 3. Real-time render for [seconds] while a control thread loads decks,
+ *    syncs BPM and starts crossfades every 20 ms: deadline misses and tail
+ *    render time.
+ *
+ * Usage: bin/bench_render [seconds] [scratch_dir]
+ */
+#include "AudioRenderer.h"
+#include "BenchTrack.h"
+#include "LogSink.h"
+#include "SpscQueue.h"
+#include "WAVTrack.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const int SOURCE_RATE = 48000;
+static const int OUTPUT_RATE = 44100;
+
+struct Item {
+    size_t values[5];       // the size of a render command
+};
+
+static void put_u16(std::vector<unsigned char>& out, unsigned value) {
+    out.push_back(value & 0xFF);
+    out.push_back((value >> 8) & 0xFF);
+}
+
+static void put_u32(std::vector<unsigned char>& out, unsigned value) {
+    put_u16(out, value & 0xFFFF);
+    put_u16(out, value >> 16);
+}
+
+// Kick drum on every beat, stereo 16-bit
+static bool write_loop(const std::string& path, double bpm, double seconds) {
+    size_t frames = static_cast<size_t>(seconds * SOURCE_RATE);
+    std::vector<unsigned char> bytes;
+    bytes.insert(bytes.end(), {'R', 'I', 'F', 'F'});
+    put_u32(bytes, static_cast<unsigned>(36 + frames * 4));
+    bytes.insert(bytes.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+    put_u32(bytes, 16);
+    put_u16(bytes, 1);
+    put_u16(bytes, 2);
+    put_u32(bytes, SOURCE_RATE);
+    put_u32(bytes, SOURCE_RATE * 4);
+    put_u16(bytes, 4);
+    put_u16(bytes, 16);
+    bytes.insert(bytes.end(), {'d', 'a', 't', 'a'});
+    put_u32(bytes, static_cast<unsigned>(frames * 4));
+    double period = 60.0 / bpm;
+    for (size_t i = 0; i < frames; ++i) {
+        double t = std::fmod(i / static_cast<double>(SOURCE_RATE), period);
+        double x = 0.8 * std::exp(-t * 18.0) * std::sin(6.283185307 * 55.0 * t);
+        unsigned v = static_cast<unsigned>(static_cast<int>(x * 32767.0)) & 0xFFFF;
+        put_u16(bytes, v);
+        put_u16(bytes, v);
+    }
+    FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) return false;
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), out) == bytes.size();
+    return std::fclose(out) == 0 && ok;
+}
+
+static void bench_queues() {
+    const size_t count = 4000000;
+    SpscQueue<Item> ring(256);
+    double start = bench_now_ns();
+    std::thread consumer([&] {
+        Item item;
+        size_t received = 0;
+        while (received < count) {
+            if (ring.try_pop(item)) received++;
+            else std::this_thread::yield();
+        }
+    });
+    Item item = Item();
+    for (size_t i = 0; i < count; ++i) {
+        item.values[0] = i;
+        while (!ring.try_push(item)) std::this_thread::yield();
+    }
+    consumer.join();
+    double spsc_ns = (bench_now_ns() - start) / count;
+
+    std::mutex lock;
+    std::deque<Item> queue;
+    start = bench_now_ns();
+    std::thread locked_consumer([&] {
+        size_t received = 0;
+        while (received < count) {
+            std::lock_guard<std::mutex> guard(lock);
+            if (!queue.empty()) {
+                queue.pop_front();
+                received++;
+            }
+        }
+    });
+    for (size_t i = 0; i < count; ++i) {
+        item.values[0] = i;
+        std::lock_guard<std::mutex> guard(lock);
+        queue.push_back(item);
+    }
+    locked_consumer.join();
+    double mutex_ns = (bench_now_ns() - start) / count;
+    std::printf("command queue: SPSC ring %.1f ns/item, mutex deque %.1f ns/item\n", spsc_ns, mutex_ns);
+}
+
+static void print_stats(const char* label, const RenderStats& stats, double seconds) {
+    std::printf("%-22s %7zu blocks, mean %6.2f us, p50 %4.0f us, p99 %4.0f us, max %7.1f us of %5.0f us, "
+                "%zu misses, %zu commands, %.0fx realtime\n",
+                label, stats.blocks, stats.mean_us, stats.p50_us, stats.p99_us, stats.max_us, stats.budget_us,
+                stats.deadline_misses, stats.commands, stats.frames / static_cast<double>(OUTPUT_RATE) / seconds);
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? std::atof(argv[1]) : 2.0;
+    std::string dir = argc > 2 ? argv[2] : "/tmp";
+    if (seconds <= 0.0) seconds = 2.0;
+
+    bench_queues();
+
+    std::string path = dir + "/bench_render.wav";
+    if (!write_loop(path, 124.0, 30.0)) {
+        std::printf("cannot write %s\n", path.c_str());
+        return 1;
+    }
+    std::ostringstream discard;
+    LogSink::Capture quiet(discard);
+    WAVTrack loop("Loop", std::vector<std::string>(1, "Bench"), 0, 124, SOURCE_RATE, 16, path);
+    loop.load();
+    BenchTrack click("Click", 128);
+
+    size_t block_sizes[] = {128, 256};
+    for (size_t block : block_sizes) {
+        AudioRenderer renderer(new NullSink(), block, OUTPUT_RATE, 2, false);
+        renderer.load_deck(0, loop);
+        renderer.load_deck(1, click);
+        renderer.set_deck_bpm(1, 124);
+        renderer.crossfade_to(0, 0.0);
+        renderer.crossfade_to(1, 1e6);
+        double start = bench_now_ns();
+        renderer.start();
+        while (bench_now_ns() - start < 0.5e9) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            renderer.load_deck(0, loop);
+        }
+        renderer.stop();
+        char label[32];
+        std::snprintf(label, sizeof(label), "free-running %zu:", block);
+        print_stats(label, renderer.get_stats(), (bench_now_ns() - start) / 1e9);
+    }
+
+    AudioRenderer renderer(new NullSink(), 128, OUTPUT_RATE, 2, true);
+    renderer.load_deck(0, loop);
+    renderer.crossfade_to(0, 0.0);
+    double start = bench_now_ns();
+    renderer.start();
+    size_t deck = 0;
+    for (int i = 0; bench_now_ns() - start < seconds * 1e9; ++i) {
+        deck = 1 - deck;
+        if (i % 2 == 0) renderer.load_deck(deck, click);
+        else renderer.load_deck(deck, loop);
+        renderer.set_deck_bpm(deck, 120 + i % 9);
+        renderer.crossfade_to(deck, 0.5);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    renderer.stop();
+    print_stats("real-time 128:", renderer.get_stats(), (bench_now_ns() - start) / 1e9);
+
+    std::remove(path.c_str());
+    return 0;
+}
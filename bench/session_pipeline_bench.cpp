@@ -0,0 +1,165 @@
+/**
+ * Session pipeline benchmark
+ * Plays one playlist end to end through DJSession (config, library build,
+ * playlist load, cache and deck loads, summary) in the serial and in the
+ * pipelined mode (session_pipeline=true). The library is N WAV files on
+ * disk (kick loops at different tempos) rendered to a null sink, with a
+ * small controller cache and mix suggestions after every load. Reports
+ * wall time and tracks per second per mode (best of the repeats), and
+ * checks that both modes print the same log apart from timing lines.
+ *
+ * Usage: bin/bench_session_pipeline [tracks] [playlist_length] [repeats] [scratch_dir]
+ */
+#include "DJSession.h"
+#include "BenchTrack.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+static const int SAMPLE_RATE = 44100;
+
+static void put_u16(std::vector<unsigned char>& out, unsigned value) {
+    out.push_back(value & 0xFF);
+    out.push_back((value >> 8) & 0xFF);
+}
+
+static void put_u32(std::vector<unsigned char>& out, unsigned value) {
+    put_u16(out, value & 0xFFFF);
+    put_u16(out, value >> 16);
+}
+
+// Kick drum on every beat, stereo 16-bit
+static bool write_loop(const std::string& path, double bpm, double seconds) {
+    size_t frames = static_cast<size_t>(seconds * SAMPLE_RATE);
+    std::vector<unsigned char> bytes;
+    bytes.insert(bytes.end(), {'R', 'I', 'F', 'F'});
+    put_u32(bytes, static_cast<unsigned>(36 + frames * 4));
+    bytes.insert(bytes.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+    put_u32(bytes, 16);
+    put_u16(bytes, 1);
+    put_u16(bytes, 2);
+    put_u32(bytes, SAMPLE_RATE);
+    put_u32(bytes, SAMPLE_RATE * 4);
+    put_u16(bytes, 4);
+    put_u16(bytes, 16);
+    bytes.insert(bytes.end(), {'d', 'a', 't', 'a'});
+    put_u32(bytes, static_cast<unsigned>(frames * 4));
+    double period = 60.0 / bpm;
+    for (size_t i = 0; i < frames; ++i) {
+        double t = std::fmod(i / static_cast<double>(SAMPLE_RATE), period);
+        double x = 0.8 * std::exp(-t * 18.0) * std::sin(6.283185307 * 55.0 * t);
+        unsigned v = static_cast<unsigned>(static_cast<int>(x * 32767.0)) & 0xFFFF;
+        put_u16(bytes, v);
+        put_u16(bytes, v);
+    }
+    FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) return false;
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), out) == bytes.size();
+    return std::fclose(out) == 0 && ok;
+}
+
+static bool write_config(const std::string& path, const std::vector<std::string>& tracks,
+                         const std::vector<int>& playlist, bool pipelined) {
+    std::ofstream out(path.c_str());
+    for (size_t i = 0; i < tracks.size(); ++i) {
+        out << "library_track_" << (i + 1) << "=WAV,Loop " << (i + 1) << ",{Bench;},8," << (100 + 3 * i)
+            << ",44100,16,path=" << tracks[i] << "\n";
+    }
+    out << "controller_cache_size=6\nbpm_tolerance=6\nauto_sync=true\nmixer_suggestions=5\n"
+        << "mixer_render_sink=null\nsession_pipeline=" << (pipelined ? "true" : "false") << "\nbench=";
+    for (size_t i = 0; i < playlist.size(); ++i) out << (i ? "," : "") << playlist[i];
+    out << "\n";
+    return static_cast<bool>(out);
+}
+
+// The session log without lines that depend on timing or on earlier runs in this process
+static std::string comparable(const std::string& log) {
+    static const char* skipped[] = {"Render ", "Mix suggestion queries", "Beat analysis cache", "Transition latency"};
+    std::istringstream in(log);
+    std::ostringstream out;
+    std::string line;
+    while (std::getline(in, line)) {
+        bool skip = false;
+        for (const char* prefix : skipped) skip = skip || line.compare(0, std::string(prefix).size(), prefix) == 0;
+        if (!skip) out << line << "\n";
+    }
+    return out.str();
+}
+
+// One end-to-end session; returns wall milliseconds and the log it printed
+static double run_session(std::string& log) {
+    std::ostringstream captured;
+    std::streambuf* previous = std::cout.rdbuf(captured.rdbuf());
+    double start = bench_now_ns();
+    {
+        DJSession session("Pipeline Bench", true);
+        session.simulate_dj_performance();
+    }
+    double ms = (bench_now_ns() - start) / 1e6;
+    std::cout.rdbuf(previous);
+    log = captured.str();
+    return ms;
+}
+
+int main(int argc, char* argv[]) {
+    size_t track_count = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 16;
+    size_t length = argc > 2 ? static_cast<size_t>(std::atol(argv[2])) : 200;
+    int repeats = argc > 3 ? std::atoi(argv[3]) : 3;
+    std::string dir = (argc > 4 ? argv[4] : "/tmp") + std::string("/bench_session_pipeline");
+    if (track_count == 0) track_count = 16;
+    if (repeats < 1) repeats = 1;
+
+    mkdir(dir.c_str(), 0755);
+    mkdir((dir + "/bin").c_str(), 0755);
+    std::vector<std::string> tracks;
+    for (size_t i = 0; i < track_count; ++i) {
+        tracks.push_back(dir + "/loop_" + std::to_string(i) + ".wav");
+        if (!write_loop(tracks.back(), 100.0 + 3.0 * i, 8.0)) {
+            std::printf("cannot write %s\n", tracks.back().c_str());
+            return 1;
+        }
+    }
+    std::mt19937 gen(9);
+    std::uniform_int_distribution<int> pick(1, static_cast<int>(track_count));
+    std::vector<int> playlist;
+    for (size_t i = 0; i < length; ++i) playlist.push_back(pick(gen));
+
+    // DJSession reads bin/dj_config.txt from the working directory
+    if (chdir(dir.c_str()) != 0) {
+        std::printf("cannot enter %s\n", dir.c_str());
+        return 1;
+    }
+    std::string warmup_log;
+    write_config("bin/dj_config.txt", tracks, playlist, false);
+    run_session(warmup_log);     // maps the files and fills the analysis cache
+
+    std::printf("tracks=%zu playlist=%zu repeats=%d\n", track_count, length, repeats);
+    std::printf("%-10s %10s %12s\n", "mode", "wall ms", "tracks/s");
+    const char* modes[] = {"serial", "pipelined"};
+    double best[2] = {0.0, 0.0};
+    std::string logs[2];
+    for (int r = 0; r < repeats; ++r) {
+        for (int m = 0; m < 2; ++m) {
+            write_config("bin/dj_config.txt", tracks, playlist, m == 1);
+            double ms = run_session(logs[m]);
+            if (r == 0 || ms < best[m]) best[m] = ms;
+        }
+    }
+    for (int m = 0; m < 2; ++m) std::printf("%-10s %10.1f %12.1f\n", modes[m], best[m], length / (best[m] / 1e3));
+    bool same = comparable(logs[0]) == comparable(logs[1]);
+    std::printf("pipelined/serial time %.2f, logs %s\n", best[1] / best[0], same ? "identical" : "DIFFER");
+
+    for (const std::string& track : tracks) std::remove(track.c_str());
+    std::remove("bin/dj_config.txt");
+    rmdir((dir + "/bin").c_str());
+    rmdir(dir.c_str());
+    return same ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+/**
+ * ShardedLRUCache multithreaded stress benchmark
+ * Each thread runs a 90% get / 10% put mix over a shared key space; the
+ * table reports aggregate throughput for 1..32 threads and several shard
+ * counts (1 shard = one global lock).
+ *
+ * Usage: bin/bench_sharded_cache [ops_per_thread] [capacity]
+ */
+#include "ShardedLRUCache.h"
+#include "BenchTrack.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    size_t ops = (argc > 1) ? static_cast<size_t>(std::atol(argv[1])) : 100000;
+    size_t capacity = (argc > 2) ? static_cast<size_t>(std::atol(argv[2])) : 4096;
+    const size_t key_space = capacity * 2;
+    const size_t thread_counts[] = {1, 2, 4, 8, 16, 32};
+    const size_t shard_counts[] = {1, 4, 16, 64};
+
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < key_space; ++i) keys.push_back("track_" + std::to_string(i));
+
+    std::printf("capacity=%zu keys=%zu ops/thread=%zu hw_threads=%u\n",
+                capacity, key_space, ops, std::thread::hardware_concurrency());
+    std::printf("%8s", "threads");
+    for (size_t shards : shard_counts) std::printf("   %4zu shards (Mops/s)", shards);
+    std::printf("\n");
+
+    for (size_t threads : thread_counts) {
+        std::printf("%8zu", threads);
+        for (size_t shards : shard_counts) {
+            ShardedLRUCache cache(capacity, shards);
+            for (size_t i = 0; i < capacity; ++i) {
+                cache.put(PointerWrapper<AudioTrack>(new BenchTrack(keys[i])));
+            }
+
+            std::atomic<size_t> hits(0);
+            std::vector<std::thread> workers;
+            double t0 = bench_now_ns();
+            for (size_t t = 0; t < threads; ++t) {
+                workers.push_back(std::thread([&, t]() {
+                    std::mt19937 gen(static_cast<unsigned>(t + 1));
+                    std::uniform_int_distribution<size_t> pick(0, key_space - 1);
+                    size_t local_hits = 0;
+                    for (size_t i = 0; i < ops; ++i) {
+                        const std::string& key = keys[pick(gen)];
+                        if (i % 10 == 0) {
+                            cache.put(PointerWrapper<AudioTrack>(new BenchTrack(key)));
+                        } else if (cache.get(key)) {
+                            local_hits++;
+                        }
+                    }
+                    hits += local_hits;
+                }));
+            }
+            for (auto& w : workers) w.join();
+            double seconds = (bench_now_ns() - t0) / 1e9;
+            std::printf("   %22.2f", (threads * ops) / seconds / 1e6);
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
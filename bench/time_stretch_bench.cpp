@@ -0,0 +1,197 @@
+/**
+ * Time-stretch and resampling benchmark
+ * 1. PolyphaseResampler: 96 kHz and 48 kHz to 44.1 kHz, SSE2 and scalar
+ *    kernels: CPU ms per deck-second (stereo) and the error on a 1 kHz sine.
+ * 2. TimeStretcher (WSOLA) on a 120 BPM stereo kick-and-hat loop at stretch
+ *    ratios 0.8 to 1.5, SSE2 and scalar: CPU ms per deck-second of output,
+ *    and the tempo BeatAnalyzer finds in the stretched audio.
+ * 3. The whole deck path in AudioRenderer (decode, resample, stretch) for
+ *    a 96 kHz WAV deck synced to several BPMs: render time per block and
+ *    CPU ms per deck-second.
+ *
+ * Usage: bin/bench_time_stretch [seconds] [scratch_dir]
+ */
+#include "AudioRenderer.h"
+#include "BeatAnalyzer.h"
+#include "BenchTrack.h"
+#include "DspKernels.h"
+#include "LogSink.h"
+#include "PolyphaseResampler.h"
+#include "TimeStretcher.h"
+#include "WAVTrack.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const int OUTPUT_RATE = 44100;
+static const double PI = 3.14159265358979324;
+
+// Kick on every beat and a hat on the off-beat
+static float loop_sample(double t, double bpm) {
+    double period = 60.0 / bpm;
+    double beat = std::fmod(t, period);
+    double off = std::fmod(t + period / 2.0, period);
+    double kick = 0.7 * std::exp(-beat * 18.0) * std::sin(2.0 * PI * 55.0 * beat);
+    double hat = 0.15 * std::exp(-off * 60.0) * std::sin(2.0 * PI * 6000.0 * off);
+    return static_cast<float>(kick + hat);
+}
+
+static void put_u16(std::vector<unsigned char>& out, unsigned value) {
+    out.push_back(value & 0xFF);
+    out.push_back((value >> 8) & 0xFF);
+}
+
+static void put_u32(std::vector<unsigned char>& out, unsigned value) {
+    put_u16(out, value & 0xFFFF);
+    put_u16(out, value >> 16);
+}
+
+// The loop as a stereo 16-bit WAV
+static bool write_loop(const std::string& path, int rate, double bpm, double seconds) {
+    size_t frames = static_cast<size_t>(seconds * rate);
+    std::vector<unsigned char> bytes;
+    bytes.insert(bytes.end(), {'R', 'I', 'F', 'F'});
+    put_u32(bytes, static_cast<unsigned>(36 + frames * 4));
+    bytes.insert(bytes.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+    put_u32(bytes, 16);
+    put_u16(bytes, 1);
+    put_u16(bytes, 2);
+    put_u32(bytes, static_cast<unsigned>(rate));
+    put_u32(bytes, static_cast<unsigned>(rate) * 4);
+    put_u16(bytes, 4);
+    put_u16(bytes, 16);
+    bytes.insert(bytes.end(), {'d', 'a', 't', 'a'});
+    put_u32(bytes, static_cast<unsigned>(frames * 4));
+    for (size_t i = 0; i < frames; ++i) {
+        unsigned v = static_cast<unsigned>(static_cast<int>(loop_sample(i / static_cast<double>(rate), bpm) * 32767.0))
+                     & 0xFFFF;
+        put_u16(bytes, v);
+        put_u16(bytes, v);
+    }
+    FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) return false;
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), out) == bytes.size();
+    return std::fclose(out) == 0 && ok;
+}
+
+static void bench_resampler(int input_rate, double seconds, bool vectorized) {
+    size_t in_frames = static_cast<size_t>(seconds * input_rate);
+    std::vector<float> in(in_frames + PolyphaseResampler::TAPS);
+    for (size_t i = 0; i < in.size(); ++i) in[i] = static_cast<float>(0.5 * std::sin(2.0 * PI * 1000.0 * i / input_rate));
+    PolyphaseResampler resampler(input_rate, OUTPUT_RATE, vectorized);
+    std::vector<float> out(static_cast<size_t>(seconds * OUTPUT_RATE) + 16);
+
+    // Output sample k sits at input position history() + k * step
+    double start = bench_now_ns();
+    double position = static_cast<double>(PolyphaseResampler::history());
+    size_t made = resampler.process(in.data(), in.size(), position, out.data(), out.size());
+    position = static_cast<double>(PolyphaseResampler::history());
+    resampler.process(in.data(), in.size(), position, out.data(), out.size());     // the other channel
+    double ms = (bench_now_ns() - start) / 1e6;
+
+    double error = 0.0;
+    double power = 0.0;
+    for (size_t k = 64; k + 64 < made; ++k) {
+        double t = (PolyphaseResampler::history() + k * resampler.get_step()) / input_rate;
+        double expected = 0.5 * std::sin(2.0 * PI * 1000.0 * t);
+        error += (out[k] - expected) * (out[k] - expected);
+        power += expected * expected;
+    }
+    std::printf("resample %5d -> %d Hz %-6s  %6.2f ms per deck-second, 1 kHz SNR %5.1f dB\n", input_rate, OUTPUT_RATE,
+                resampler.vectorized() ? "sse2" : "scalar", ms / (made / static_cast<double>(OUTPUT_RATE)),
+                10.0 * std::log10(power / (error + 1e-30)));
+}
+
+static void bench_stretch(const std::vector<float>& loop, double ratio, bool vectorized, bool check_tempo) {
+    const size_t block = 256;
+    TimeStretcher stretcher(OUTPUT_RATE, block, vectorized);
+    stretcher.set_ratio(ratio);
+    std::vector<float> out;
+    out.reserve(static_cast<size_t>(loop.size() / ratio) + 4096);
+    std::vector<float> pulled(block * 2);
+
+    // Feed as the renderer does: only what the next segment needs, a block at most
+    size_t fed = 0;
+    double start = bench_now_ns();
+    while (fed < loop.size()) {
+        size_t frames = std::min(std::min(stretcher.input_wanted(), block), loop.size() - fed);
+        if (frames == 0) frames = std::min(block, loop.size() - fed);
+        stretcher.push(&loop[fed], &loop[fed], frames);
+        fed += frames;
+        while (stretcher.available() >= block) {
+            stretcher.pull(pulled.data(), block);
+            for (size_t i = 0; i < block; ++i) out.push_back(pulled[2 * i]);
+        }
+    }
+    double ms = (bench_now_ns() - start) / 1e6;
+    double deck_seconds = out.size() / static_cast<double>(OUTPUT_RATE);
+
+    std::printf("stretch x%.2f %-6s  %6.2f ms per deck-second (%zu segments)", ratio,
+                stretcher.vectorized() ? "sse2" : "scalar", ms / deck_seconds, stretcher.get_segments());
+    if (check_tempo) {
+        BeatGrid grid = BeatAnalyzer().analyze(out.data(), out.size(), OUTPUT_RATE);
+        std::printf(", tempo %.1f BPM (expected %.1f)", grid.bpm, 120.0 * ratio);
+    }
+    std::printf("\n");
+}
+
+static void bench_deck(const WAVTrack& track, int bpm, double seconds) {
+    const size_t block = 256;
+    AudioRenderer renderer(new NullSink(), block, OUTPUT_RATE, 2, false);
+    renderer.load_deck(0, track);
+    renderer.set_deck_bpm(0, bpm);
+    renderer.crossfade_to(0, 0.0);
+    double start = bench_now_ns();
+    renderer.start();
+    // Reload before the 20 s loop runs out, so every block is stretched audio
+    while (bench_now_ns() - start < seconds * 1e9) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        renderer.load_deck(0, track);
+        renderer.set_deck_bpm(0, bpm);
+    }
+    renderer.stop();
+    RenderStats stats = renderer.get_stats();
+    std::printf("deck 96 kHz @ %3d BPM (x%.3f)  %6.2f us per %zu-frame block, p99 %4.0f us, %6.2f ms per "
+                "deck-second\n",
+                bpm, bpm / 120.0, stats.mean_us, block, stats.p99_us, stats.mean_us / stats.budget_us * 1e3);
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? std::atof(argv[1]) : 1.0;
+    std::string dir = argc > 2 ? argv[2] : "/tmp";
+    if (seconds <= 0.0) seconds = 1.0;
+    std::printf("kernels: %s\n", DspKernels::vectorized() ? "sse2" : "scalar");
+
+    int rates[] = {96000, 48000};
+    for (int rate : rates) {
+        bench_resampler(rate, 10.0, true);
+        bench_resampler(rate, 10.0, false);
+    }
+
+    std::vector<float> loop(static_cast<size_t>(20.0 * OUTPUT_RATE));
+    for (size_t i = 0; i < loop.size(); ++i) loop[i] = loop_sample(i / static_cast<double>(OUTPUT_RATE), 120.0);
+    double ratios[] = {0.8, 0.9, 1.0, 1.1, 1.25, 1.5};
+    for (double ratio : ratios) {
+        bench_stretch(loop, ratio, true, true);
+        bench_stretch(loop, ratio, false, false);
+    }
+
+    std::string path = dir + "/bench_time_stretch.wav";
+    if (!write_loop(path, 96000, 120.0, 20.0)) {
+        std::printf("cannot write %s\n", path.c_str());
+        return 1;
+    }
+    std::ostringstream discard;
+    LogSink::Capture quiet(discard);
+    WAVTrack track("Loop", std::vector<std::string>(1, "Bench"), 0, 120, 96000, 16, path);
+    track.load();
+    int bpms[] = {96, 120, 132, 150, 180};
+    for (int bpm : bpms) bench_deck(track, bpm, seconds);
+
+    std::remove(path.c_str());
+    return 0;
+}
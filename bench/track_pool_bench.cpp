@@ -0,0 +1,144 @@
+/**
+ * Track pool benchmark
+ * Compares pooled MP3Track objects with an otherwise identical heap-allocated
+ * subclass (a different size, so it bypasses the pool):
+ *   churn   - clone and destroy library tracks, as the cache and mixer do
+ *   scan    - iterate a library built between unrelated heap allocations
+ *             (strings standing in for parser and playlist churn) and read
+ *             every track through a virtual call
+ * and slab vs std::allocator for waveform-sized buffers (1000 doubles).
+ * Shared track data is slab-allocated in both track variants. Calls to the
+ * global operator new are counted by a replacement defined here.
+ *
+ * Usage: bin/bench_track_pool [tracks] [churn_rounds]
+ */
+#include "MP3Track.h"
+#include "BenchTrack.h"
+#include "LogSink.h"
+#include "SlabAllocator.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static std::atomic<size_t> global_news(0);
+
+void* operator new(size_t size) {
+    global_news++;
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+/**
+ * MP3Track of a different size: falls back to the global heap
+ */
+class HeapMP3Track : public MP3Track {
+private:
+    long unpooled[2];
+
+public:
+    HeapMP3Track(const std::string& title, const std::vector<std::string>& artists)
+        : MP3Track(title, artists, 200, 128, 320), unpooled() {}
+    PointerWrapper<AudioTrack> clone() const override {
+        return PointerWrapper<AudioTrack>(new HeapMP3Track(*this));
+    }
+};
+
+typedef AudioTrack* (*TrackFactory)(const std::string& title, const std::vector<std::string>& artists);
+
+static AudioTrack* make_pooled(const std::string& title, const std::vector<std::string>& artists) {
+    return new MP3Track(title, artists, 200, 128, 320);
+}
+
+static AudioTrack* make_heap(const std::string& title, const std::vector<std::string>& artists) {
+    return new HeapMP3Track(title, artists);
+}
+
+static void run(const char* name, TrackFactory make, size_t tracks, size_t rounds) {
+    std::vector<std::string> artists(1, "Bench Artist");
+    std::vector<AudioTrack*> library;
+    std::vector<std::string*> noise;
+    library.reserve(tracks);
+    noise.reserve(tracks * 3);
+    std::mt19937 gen(7);
+    for (size_t i = 0; i < tracks; ++i) {
+        library.push_back(make("track_" + std::to_string(i), artists));
+        for (int k = 0; k < 3; ++k) noise.push_back(new std::string(24 + gen() % 200, 'x'));
+    }
+    // Free most of the noise so the heap has holes, like a long-running session
+    for (size_t i = 0; i < noise.size(); ++i) {
+        if (i % 4 != 0) { delete noise[i]; noise[i] = nullptr; }
+    }
+
+    size_t news_before = global_news;
+    double t0 = bench_now_ns();
+    for (size_t r = 0; r < rounds; ++r) {
+        for (size_t i = 0; i < library.size(); i += 7) {
+            PointerWrapper<AudioTrack> copy = library[i]->clone();
+            copy->set_bpm(copy->get_bpm() + 1);
+        }
+    }
+    size_t clones = rounds * ((library.size() + 6) / 7);
+    double churn_ns = (bench_now_ns() - t0) / clones;
+    double news_per_clone = static_cast<double>(global_news - news_before) / clones;
+
+    double quality = 0;
+    t0 = bench_now_ns();
+    for (int pass = 0; pass < 20; ++pass) {
+        for (AudioTrack* track : library) quality += track->get_quality_score() + track->get_bpm();
+    }
+    double scan_ns = (bench_now_ns() - t0) / (20.0 * library.size());
+
+    std::printf("%-8s %13.1f %14.2f %12.2f %14.0f\n", name, churn_ns, news_per_clone, scan_ns, quality / 1e6);
+    for (AudioTrack* track : library) delete track;
+    for (std::string* s : noise) delete s;
+}
+
+template <typename Alloc>
+static double buffer_churn_ns(size_t rounds) {
+    std::vector<std::vector<double, Alloc>> live(64);
+    double t0 = bench_now_ns();
+    for (size_t r = 0; r < rounds; ++r) {
+        std::vector<double, Alloc>& slot = live[r % live.size()];
+        std::vector<double, Alloc>(1000).swap(slot);
+        slot[0] = static_cast<double>(r);
+    }
+    return (bench_now_ns() - t0) / rounds;
+}
+
+int main(int argc, char* argv[]) {
+    size_t tracks = (argc > 1) ? static_cast<size_t>(std::atol(argv[1])) : 200000;
+    size_t rounds = (argc > 2) ? static_cast<size_t>(std::atol(argv[2])) : 20;
+
+    std::ostringstream discard;
+    LogSink::Capture quiet(discard);
+
+    std::printf("tracks=%zu churn rounds=%zu (every 7th track cloned per round)\n", tracks, rounds);
+    std::printf("%-8s %13s %14s %12s %14s\n", "tracks", "clone+free ns", "new per clone", "scan ns", "checksum/1e6");
+    run("pooled", make_pooled, tracks, rounds);
+    run("heap", make_heap, tracks, rounds);
+    BlockPoolStats pool = MP3Track::get_pool_stats();
+    std::printf("MP3Track pool: %zu allocations, %zu slabs (%zu KB)\n",
+                pool.allocations, pool.slabs, pool.bytes_reserved / 1024);
+
+    size_t buffer_rounds = 2000000;
+    std::printf("\nwaveform buffer alloc+free (8000 B): slab %.1f ns, std::allocator %.1f ns\n",
+                buffer_churn_ns<SlabAllocator<double>>(buffer_rounds),
+                buffer_churn_ns<std::allocator<double>>(buffer_rounds));
+    return 0;
+}
@@ -0,0 +1,79 @@
+/**
+ * Lazy waveform benchmark (Linux: reads /proc/self/statm, forks per mode)
+ * Builds an N-track library (default 500k, 1000 samples per track) and
+ * reports construction time and resident memory for:
+ *   eager   - every waveform generated at construction (previous behaviour)
+ *   lazy    - metadata only; waveforms generated on first use
+ *   budget  - lazy, then every waveform read once under a 64 MB budget
+ * Each mode runs in its own process so RSS is not inherited.
+ *
+ * Usage: bin/bench_waveform [tracks] [budget_mb]
+ */
+#include "BenchTrack.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+static double rss_mb() {
+    long pages_total = 0, pages_resident = 0;
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (!statm) return 0;
+    if (std::fscanf(statm, "%ld %ld", &pages_total, &pages_resident) != 2) pages_resident = 0;
+    std::fclose(statm);
+    return pages_resident * (sysconf(_SC_PAGESIZE) / 1024.0) / 1024.0;
+}
+
+static void run(const char* mode, size_t tracks, size_t budget_mb) {
+    double base_mb = rss_mb();
+    std::vector<AudioTrack*> library;
+    library.reserve(tracks);
+
+    double t0 = bench_now_ns();
+    for (size_t i = 0; i < tracks; ++i) {
+        AudioTrack* track = new BenchTrack("track_" + std::to_string(i), 128, 1000);
+        if (std::strcmp(mode, "eager") == 0) track->get_waveform();
+        library.push_back(track);
+    }
+    double build_ms = (bench_now_ns() - t0) / 1e6;
+    double build_mb = rss_mb() - base_mb;
+
+    double touch_ms = 0;
+    if (std::strcmp(mode, "budget") == 0) {
+        AudioTrack::set_waveform_memory_budget(budget_mb << 20);
+        t0 = bench_now_ns();
+        for (AudioTrack* track : library) track->get_waveform();
+        touch_ms = (bench_now_ns() - t0) / 1e6;
+    }
+    TrackAllocationStats stats = AudioTrack::get_allocation_stats();
+    std::printf("%-8s %12.1f %12.1f %12.1f %12zu %10zu\n", mode, build_ms, build_mb,
+                rss_mb() - base_mb, stats.waveform_allocations, stats.waveform_releases);
+    if (touch_ms > 0) std::printf("%-8s read every waveform once: %.1f ms\n", "", touch_ms);
+
+    for (AudioTrack* track : library) delete track;
+}
+
+int main(int argc, char* argv[]) {
+    size_t tracks = (argc > 1) ? static_cast<size_t>(std::atol(argv[1])) : 500000;
+    size_t budget_mb = (argc > 2) ? static_cast<size_t>(std::atol(argv[2])) : 64;
+    const char* modes[] = {"eager", "lazy", "budget"};
+
+    std::printf("tracks=%zu samples/track=1000 budget=%zu MB\n", tracks, budget_mb);
+    std::printf("%-8s %12s %12s %12s %12s %10s\n", "mode", "build ms", "build MB", "final MB", "generated", "released");
+    std::fflush(stdout);
+    for (const char* mode : modes) {
+        pid_t child = fork();
+        if (child == 0) {
+            run(mode, tracks, budget_mb);
+            std::fflush(stdout);
+            _exit(0);
+        }
+        int status = 0;
+        waitpid(child, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) std::printf("%-8s failed (status %d)\n", mode, status);
+    }
+    return 0;
+}
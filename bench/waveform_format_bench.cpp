@@ -0,0 +1,133 @@
+/**
+ * Waveform storage format benchmark
+ * Part 1: N tracks (default 100k, 1000 samples each) per format, reporting
+ * bytes per resident waveform, time to materialize every waveform, time to
+ * decode every waveform back to double (get_waveform_copy), time to clone
+ * every track and detach the clone's waveform for writing (copy-on-write,
+ * which copies or widens the resident samples) and the largest decode error
+ * against f64.
+ * Part 2: conversion kernel throughput, SIMD against scalar, on a 1M-sample
+ * buffer.
+ *
+ * Usage: bin/bench_waveform_format [tracks]
+ */
+#include "BenchTrack.h"
+#include "WaveformKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * BenchTrack with write access to its waveform
+ */
+class EditableTrack : public BenchTrack {
+public:
+    EditableTrack(const std::string& title, size_t samples) : BenchTrack(title, 128, samples) {}
+    double* edit() { return mutable_waveform(); }
+    PointerWrapper<AudioTrack> clone() const override {
+        return PointerWrapper<AudioTrack>(new EditableTrack(*this));
+    }
+};
+
+static void run_format(WaveformFormat format, size_t tracks) {
+    const size_t samples = 1000;
+    std::vector<AudioTrack*> library;
+    library.reserve(tracks);
+    for (size_t i = 0; i < tracks; ++i) {
+        AudioTrack* track = new EditableTrack("track_" + std::to_string(i), samples);
+        track->set_waveform_format(format);
+        library.push_back(track);
+    }
+
+    WaveformStats before = Waveform::get_stats();
+    double t0 = bench_now_ns();
+    for (AudioTrack* track : library) track->get_waveform();
+    double materialize_ms = (bench_now_ns() - t0) / 1e6;
+    size_t bytes = Waveform::get_stats().bytes_allocated - before.bytes_allocated;
+
+    std::vector<double> decoded(samples);
+    t0 = bench_now_ns();
+    for (AudioTrack* track : library) track->get_waveform_copy(decoded.data(), samples);
+    double decode_ms = (bench_now_ns() - t0) / 1e6;
+
+    t0 = bench_now_ns();
+    for (AudioTrack* track : library) {
+        PointerWrapper<AudioTrack> copy = track->clone();
+        static_cast<EditableTrack*>(copy.get())->edit()[0] = 0.0;
+    }
+    double detach_ms = (bench_now_ns() - t0) / 1e6;
+
+    // Error of the last track against its exact samples
+    std::vector<double> exact(samples);
+    BenchTrack reference("track_" + std::to_string(tracks - 1), 128, samples);
+    reference.get_waveform_copy(exact.data(), samples);
+    double max_error = 0.0;
+    for (size_t i = 0; i < samples; ++i) max_error = std::max(max_error, std::fabs(exact[i] - decoded[i]));
+
+    std::printf("%-6s %12.1f %14.1f %12.1f %12.1f %12.2e\n", waveform_format_name(format),
+                static_cast<double>(bytes) / tracks, materialize_ms, decode_ms, detach_ms, max_error);
+    for (AudioTrack* track : library) delete track;
+}
+
+template <typename Kernel>
+static double gbps(Kernel kernel, size_t bytes_per_pass, int passes) {
+    kernel();
+    double t0 = bench_now_ns();
+    for (int p = 0; p < passes; ++p) kernel();
+    return static_cast<double>(bytes_per_pass) * passes / (bench_now_ns() - t0);
+}
+
+int main(int argc, char* argv[]) {
+    size_t tracks = (argc > 1) ? static_cast<size_t>(std::atol(argv[1])) : 100000;
+    if (tracks == 0) tracks = 1;
+
+    std::printf("tracks=%zu samples/track=1000\n", tracks);
+    std::printf("%-6s %12s %14s %12s %12s %12s\n", "format", "bytes/track", "materialize ms", "decode ms",
+                "detach ms", "max error");
+    const WaveformFormat formats[] = {WAVEFORM_F64, WAVEFORM_F32, WAVEFORM_I16, WAVEFORM_PEAKS};
+    for (WaveformFormat format : formats) run_format(format, tracks);
+
+    const size_t n = 1 << 20;
+    const int passes = 200;
+    std::vector<double> f64(n), back(n);
+    std::vector<float> f32(n);
+    std::vector<int16_t> i16(n);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    for (double& x : f64) x = dis(gen);
+    double peak = 0, sumsq = 0;
+
+    std::printf("\nkernels (%s), %zu samples, GB/s of input read\n",
+                WaveformKernels::vectorized() ? "SSE2" : "scalar build", n);
+    std::printf("%-12s %10s %10s\n", "kernel", "simd", "scalar");
+    std::printf("%-12s %10.2f %10.2f\n", "f64->f32",
+                gbps([&] { WaveformKernels::f64_to_f32(f64.data(), f32.data(), n); }, n * 8, passes),
+                gbps([&] { WaveformKernels::f64_to_f32_scalar(f64.data(), f32.data(), n); }, n * 8, passes));
+    std::printf("%-12s %10.2f %10.2f\n", "f32->f64",
+                gbps([&] { WaveformKernels::f32_to_f64(f32.data(), back.data(), n); }, n * 4, passes),
+                gbps([&] { WaveformKernels::f32_to_f64_scalar(f32.data(), back.data(), n); }, n * 4, passes));
+    std::printf("%-12s %10.2f %10.2f\n", "f64->i16",
+                gbps([&] { WaveformKernels::f64_to_i16(f64.data(), i16.data(), n); }, n * 8, passes),
+                gbps([&] { WaveformKernels::f64_to_i16_scalar(f64.data(), i16.data(), n); }, n * 8, passes));
+    std::printf("%-12s %10.2f %10.2f\n", "i16->f64",
+                gbps([&] { WaveformKernels::i16_to_f64(i16.data(), back.data(), n); }, n * 2, passes),
+                gbps([&] { WaveformKernels::i16_to_f64_scalar(i16.data(), back.data(), n); }, n * 2, passes));
+    std::printf("%-12s %10.2f %10.2f\n", "peak/sumsq",
+                gbps([&] { WaveformKernels::peak_sumsq(f64.data(), n, peak, sumsq); }, n * 8, passes),
+                gbps([&] { WaveformKernels::peak_sumsq_scalar(f64.data(), n, peak, sumsq); }, n * 8, passes));
+
+    // Both paths must agree exactly on conversions (sumsq may differ by summation order)
+    std::vector<int16_t> i16_scalar(n);
+    std::vector<float> f32_scalar(n);
+    WaveformKernels::f64_to_i16(f64.data(), i16.data(), n);
+    WaveformKernels::f64_to_i16_scalar(f64.data(), i16_scalar.data(), n);
+    WaveformKernels::f64_to_f32(f64.data(), f32.data(), n);
+    WaveformKernels::f64_to_f32_scalar(f64.data(), f32_scalar.data(), n);
+    bool same = i16 == i16_scalar && f32 == f32_scalar;
+    std::printf("simd matches scalar: %s (peak %.6f)\n", same ? "yes" : "NO", peak);
+    return same ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CachePolicy.h"
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Adaptive Replacement Cache (Megiddo & Modha)
+ *
+ * Resident keys live in T1 (seen once recently) or T2 (seen at least twice).
+ * Ghost lists B1/B2 remember keys recently evicted from T1/T2; a ghost hit
+ * shifts the target size p of T1 towards recency or frequency. A one-off
+ * scan only churns T1, so the frequently used set in T2 survives it.
+ */
+class ARCPolicy : public CachePolicy {
+private:
+    enum ListId { NONE = 0, T1 = 1, T2 = 2 };
+
+    class GhostList {
+    private:
+        std::list<std::string> keys;  // MRU first
+        std::unordered_map<std::string, std::list<std::string>::iterator> where;
+
+    public:
+        GhostList() : keys(), where() {}
+        bool contains(const std::string& key) const { return where.count(key) != 0; }
+        size_t size() const { return keys.size(); }
+        void push_front(const std::string& key);
+        void erase(const std::string& key);
+        void pop_back();
+        void clear() { keys.clear(); where.clear(); }
+    };
+
+    size_t capacity;
+    size_t target_t1;               // p: adaptive target size of T1
+    CacheSlotList t1;
+    CacheSlotList t2;
+    GhostList b1;
+    GhostList b2;
+    std::vector<unsigned char> membership;  // slot -> ListId
+
+    // Decided in before_insert(), consumed by select_victim()/on_evict()/on_insert()
+    bool pending_in_b2;
+    bool pending_ghost_hit;
+    bool drop_next_victim;          // case IV(a): victim is not remembered in B1
+
+public:
+    ARCPolicy();
+
+    const char* name() const override { return "arc"; }
+    void reset(size_t capacity) override;
+    void on_hit(std::vector<CacheSlot>& slots, size_t slot) override;
+    void before_insert(const std::string& key) override;
+    size_t select_victim(std::vector<CacheSlot>& slots) override;
+    void on_evict(std::vector<CacheSlot>& slots, size_t slot) override;
+    void on_insert(std::vector<CacheSlot>& slots, size_t slot) override;
+    PointerWrapper<CachePolicy> create_empty() const override;
+
+private:
+    void ensureSlot(size_t slot);
+};
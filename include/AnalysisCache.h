@@ -0,0 +1,98 @@
+#pragma once
+
+#include "BeatAnalyzer.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief Counters of the beat analysis cache
+ */
+struct AnalysisCacheStats {
+    size_t hits;            // lookups answered without analysis
+    size_t misses;          // lookups that ran the analyzer
+    size_t entries;
+    size_t loaded;          // entries read from the cache file
+    size_t saved;           // entries written by the last save()
+
+    AnalysisCacheStats() : hits(0), misses(0), entries(0), loaded(0), saved(0) {}
+};
+
+/**
+ * @brief Process-wide store of beat analysis results
+ *
+ * Results are keyed by track identity (type and title) and the hash of the
+ * audio file contents, so a renamed copy of a file is analyzed again under
+ * its own title and an edited file never reuses a stale grid. Failed
+ * detections are cached too. Every copy of a track looks up the same entry,
+ * so the analyzer runs once per distinct audio file.
+ *
+ * With a cache file set, entries are loaded at startup and written back by
+ * save(); a file from another analysis version is ignored. The file is
+ * plain text, one entry per line:
+ *   content_hash<TAB>bpm<TAB>first_beat<TAB>beat_count<TAB>confidence<TAB>type<TAB>title
+ *
+ * Thread-safe; the analyzer runs outside the lock.
+ */
+class AnalysisCache {
+public:
+    static const int VERSION = 1;   // bump when BeatAnalyzer results change
+
+private:
+    mutable std::mutex lock;
+    std::unordered_map<std::string, std::shared_ptr<const BeatGrid>> entries;
+    std::string file_path;
+    bool dirty;                     // entries added since the last load/save
+    AnalysisCacheStats stats;
+
+    AnalysisCache();
+
+    // Rule of Three: a single process-wide instance
+    AnalysisCache(const AnalysisCache&);
+    AnalysisCache& operator=(const AnalysisCache&);
+
+public:
+    static AnalysisCache& instance();
+
+    /**
+     * @brief The cached grid of a track's audio, running analyze() on a miss
+     * @return The grid (possibly invalid if no tempo was found); never nullptr
+     */
+    std::shared_ptr<const BeatGrid> beat_grid(const std::string& type, const std::string& title,
+                                              uint64_t content_hash, const std::function<BeatGrid()>& analyze);
+
+    /**
+     * @brief The cached grid of a track's audio, without analyzing on a miss
+     * @return The grid (counted as a hit), or nullptr if the audio was never analyzed
+     */
+    std::shared_ptr<const BeatGrid> find(const std::string& type, const std::string& title,
+                                         uint64_t content_hash);
+
+    /**
+     * @brief Whether any result is stored (loaded from the file or analyzed)
+     */
+    bool empty() const;
+
+    /**
+     * @brief Use path as the on-disk store and load its entries
+     * @return Number of entries loaded (0 if the file is missing or from another version)
+     */
+    size_t open_file(const std::string& path);
+
+    /**
+     * @brief Write all entries to the cache file if any were added
+     * @return false if the file cannot be written
+     */
+    bool save();
+
+    const std::string& get_file() const { return file_path; }
+    AnalysisCacheStats get_stats() const;
+    void clear();
+
+private:
+    static std::string make_key(const std::string& type, const std::string& title, uint64_t content_hash);
+};
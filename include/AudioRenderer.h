@@ -0,0 +1,256 @@
+#pragma once
+
+#include "AudioSink.h"
+#include "AudioTrack.h"
+#include "PointerWrapper.h"
+#include "PolyphaseResampler.h"
+#include "SpscQueue.h"
+#include "TimeStretcher.h"
+#include "WavFile.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Render thread counters (a consistent snapshot only once stopped, or
+ * after sync() in on-demand mode)
+ */
+struct RenderStats {
+    size_t blocks;
+    size_t frames;
+    size_t commands;            // control commands applied (by the render thread, or directly while it is stopped)
+    size_t deadline_misses;     // blocks finished after their deadline
+    size_t dropped_blocks;      // blocks the sink could not take
+    double budget_us;           // one block of audio
+    double mean_us;             // render time per block (mix + sink write)
+    double p50_us;
+    double p99_us;
+    double max_us;
+
+    RenderStats() : blocks(0), frames(0), commands(0), deadline_misses(0), dropped_blocks(0), budget_us(0.0),
+                    mean_us(0.0), p50_us(0.0), p99_us(0.0), max_us(0.0) {}
+};
+
+/**
+ * @brief Real-time renderer: N decks -> equal-power fades -> sink, on its own thread
+ *
+ * The render thread produces interleaved stereo blocks of block_frames at
+ * sample_rate. Each block it applies pending commands, renders every
+ * audible deck, sums them and hands the block to the sink.
+ *
+ * A deck's gain is sin(theta), theta moving between 0 (silent) and pi/2
+ * (full) at a constant rate during a fade, interpolated linearly within a
+ * block. A crossfade raises one deck while lowering every other one at the
+ * same rate, so two crossing decks play at sin/cos gains and their summed
+ * power stays constant; a layered deck fades in on top of the others.
+ * Silent decks are not rendered and hold their position.
+ *
+ * Control methods (load_deck, set_deck_bpm, set_auto_sync, crossfade_to)
+ * run on one control thread and reach the render thread only through a
+ * lock-free SPSC command queue. Everything the render thread touches is
+ * allocated up front: a deck's audio source is built on the control thread,
+ * and a replaced source goes back through a second SPSC queue so it is
+ * also freed there. The audio path never locks, allocates or frees.
+ *
+ * A deck plays its track's mapped PCM when it is a WAVTrack with a file,
+ * and otherwise a click on every beat at the track's BPM. PCM goes through
+ * a polyphase resampler when the file's rate differs from the output rate,
+ * then through a WSOLA time-stretcher running at the deck's sync ratio, so
+ * a synced deck changes tempo but keeps its pitch. Both work a block at a
+ * time and a new ratio applies from the stretcher's next segment, so BPM
+ * changes are followed live.
+ *
+ * In real-time mode each block is due one block period after the previous
+ * one and the thread sleeps until it is; a block that finishes after its
+ * due time is a deadline miss. Free-running mode renders back to back and
+ * counts a miss when one block takes longer than its period. On-demand mode
+ * is free-running too, but only renders the blocks advance() asks for, and
+ * only when the sink can take them, then idles until the next advance(); a
+ * simulated session uses it to render each transition without pacing.
+ */
+class AudioRenderer {
+public:
+    static const size_t MIN_BLOCK_FRAMES = 16;
+    static const size_t COMMAND_QUEUE_SIZE = 256;
+    static const size_t MAX_CHANNELS = 8;       // PCM channels a deck can read (first two are played)
+    static const double MAX_STEP;               // source frames per output frame (rate conversion), at most
+
+private:
+    struct DeckSource {
+        PointerWrapper<AudioTrack> track;   // keeps the mapped file alive; not used by the render thread
+        PcmView pcm;                        // file audio, empty for a click track
+        double beat_frames;                 // click track: frames per beat at the output rate, 0 for PCM
+        double source_rate;                 // source frames per second
+        double bpm;                         // native tempo the sync ratio is relative to
+        PointerWrapper<PolyphaseResampler> resampler;   // PCM at another rate than the output
+
+        DeckSource() : track(), pcm(), beat_frames(0.0), source_rate(0.0), bpm(0.0), resampler() {}
+    };
+
+    enum CommandType { LOAD_DECK, SET_RATE, SET_AUTO_SYNC, CROSSFADE, LAYER };
+
+    struct Command {
+        CommandType type;
+        size_t deck;
+        DeckSource* source;         // LOAD_DECK
+        double value;               // SET_RATE ratio, SET_AUTO_SYNC 0/1
+        size_t frames;              // CROSSFADE/LAYER length
+
+        Command() : type(LOAD_DECK), deck(0), source(nullptr), value(0.0), frames(0) {}
+    };
+
+    // Render-thread state of one deck
+    struct Deck {
+        DeckSource* source;
+        double position;            // click track: frames into the current beat
+        double rate;                // sync ratio (1 = native tempo)
+        double theta;               // gain sin(theta), 0..pi/2
+        double theta_target;
+        double theta_step;          // per frame while fading
+        size_t source_frame;        // next PCM frame to decode
+        size_t tail;                // silent frames fed to the stretcher since the PCM ended
+        std::vector<float> history_left;    // decoded PCM the resampler reads, planar
+        std::vector<float> history_right;
+        size_t history_count;
+        double resample_position;   // in history frames
+        std::vector<float> chunk_left;      // output-rate PCM on its way to the stretcher
+        std::vector<float> chunk_right;
+        PointerWrapper<TimeStretcher> stretcher;
+        std::vector<float> scratch; // decoded interleaved PCM
+        std::vector<float> out;     // rendered stereo block
+
+        Deck() : source(nullptr), position(0.0), rate(1.0), theta(0.0), theta_target(0.0), theta_step(0.0),
+                 source_frame(0), tail(0), history_left(), history_right(), history_count(0),
+                 resample_position(0.0), chunk_left(), chunk_right(), stretcher(), scratch(), out() {}
+
+    private:
+        // Rule of Three: the renderer owns source; decks are never copied
+        Deck(const Deck&);
+        Deck& operator=(const Deck&);
+    };
+
+    size_t block_frames;
+    int sample_rate;
+    bool realtime;
+    bool on_demand;                 // set before start()
+    PointerWrapper<AudioSink> sink;
+
+    SpscQueue<Command> commands;            // control -> render
+    SpscQueue<DeckSource*> retired;         // render -> control, sources to free
+
+    // Render thread only
+    std::vector<Deck> decks;
+    std::vector<float> mix;
+    std::vector<float> click;       // one click at the output rate, shared by click decks
+    bool auto_sync;
+
+    // Control thread only
+    std::vector<double> deck_bpm;   // native tempo of the source last loaded per deck
+    size_t posted;                  // commands posted so far
+
+    std::thread render_thread;
+    std::atomic<bool> running;
+    std::atomic<size_t> blocks;
+    std::atomic<size_t> applied;
+    std::atomic<size_t> block_limit;                // on-demand mode: render up to this many blocks
+    std::atomic<size_t> misses;
+    std::atomic<uint64_t> total_ns;
+    std::atomic<uint64_t> max_ns;
+    std::vector<std::atomic<uint32_t>> histogram;   // render time per block, 1 us buckets
+
+    // Rule of Three: owns a thread and raw deck sources
+    AudioRenderer(const AudioRenderer&);
+    AudioRenderer& operator=(const AudioRenderer&);
+
+public:
+    /**
+     * @param sink Receives the blocks (ownership taken)
+     * @param block_frames Frames per block (MIN_BLOCK_FRAMES..AudioSink::MAX_BLOCK_FRAMES)
+     * @param realtime Pace blocks at the audio rate; false renders as fast as possible
+     */
+    AudioRenderer(AudioSink* sink, size_t block_frames, int sample_rate, size_t deck_count = 2, bool realtime = true);
+    ~AudioRenderer();
+
+    void start();
+
+    /**
+     * @brief Stop the render thread and close the sink (idempotent)
+     */
+    void stop();
+
+    bool is_running() const { return running; }
+
+    /**
+     * @brief Render only the audio advance() asks for, as fast as the sink
+     * takes it (call before start(); deadlines are then free-running ones)
+     */
+    void set_on_demand(bool enabled) { on_demand = enabled; }
+
+    /**
+     * @brief On-demand mode: render seconds more audio (at least one block)
+     * and wait until the render thread has done so
+     */
+    void advance(double seconds);
+
+    /**
+     * @brief On-demand mode: wait until every posted command is applied and
+     * the requested audio is rendered; the thread then idles, so get_stats()
+     * is a consistent snapshot until the next control call
+     */
+    void sync();
+
+    // ========== CONTROL (one control thread) ==========
+
+    /**
+     * @brief Put a copy of track on a deck, replacing its audio (starts silent until faded in)
+     */
+    void load_deck(size_t deck, const AudioTrack& track);
+
+    /**
+     * @brief Play a deck at bpm (the ratio to the native tempo of its track)
+     */
+    void set_deck_bpm(size_t deck, int bpm);
+
+    /**
+     * @brief With auto sync off, decks play at their native tempo
+     */
+    void set_auto_sync(bool enabled);
+
+    /**
+     * @brief Equal-power crossfade to deck over seconds (0 = cut): every other deck fades out
+     */
+    void crossfade_to(size_t deck, double seconds);
+
+    /**
+     * @brief Fade deck in over seconds on top of the decks already playing (e.g. stems)
+     */
+    void layer_deck(size_t deck, double seconds);
+
+    // ========== STATS ==========
+
+    RenderStats get_stats() const;
+    size_t get_block_frames() const { return block_frames; }
+    int get_sample_rate() const { return sample_rate; }
+    size_t get_deck_count() const { return decks.size(); }
+    double block_budget_us() const { return block_frames * 1e6 / sample_rate; }
+    const AudioSink& get_sink() const { return *sink; }
+
+private:
+    void post(const Command& command);
+    void collect_retired();
+    DeckSource* make_source(const AudioTrack& track) const;
+
+    void run();
+    void apply(const Command& command);
+    void render_block(float* out);
+    void render_deck(Deck& deck);
+    void render_click(Deck& deck);
+    void read_source(Deck& deck, size_t frames);
+    size_t decode_planar(Deck& deck, float* left, float* right, size_t frames);
+    void rewind(Deck& deck);
+    void start_fade(Deck& deck, double target, size_t frames);
+    void record(uint64_t ns);
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "SpscQueue.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Destination of the mixer's rendered audio
+ *
+ * write() is called on the render thread once per block with interleaved
+ * stereo floats in [-1, 1]; it must not block or allocate. A sink that
+ * cannot take a block drops it and counts it in dropped_blocks().
+ */
+class AudioSink {
+public:
+    static const size_t MAX_BLOCK_FRAMES = 1024;
+
+    virtual ~AudioSink() {}
+
+    /**
+     * @return false if the block was dropped
+     */
+    virtual bool write(const float* interleaved, size_t frames) = 0;
+
+    /**
+     * @brief Flush and release the destination (control thread, after rendering stopped)
+     */
+    virtual void close() {}
+
+    virtual size_t frames_written() const = 0;
+    virtual size_t dropped_blocks() const { return 0; }
+
+    /**
+     * @brief Whether write() would take a block right now (render thread)
+     */
+    virtual bool ready() const { return true; }
+    virtual std::string describe() const = 0;
+
+    /**
+     * @brief Sink for a config value: "null", or the path of a .wav file to create
+     * @return nullptr (with why set) if the file cannot be created
+     */
+    static AudioSink* create(const std::string& spec, int sample_rate, std::string& why);
+};
+
+/**
+ * @brief Discards the audio, counting frames
+ */
+class NullSink : public AudioSink {
+private:
+    std::atomic<size_t> frames;
+
+public:
+    NullSink() : frames(0) {}
+
+    bool write(const float* interleaved, size_t count) override;
+    size_t frames_written() const override { return frames; }
+    std::string describe() const override { return "null sink"; }
+};
+
+/**
+ * @brief Writes a 16-bit stereo WAV file from a background writer thread
+ *
+ * The render thread only copies each block into a lock-free ring; the
+ * writer thread drains it, converts to 16-bit and does the file I/O, so a
+ * slow disk costs dropped blocks rather than a late render. close() drains
+ * the ring and patches the RIFF sizes into the header.
+ */
+class WavFileSink : public AudioSink {
+public:
+    static const size_t QUEUE_BLOCKS = 64;
+
+private:
+    struct Block {
+        size_t frames;
+        float samples[MAX_BLOCK_FRAMES * 2];
+
+        Block() : frames(0), samples() {}
+    };
+
+    std::string path;
+    int sample_rate;
+    FILE* file;
+    SpscQueue<Block> queue;
+    Block staging;                      // render thread's copy of the block being queued
+    std::atomic<size_t> frames;         // frames the writer has stored
+    std::atomic<size_t> dropped;
+    std::atomic<bool> closing;
+    std::thread writer;
+
+    // Rule of Three: owns a file and a thread
+    WavFileSink(const WavFileSink&);
+    WavFileSink& operator=(const WavFileSink&);
+
+public:
+    WavFileSink(const std::string& path, int sample_rate);
+    ~WavFileSink();
+
+    /**
+     * @brief Create the file and start the writer thread
+     */
+    bool open();
+
+    bool write(const float* interleaved, size_t count) override;
+    void close() override;
+    size_t frames_written() const override { return frames; }
+    size_t dropped_blocks() const override { return dropped; }
+    bool ready() const override { return queue.size() < queue.capacity(); }
+    std::string describe() const override { return path; }
+
+private:
+    void run();
+    void store(const Block& block);
+    bool write_header(size_t frame_count);
+};
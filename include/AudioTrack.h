@@ -2,8 +2,34 @@
 
 #include <string>
 #include "PointerWrapper.h"
+#include "BeatAnalyzer.h"
+#include "Waveform.h"
 #include <memory>
 #include <vector>
+#include <cstddef>
+
+/**
+ * @brief Process-wide counters of track copies and waveform buffer traffic
+ * Snapshot returned by AudioTrack::get_allocation_stats(); subtract two
+ * snapshots to measure a single operation (e.g. one transition).
+ */
+struct TrackAllocationStats {
+    size_t tracks_constructed;        // tracks built from metadata (new shared state)
+    size_t track_copies;              // copy constructions/assignments (clone() included)
+    size_t waveform_allocations;      // waveform buffers allocated
+    size_t waveform_bytes_allocated;
+    size_t waveform_bytes_copied;     // bytes memcpy'd by copy-on-write detaches
+    size_t waveform_releases;         // waveforms dropped to save memory
+    size_t pool_allocations;          // blocks served by track pools and buffer slabs
+    size_t heap_allocations;          // system heap calls made by them (slab refills, oversized buffers)
+
+    TrackAllocationStats() : tracks_constructed(0), track_copies(0), waveform_allocations(0),
+                             waveform_bytes_allocated(0), waveform_bytes_copied(0), waveform_releases(0),
+                             pool_allocations(0), heap_allocations(0) {}
+    TrackAllocationStats operator-(const TrackAllocationStats& earlier) const;
+    TrackAllocationStats& operator+=(const TrackAllocationStats& other);
+};
+
 /**
  * Base class for all audio track types in the DJ library system.
  * This class demonstrates virtual functions, Rule of 5, and dynamic memory management.
@@ -12,19 +38,53 @@
  * - load(): lightweight, format-specific preparation when a track is assigned to a deck;
  *   sets readiness state and may log; does not start playback.
  * - analyze_beatgrid(): runs immediately after load() in this assignment to make BPM
- *   available for compatibility checks; results may be cached per instance.
+ *   available for compatibility checks; results may be cached per instance
+ *   (measured grids are, and copies inherit them; see AnalysisCache).
  * - clone(): used at the cache→mixer boundary; mixer always receives a polymorphic clone
  *   and owns it; the cache retains its own copy.
- * 
+ *
+ * Copies are cheap handles: title, artists and the waveform live in one
+ * immutable, reference-counted SharedData block that every copy of a track
+ * points to. Only the per-instance fields (duration, bpm) are copied, so
+ * clone() costs a single object allocation and no waveform memcpy. Code
+ * that needs to change the waveform calls mutable_waveform(), which
+ * detaches (copy-on-write) when the block is shared.
+ *
+ * The waveform itself is lazy (see Waveform): a track holds metadata only
+ * until get_waveform()/get_waveform_copy() first needs the samples, and
+ * untouched samples may be released again under a memory budget.
  */
 class AudioTrack {
 protected:
-    std::string title;
-    std::vector<std::string> artists;
+    /**
+     * Immutable state shared by all copies of a track
+     */
+    struct SharedData {
+        std::string title;
+        std::vector<std::string> artists;
+        Waveform waveform;      // Lazily generated array for audio analysis
+
+        SharedData(const std::string& title, const std::vector<std::string>& artists, size_t waveform_samples);
+        SharedData(const SharedData& other);    // used by copy-on-write
+        ~SharedData();
+
+    private:
+        SharedData& operator=(const SharedData&);
+    };
+
+    std::shared_ptr<SharedData> shared;
     int duration_seconds;
-    int bpm;  // beats per minute for mixing
-    double* waveform_data;  // Dynamic array for audio analysis
-    size_t waveform_size;   // Size of the waveform array
+    int bpm;  // beats per minute for mixing (per instance, changed by sync_bpm)
+    int key;     // Camelot key code (see HarmonicIndex::parse_key), -1 = unknown
+    int energy;  // 1..10, 0 = unknown
+    std::shared_ptr<const BeatGrid> beat_grid;  // measured from audio by analyze_beatgrid(), or nullptr;
+                                                // shared with copies, so they skip the analysis
+
+    /**
+     * Copy-on-write access to the waveform: detaches from other copies first
+     * if the shared block is not exclusively owned by this track.
+     */
+    double* mutable_waveform();
 
 public:
     /**
@@ -37,32 +97,28 @@ public:
     // ========== RULE OF 5 - STUDENTS MUST IMPLEMENT ALL OF THESE ==========
 
     /**
-     * TODO: Implement destructor
-     * HINT: Don't forget to clean up waveform_data!
+     * Destructor - drops this track's reference to the shared data;
+     * the waveform is freed with the last copy.
      */
     virtual ~AudioTrack();
 
     /**
-     * TODO: Implement copy constructor
-     * HINT: Deep copy the waveform_data array
+     * Copy constructor - shares title, artists and waveform with other
      */
     AudioTrack(const AudioTrack& other);
 
     /**
-     * TODO: Implement copy assignment operator
-     * HINT: Check for self-assignment, clean up existing data, then deep copy
+     * Copy assignment operator - releases the current shared data, shares other's
      */
     AudioTrack& operator=(const AudioTrack& other);
 
     /**
-     * TODO: Implement move constructor
-     * HINT: Transfer ownership without copying, leave other in valid state
+     * Move constructor - steals the shared data; other is left as an empty track
      */
     AudioTrack(AudioTrack&& other) noexcept;
 
     /**
-     * TODO: Implement move assignment operator
-     * HINT: Clean up current data, steal from other, reset other
+     * Move assignment operator - releases current data, steals from other, resets other
      */
     AudioTrack& operator=(AudioTrack&& other) noexcept;
 
@@ -85,6 +141,23 @@ public:
      */
     virtual void analyze_beatgrid() = 0;
 
+    /**
+     * Pure virtual function - preview load() followed by analyze_beatgrid()
+     * Prints what they would print and warms the data shared by every copy
+     * (file mapping, frame index, analysis cache), but leaves this track's
+     * BPM, duration, format and grid as they are. Lets a borrowing playlist
+     * prepare library tracks without copying or changing them.
+     */
+    virtual void prepare() const = 0;
+
+    /**
+     * Take the beat grid of this track's audio from the AnalysisCache if it
+     * was analyzed before (-B or an earlier session), without analyzing or
+     * printing. Sets BPM and grid as analyze_beatgrid() would.
+     * @return true if a measured grid was applied (formats without one: false)
+     */
+    virtual bool apply_cached_beatgrid() { return false; }
+
     /**
      * Pure virtual function - calculate audio quality score
      * MP3 uses bitrate, WAV uses sample rate, etc.
@@ -98,14 +171,77 @@ public:
     virtual PointerWrapper<AudioTrack> clone() const = 0;
 
     /**
-     * Function to get a copy of the waveform data
+     * Function to get a copy of the waveform data (materializes it if needed)
      */
     void get_waveform_copy(double* buffer, size_t buffer_size) const;
+
+    /**
+     * Read-only waveform samples in the track's storage format, materialized
+     * on first use. The view stays valid while held, even if the track
+     * releases its waveform.
+     */
+    WaveformSamples get_waveform() const { return shared->waveform.acquire(); }
+    size_t get_waveform_size() const { return shared->waveform.size(); }
+    bool is_waveform_resident() const { return shared->waveform.resident(); }
+
+    /**
+     * Storage format of the waveform (shared with this track's copies);
+     * changing it drops resident samples, which are regenerated on next use
+     */
+    WaveformFormat get_waveform_format() const { return shared->waveform.get_format(); }
+    void set_waveform_format(WaveformFormat format) { shared->waveform.set_format(format); }
+
+    /**
+     * Drop the waveform samples of this track (and its copies) until next use
+     * @return true if memory was released
+     */
+    bool release_waveform() { return shared->waveform.release(); }
+
+    /**
+     * Cap the memory of resident waveforms across all tracks (0 = unlimited);
+     * least recently used waveforms are released beyond it
+     */
+    static void set_waveform_memory_budget(size_t bytes) { Waveform::set_memory_budget(bytes); }
+
+    /**
+     * Approximate memory held by this track in bytes: the object itself,
+     * title and artist strings, the waveform in its storage format, and (in derived classes)
+     * the format-specific audio payload a deck-ready track keeps resident.
+     * Used for byte-budgeted caching.
+     */
+    virtual size_t get_memory_footprint() const;
     
+    /**
+     * Process-wide copy and waveform allocation counters
+     */
+    static TrackAllocationStats get_allocation_stats();
+
+    /**
+     * Number of tracks currently sharing this track's data (1 = exclusive)
+     */
+    long get_share_count() const { return shared.use_count(); }
+
     // ========== ACCESSOR FUNCTIONS ==========
-    std::string get_title() const { return title; }
+    const std::string& get_title() const { return shared->title; }
     int get_bpm() const { return bpm; }
     void set_bpm(int new_bpm) { bpm = new_bpm; } // adding set_bpm for Mixer sync_bpm
     int get_duration() const { return duration_seconds; }
-    std::vector<std::string> get_artists() const { return artists; }
+
+    /**
+     * Harmonic-mixing metadata from the library (key=/energy= attributes)
+     */
+    int get_key() const { return key; }
+    void set_key(int camelot_key) { key = camelot_key; }
+    int get_energy() const { return energy; }
+    void set_energy(int level) { energy = level; }
+
+    /**
+     * Beat grid measured from real audio by analyze_beatgrid(); nullptr when
+     * the track has no audio to analyze (bpm is then the metadata value)
+     */
+    const BeatGrid* get_beat_grid() const { return beat_grid.get(); }
+    const std::vector<std::string>& get_artists() const { return shared->artists; }
+
+private:
+    static std::shared_ptr<SharedData> empty_shared();
 };
\ No newline at end of file
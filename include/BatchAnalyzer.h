@@ -0,0 +1,86 @@
+#pragma once
+
+#include "AudioTrack.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Analysis result of one library track
+ */
+struct BatchTrackResult {
+    std::string title;
+    std::string type;           // "MP3" or "WAV"
+    int bpm;                    // after analysis (measured when grid.valid())
+    double quality;             // get_quality_score()
+    BeatGrid grid;              // invalid unless measured from audio
+    double analysis_ms;         // load + analyze_beatgrid + quality score
+
+    BatchTrackResult() : title(), type(), bpm(0), quality(0.0), grid(), analysis_ms(0.0) {}
+};
+
+/**
+ * @brief Outcome of a batch run; results are in library order
+ */
+struct BatchReport {
+    std::vector<BatchTrackResult> results;
+    size_t threads;
+    double wall_seconds;
+    double track_seconds;       // sum of per-track times
+    size_t steals;              // tasks balanced onto another worker
+
+    BatchReport() : results(), threads(0), wall_seconds(0.0), track_seconds(0.0), steals(0) {}
+};
+
+/**
+ * @brief Pre-analyzes a whole library on a work-stealing pool
+ *
+ * Every track is loaded, analyzed (analyze_beatgrid) and scored
+ * (get_quality_score) as one task; the tracks keep their results, and
+ * measured grids land in the AnalysisCache. Track logs are discarded.
+ * Indexes over the tracks are stale afterwards: the caller rebuilds them
+ * (DJLibraryService::refreshIndexes).
+ *
+ * Results can be written to a binary sidecar file: a 16-byte header
+ * ("DJBA", u16 version, u16 record size, u32 record count, u32 string bytes),
+ * one fixed 32-byte record per track, then the titles back to back.
+ * All fields are little-endian; see write_sidecar() for the record layout.
+ */
+class BatchAnalyzer {
+public:
+    static const uint16_t SIDECAR_VERSION = 1;
+    static const uint16_t RECORD_BYTES = 32;
+
+private:
+    size_t threads;
+
+public:
+    /**
+     * @param threads Worker count (0 = one per hardware thread)
+     */
+    explicit BatchAnalyzer(size_t threads = 0);
+
+    /**
+     * @brief Analyze tracks in parallel
+     * @param progress Receives a progress line every 10% (nullptr = silent)
+     */
+    BatchReport run(const std::vector<AudioTrack*>& tracks, std::ostream* progress = nullptr) const;
+
+    size_t get_threads() const { return threads; }
+
+    /**
+     * @brief Write results to path (via a temporary file renamed into place)
+     */
+    static bool write_sidecar(const std::string& path, const std::vector<BatchTrackResult>& results);
+
+    /**
+     * @brief Read a sidecar written by write_sidecar()
+     * @return false if the file is missing, truncated or of another version
+     */
+    static bool read_sidecar(const std::string& path, std::vector<BatchTrackResult>& results);
+
+private:
+    static BatchTrackResult analyze_track(AudioTrack& track);
+};
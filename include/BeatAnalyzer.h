@@ -0,0 +1,83 @@
+#pragma once
+
+#include "WavFile.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Constant-tempo beat grid of a track
+ *
+ * Beat i falls at first_beat + i * 60 / bpm seconds.
+ */
+struct BeatGrid {
+    double bpm;             // 0 if no steady tempo was found
+    double first_beat;      // seconds from the start of the audio
+    size_t beat_count;
+    double confidence;      // autocorrelation peak relative to zero lag, in [0, 1]
+
+    BeatGrid() : bpm(0.0), first_beat(0.0), beat_count(0), confidence(0.0) {}
+
+    bool valid() const { return bpm > 0.0; }
+    double beat_time(size_t i) const { return first_beat + i * 60.0 / bpm; }
+};
+
+/**
+ * @brief Tempo and beat-position detection over PCM samples
+ *
+ * The signal is cut into hops of 10 ms; the onset envelope is the positive
+ * change of log energy from hop to hop (energy flux), with its local mean
+ * removed. The tempo is the lag with the strongest autocorrelation of the
+ * envelope between MIN_BPM and MAX_BPM, weighted towards 120 BPM to settle
+ * octave ambiguity, then refined to a fractional lag. The grid phase is the
+ * offset whose comb of beats collects the most onset strength.
+ *
+ * The sum-of-squares, downmix and dot-product kernels use SSE2 when the
+ * compiler targets it; a scalar analyzer runs the *_scalar variants and
+ * yields the same grid up to rounding.
+ */
+class BeatAnalyzer {
+public:
+    static const int MIN_BPM = 60;
+    static const int MAX_BPM = 200;
+    static const int HOPS_PER_SECOND = 100;
+
+private:
+    bool use_simd;
+
+public:
+    explicit BeatAnalyzer(bool vectorized = true) : use_simd(vectorized && vectorized_build()) {}
+
+    /**
+     * @brief Analyze mono samples in [-1, 1]
+     * @return The grid, or an invalid grid if the audio is too short or has no steady pulse
+     */
+    BeatGrid analyze(const float* mono, size_t n, int sample_rate) const;
+
+    /**
+     * @brief Analyze the frames of a mapped WAV file (downmixed to mono in blocks)
+     */
+    BeatGrid analyze(const PcmView& pcm, int sample_rate) const;
+
+    bool vectorized() const { return use_simd; }
+
+    // ========== KERNELS ==========
+    static double sum_squares(const float* in, size_t n);
+    static double dot(const float* a, const float* b, size_t n);
+    static void downmix(const float* interleaved, size_t frames, int channels, float* mono);
+
+    static double sum_squares_scalar(const float* in, size_t n);
+    static double dot_scalar(const float* a, const float* b, size_t n);
+    static void downmix_scalar(const float* interleaved, size_t frames, int channels, float* mono);
+
+    /**
+     * @brief true if the plain kernels use SIMD in this build
+     */
+    static bool vectorized_build();
+
+private:
+    static size_t hop_size(int sample_rate);
+    void add_energies(const float* mono, size_t n, size_t hop, std::vector<float>& energies) const;
+    BeatGrid grid_from_energies(const std::vector<float>& energies, int sample_rate, size_t hop) const;
+    double correlation(const float* envelope, size_t frames, size_t lag) const;
+    static double parabolic_offset(double left, double middle, double right);
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Allocation counters of one BlockPool, or of all pools together
+ */
+struct BlockPoolStats {
+    size_t allocations;     // blocks handed out
+    size_t releases;        // blocks returned
+    size_t slabs;           // slabs requested from the system heap
+    size_t bytes_reserved;  // total slab bytes
+
+    BlockPoolStats() : allocations(0), releases(0), slabs(0), bytes_reserved(0) {}
+};
+
+/**
+ * @brief Thread-safe pool of fixed-size blocks carved from large slabs
+ *
+ * Freed blocks go onto an intrusive free list and are reused LIFO, so a
+ * clone/destroy cycle never reaches the system allocator and objects of one
+ * kind sit next to each other in memory. Slabs are only returned to the
+ * system when the pool is destroyed; every block must be freed before that.
+ */
+class BlockPool {
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    mutable std::mutex lock;
+    size_t block_size;
+    size_t blocks_per_slab;
+    FreeBlock* free_list;
+    std::vector<char*> slabs;
+    BlockPoolStats stats;
+
+    // Rule of Three: owns the slabs
+    BlockPool(const BlockPool&);
+    BlockPool& operator=(const BlockPool&);
+
+public:
+    /**
+     * @param block_size Bytes per block (rounded up to max_align_t alignment)
+     * @param blocks_per_slab Blocks allocated from the system at a time
+     */
+    explicit BlockPool(size_t block_size, size_t blocks_per_slab = 64);
+    ~BlockPool();
+
+    void* allocate();
+    void deallocate(void* block);
+
+    size_t get_block_size() const { return block_size; }
+    BlockPoolStats get_stats() const;
+
+    /**
+     * @brief Counters summed over every pool in the process (live and destroyed)
+     */
+    static BlockPoolStats get_total_stats();
+
+private:
+    void grow();
+};
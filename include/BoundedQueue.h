@@ -0,0 +1,77 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+/**
+ * @brief Blocking FIFO of at most capacity items between pipeline threads
+ *
+ * push() waits while the queue is full and pop() while it is empty, so a
+ * fast producer is held back to the pace of its consumer. close() ends the
+ * stream: pending pushes fail, and pop() drains what is queued and then
+ * returns false. Any number of threads may push and pop.
+ */
+template<typename T>
+class BoundedQueue {
+private:
+    std::deque<T> items;
+    size_t limit;
+    bool closed;
+
+    std::mutex lock;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+
+    // Rule of Three: shared between threads by address
+    BoundedQueue(const BoundedQueue&);
+    BoundedQueue& operator=(const BoundedQueue&);
+
+public:
+    /**
+     * @param capacity Most items queued at once (at least 1)
+     */
+    explicit BoundedQueue(size_t capacity)
+        : items(), limit(capacity > 0 ? capacity : 1), closed(false), lock(), not_empty(), not_full() {}
+
+    /**
+     * @brief Queue item, waiting for room
+     * @return false if the queue was closed (item is dropped)
+     */
+    bool push(T item) {
+        std::unique_lock<std::mutex> guard(lock);
+        not_full.wait(guard, [this]() { return closed || items.size() < limit; });
+        if (closed) return false;
+        items.push_back(std::move(item));
+        not_empty.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Take the oldest item, waiting for one
+     * @return false once the queue is closed and empty
+     */
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> guard(lock);
+        not_empty.wait(guard, [this]() { return closed || !items.empty(); });
+        if (items.empty()) return false;
+        item = std::move(items.front());
+        items.pop_front();
+        not_full.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief No more items: wake every waiting thread (idempotent)
+     */
+    void close() {
+        std::lock_guard<std::mutex> guard(lock);
+        closed = true;
+        not_empty.notify_all();
+        not_full.notify_all();
+    }
+
+    size_t capacity() const { return limit; }
+};
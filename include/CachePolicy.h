@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CacheSlot.h"
+#include "PointerWrapper.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Replacement/admission policy plugged behind LRUCache (Strategy)
+ *
+ * LRUCache owns the slots and the key index; the policy owns the ordering.
+ * Policies keep their lists in the intrusive CacheSlot links (every occupied
+ * slot is in exactly one of the policy's lists) and may keep extra state such
+ * as ghost keys or frequency sketches.
+ *
+ * Call sequence for a new key:
+ *   before_insert(key) -> [select_victim() -> on_evict(victim)] -> on_insert(slot)
+ * and on_hit(slot) for every access to a resident key.
+ */
+class CachePolicy {
+public:
+    virtual ~CachePolicy() {}
+
+    /**
+     * @brief Short policy name used in config and reports ("lru", "arc", "tinylfu")
+     */
+    virtual const char* name() const = 0;
+
+    /**
+     * @brief Forget all state; the cache is empty with the given capacity
+     */
+    virtual void reset(size_t capacity) = 0;
+
+    /**
+     * @brief A resident key was accessed
+     */
+    virtual void on_hit(std::vector<CacheSlot>& slots, size_t slot) = 0;
+
+    /**
+     * @brief A key that is not resident is about to be inserted
+     */
+    virtual void before_insert(const std::string& key) { (void)key; }
+
+    /**
+     * @brief Choose the slot to evict; only called when the cache is full
+     * @return Slot index, or CacheSlot::NO_SLOT if nothing is resident
+     */
+    virtual size_t select_victim(std::vector<CacheSlot>& slots) = 0;
+
+    /**
+     * @brief The slot is about to be cleared (its key is still readable)
+     */
+    virtual void on_evict(std::vector<CacheSlot>& slots, size_t slot) = 0;
+
+    /**
+     * @brief A new key was stored in the slot
+     */
+    virtual void on_insert(std::vector<CacheSlot>& slots, size_t slot) = 0;
+
+    /**
+     * @brief New, empty policy of the same kind (for shards and shadow caches)
+     */
+    virtual PointerWrapper<CachePolicy> create_empty() const = 0;
+};
+
+/**
+ * @brief Classic LRU: one recency list, evict the tail
+ */
+class LRUPolicy : public CachePolicy {
+private:
+    CacheSlotList recency;  // MRU first
+
+public:
+    LRUPolicy() : recency() {}
+
+    const char* name() const override { return "lru"; }
+    void reset(size_t capacity) override;
+    void on_hit(std::vector<CacheSlot>& slots, size_t slot) override;
+    size_t select_victim(std::vector<CacheSlot>& slots) override;
+    void on_evict(std::vector<CacheSlot>& slots, size_t slot) override;
+    void on_insert(std::vector<CacheSlot>& slots, size_t slot) override;
+    PointerWrapper<CachePolicy> create_empty() const override;
+};
+
+/**
+ * @brief Create a policy by config name
+ * @param name "lru", "arc", "tinylfu" (alias "w-tinylfu"); case-insensitive
+ * @return The policy, or an empty wrapper if the name is unknown
+ */
+PointerWrapper<CachePolicy> make_cache_policy(const std::string& name);
+
+/**
+ * @brief Names accepted by make_cache_policy, in report order
+ */
+std::vector<std::string> cache_policy_names();
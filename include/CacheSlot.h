@@ -4,10 +4,12 @@
 #include "PointerWrapper.h"
 #include <cstddef>
 #include <cstdint>
+#include <string>
+#include <vector>
 
 /**
  * @brief Single Cache Entry with LRU Metadata (Single Responsibility)
- * 
+ *
  * Represents one slot in the DJ controller's limited memory.
  * Separates cache slot management from the larger cache algorithm,
  * following SRP and making the design easier to test and maintain.
@@ -16,50 +18,112 @@
  * - Each slot holds exactly one cached track instance owned by the controller.
  * - access() updates last_access_time to reflect MRU/LRU policy.
  * - clear() releases ownership; callers log evictions as needed.
+ *
+ * Each slot also carries the links of an intrusive doubly linked list
+ * (prev/next slot indices), so the owning cache can keep its recency order
+ * without any per-entry allocation. The key is cached at store() time so
+ * lookups never have to go back through the track.
  */
 class CacheSlot {
+public:
+    static const size_t NO_SLOT = static_cast<size_t>(-1);
+
 private:
     PointerWrapper<AudioTrack> track;    // The cached track
+    std::string key;                     // Track title at store() time
     uint64_t last_access_time;           // For LRU algorithm
+    size_t bytes;                        // Footprint charged against the byte budget
     bool occupied;                       // Is this slot in use?
+    size_t prev;                         // Towards the MRU end of the list
+    size_t next;                         // Towards the LRU end of the list
 
 public:
     /**
      * @brief Construct empty cache slot
      */
     CacheSlot();
-    
+
     /**
      * @brief Store a track in this slot
      * @param track_ptr Track to store (transfers ownership)
      * @param access_time Current access timestamp
      */
     void store(PointerWrapper<AudioTrack> track_ptr, uint64_t access_time);
-    
+
+    /**
+     * @brief Occupy this slot with a key but no track (key-only simulation)
+     * @param track_id Key to store
+     * @param access_time Current access timestamp
+     */
+    void reserve(const std::string& track_id, uint64_t access_time);
+
     /**
      * @brief Access the track (updates LRU timestamp)
      * @param access_time Current access timestamp
-     * @return Raw pointer to track (does not transfer ownership)
+     * @return Raw pointer to track (does not transfer ownership), nullptr for key-only slots
      */
     AudioTrack* access(uint64_t access_time);
-    
+
     /**
      * @brief Clear this slot (removes track)
      */
     void clear();
-    
+
     /**
      * @brief Check if slot is occupied
      */
     bool isOccupied() const { return occupied; }
-    
+
     /**
      * @brief Get last access time for LRU comparison
      */
     uint64_t getLastAccessTime() const { return last_access_time; }
-    
+
     /**
      * @brief Get track without updating access time
      */
-    AudioTrack* getTrack() const { return track.get(); }
-};
\ No newline at end of file
+    AudioTrack* getTrack() const { return track ? track.get() : nullptr; }
+
+    /**
+     * @brief Bytes charged for this slot (track footprint at store() time)
+     */
+    size_t getBytes() const { return bytes; }
+
+    /**
+     * @brief Key (track title) this slot was stored under
+     */
+    const std::string& getKey() const { return key; }
+
+    // ========== INTRUSIVE LIST LINKS ==========
+    size_t getPrev() const { return prev; }
+    size_t getNext() const { return next; }
+    void setPrev(size_t index) { prev = index; }
+    void setNext(size_t index) { next = index; }
+};
+
+/**
+ * @brief Doubly linked list of slot indices threaded through CacheSlot links
+ *
+ * Does not own the slots; every operation takes the slot vector the indices
+ * refer to. A slot must be in at most one list at a time.
+ * All operations are O(1).
+ */
+class CacheSlotList {
+private:
+    size_t head;    // MRU end
+    size_t tail;    // LRU end
+    size_t count;
+
+public:
+    CacheSlotList() : head(CacheSlot::NO_SLOT), tail(CacheSlot::NO_SLOT), count(0) {}
+
+    void push_front(std::vector<CacheSlot>& slots, size_t index);
+    void unlink(std::vector<CacheSlot>& slots, size_t index);
+    void move_to_front(std::vector<CacheSlot>& slots, size_t index);
+
+    size_t front() const { return head; }
+    size_t back() const { return tail; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    void reset() { head = tail = CacheSlot::NO_SLOT; count = 0; }
+};
@@ -1,16 +1,54 @@
 #ifndef DJCONTROLLERSERVICE_H
 #define DJCONTROLLERSERVICE_H
 
-#include "LRUCache.h"
+#include "ShardedLRUCache.h"
+#include "TrackPrefetcher.h"
 #include "CacheSlot.h"
 #include "PointerWrapper.h"
+#include <atomic>
+#include <mutex>
 #include <string>
+#include <vector>
+
+/**
+ * @brief DJ Controller Memory Statistics
+ * Phase 4: Track how memory is used in the DJ controller simulation
+ */
+struct ControllerStats {
+    size_t tracks_in_controller;      // Tracks currently loaded in controller memory
+    size_t total_tracks_processed;    // Total tracks that passed through controller
+    size_t memory_slots_used;         // How many memory slots are occupied
+    size_t tracks_evicted;            // How many tracks were removed due to memory limits
+    size_t memory_budget_bytes;       // Byte budget of the cache (0 = slot count only)
+    size_t bytes_used;                // Footprint of the tracks currently cached
+    size_t bytes_evicted;             // Footprint released by evictions so far
+    
+    ControllerStats() : tracks_in_controller(0), total_tracks_processed(0), 
+                       memory_slots_used(0), tracks_evicted(0),
+                       memory_budget_bytes(0), bytes_used(0), bytes_evicted(0) {}
+};
+
+/**
+ * @brief Hit/miss counters of one replacement policy replayed on the session's requests
+ */
+struct CachePolicyStats {
+    std::string policy;
+    size_t hits;
+    size_t misses;
+
+    explicit CachePolicyStats(const std::string& name = "") : policy(name), hits(0), misses(0) {}
+    double hit_ratio() const { return (hits + misses) ? static_cast<double>(hits) / (hits + misses) : 0.0; }
+};
 
 /**
  * Service responsible for managing the controller's memory (cache)
  * Cache capacity is fixed, and the tracks are managed with LRU policy.
  * On HIT: touch MRU (most recently used); on MISS: insert; if full, evict LRU.
  * - Mixer always receives a polymorphic clone; cache retains its copy.
+ * - The cache may be split into independently locked shards so several
+ *   decks, prefetchers or sessions can share one controller: the hit check
+ *   is a single shard-locked lookup and the counters are synchronized.
+ *   Configuration calls (sizes, policy, comparison) stay single-threaded.
  */
 class DJControllerService {
 public:
@@ -33,6 +71,49 @@ public:
      * @note This function is meant for a single usage. don't call it more then once.
      */
     void set_cache_size(size_t new_size);
+
+    /**
+     * @brief Set cache capacity and shard count (concurrent cache mode).
+     * @param new_size Total number of cached tracks across all shards.
+     * @param shard_count Number of independently locked shards; 1 keeps a single LRU order.
+     * @note Like set_cache_size, call it once before the cache is shared between threads.
+     */
+    void configure_cache(size_t new_size, size_t shard_count);
+
+    /**
+     * @brief Limit the cache by memory footprint in addition to slot count.
+     * @param bytes Total budget in bytes; 0 disables the byte limit.
+     */
+    void set_cache_byte_budget(size_t bytes);
+
+    /**
+     * @brief Snapshot of the controller's memory statistics
+     */
+    ControllerStats get_stats() const;
+
+    /**
+     * @brief Select the cache replacement policy ("lru", "arc", "tinylfu").
+     * @return false if the name is unknown; the cache then stays on LRU.
+     * @note Rebuilds the (empty) cache; call it during configuration only.
+     */
+    bool set_cache_policy(const std::string& policy_name);
+
+    /**
+     * @brief Name of the active cache replacement policy
+     */
+    const std::string& get_cache_policy() const { return cache.policy_name(); }
+
+    /**
+     * @brief Replay every cache request through key-only shadow caches, one per
+     * known policy, sized like the real cache.
+     * @param enabled true to start comparing (resets shadow counters)
+     */
+    void enable_policy_comparison(bool enabled);
+
+    /**
+     * @brief Snapshot of the hit/miss counters of each shadow policy (empty when comparison is off)
+     */
+    std::vector<CachePolicyStats> get_policy_stats() const;
     /**
      * @brief Get a track from the cache by its title.
      * @param track_title The title of the track to retrieve.
@@ -40,8 +121,36 @@ public:
      */
     AudioTrack* getTrackFromCache(const std::string& track_title);
 
+    /**
+     * @brief Number of upcoming tracks to prepare on a background thread (0 = off)
+     */
+    void set_prefetch_depth(size_t depth) { prefetcher.set_depth(depth); }
+    size_t get_prefetch_depth() const { return prefetcher.depth(); }
+
+    /**
+     * @brief Prepare a track that will be requested soon (no-op if cached or prefetch is off)
+     * @param track Library track; must stay alive until it is loaded or finish_prefetch() runs
+     */
+    void prefetchTrack(const AudioTrack& track);
+
+    /**
+     * @brief Drop prefetched tracks that were not used (end of a playlist)
+     */
+    void finish_prefetch() { prefetcher.discard_all(); }
+
+    PrefetchStats get_prefetch_stats() const { return prefetcher.get_stats(); }
+
 private:
-    LRUCache cache;
+    ShardedLRUCache cache;
+    std::vector<PointerWrapper<LRUCache>> shadow_caches;   // key-only, one per policy
+    std::vector<CachePolicyStats> policy_stats;            // parallel to shadow_caches
+    mutable std::mutex shadow_lock;                        // guards shadow_caches and policy_stats
+    std::atomic<size_t> tracks_processed;                  // loadTrackToCache calls
+    TrackPrefetcher prefetcher;                            // prepares upcoming misses off-thread
+
+    // Rule of Three: owns caches
+    DJControllerService(const DJControllerService&);
+    DJControllerService& operator=(const DJControllerService&);
 };
 
 #endif // DJCONTROLLERSERVICE_H
@@ -4,6 +4,8 @@
 #include "Playlist.h"
 #include "AudioTrack.h"
 #include "SessionFileParser.h"
+#include "HarmonicIndex.h"
+#include "LibraryIndex.h"
 #include <vector>
 #include <string>
 
@@ -11,22 +13,42 @@
 // Phase 4 behavior alignment:
 // - Load library tracks from config file
 // - Build playlists from track indices referencing the library
+// - Loaded playlists borrow the library's tracks, so switching playlists clones nothing
+// - Library tracks and indexes are not changed by loading a playlist
 class DJLibraryService {
 public:
     DJLibraryService(const Playlist& playlist);
+    DJLibraryService(Playlist&& playlist);
     ~DJLibraryService();
-    DJLibraryService(): playlist(), library(){}
+    DJLibraryService(): playlist(), library(), index(), harmonic(){}
+
+    // Move operations transfer the library and playlist without cloning tracks
+    DJLibraryService(DJLibraryService&& other) noexcept;
+    DJLibraryService& operator=(DJLibraryService&& other) noexcept;
 
     /**
      * @brief Build the track library from parsed config data
      * @param library_tracks Vector of track info from config
+     * @param threads Worker threads constructing tracks; library order and
+     * output are the same for any count (1 = serial)
+     */
+    void buildLibrary(const std::vector<SessionConfig::TrackInfo>& library_tracks, size_t threads = 1);
+
+    /**
+     * @brief Rebuild the title/artist/BPM and harmonic indexes from the
+     * library tracks' current values
+     * @note Call it after changing library tracks in place (e.g. analyzing
+     * them); the indexes copy BPM, key and energy when built
      */
-    void buildLibrary(const std::vector<SessionConfig::TrackInfo>& library_tracks);
+    void refreshIndexes();
 
     /**
      * @brief Load a playlist by constructing it from track indices
      * @param playlist_name Name of the playlist
      * @param track_indices Vector of 1-based track indices referencing the library
+     * @note The playlist borrows the library tracks; they stay owned by the library.
+     * Each track is prepared (AudioTrack::prepare), which leaves library
+     * metadata and the indexes built from it as they were.
      */
     void loadPlaylistFromIndices(const std::string& playlist_name, const std::vector<int>& track_indices);
 
@@ -50,9 +72,56 @@ public:
      */
     std::vector<std::string> getTrackTitles() const;
 
+    // ========== LIBRARY QUERIES (indexed, see LibraryIndex) ==========
+
+    /**
+     * @brief Find a library track by exact title (not limited to the current playlist)
+     * @return The first library track with this title, or nullptr. The library keeps ownership.
+     */
+    AudioTrack* findLibraryTrack(const std::string& title) const;
+
+    /**
+     * @brief All library tracks crediting this exact artist name, in library order
+     */
+    const std::vector<AudioTrack*>& findTracksByArtist(const std::string& artist) const;
+
+    /**
+     * @brief Library tracks whose BPM is within +-tolerance of bpm, ordered by BPM
+     * (BPM as of the last buildLibrary or refreshIndexes)
+     */
+    std::vector<AudioTrack*> findTracksInBpmRange(int bpm, int tolerance) const;
+
+    /**
+     * @brief Number of library tracks within +-tolerance of bpm (O(log n))
+     */
+    size_t countTracksInBpmRange(int bpm, int tolerance) const;
+
+    /**
+     * @brief The k library tracks that mix best after a track, by tempo,
+     * Camelot key and energy (see HarmonicIndex), best first
+     */
+    std::vector<MixCandidate> findMixCandidates(const MixQuery& query, size_t k) const;
+
+    size_t getLibrarySize() const { return library.size(); }
+
+    /**
+     * @brief All library tracks in config order (owned by the library)
+     */
+    const std::vector<AudioTrack*>& getLibrary() const { return library; }
+
 private:
     Playlist playlist;
     std::vector<AudioTrack*> library;  // Library of all tracks (owned)
+    LibraryIndex index;                // title/artist/BPM lookups over library
+    HarmonicIndex harmonic;            // key/energy/BPM mix candidates over library
+
+    // Rule of Three: owns library tracks (use the move operations instead)
+    DJLibraryService(const DJLibraryService&);
+    DJLibraryService& operator=(const DJLibraryService&);
+
+    void clearLibrary();
+    void buildLibraryParallel(const std::vector<SessionConfig::TrackInfo>& library_tracks, size_t threads);
+    static AudioTrack* createTrack(const SessionConfig::TrackInfo& track_info);
 };
 
 #endif // DJLIBRARYSERVICE_H
\ No newline at end of file
@@ -5,23 +5,11 @@
 #include "MixingEngineService.h"
 #include "SessionFileParser.h"
 #include "ConfigurationManager.h"
+#include <atomic>
+#include <functional>
 #include <string>
 #include <vector>
 
-/**
- * @brief DJ Controller Memory Statistics
- * Phase 4: Track how memory is used in the DJ controller simulation
- */
-struct ControllerStats {
-    size_t tracks_in_controller;      // Tracks currently loaded in controller memory
-    size_t total_tracks_processed;    // Total tracks that passed through controller
-    size_t memory_slots_used;         // How many memory slots are occupied
-    size_t tracks_evicted;            // How many tracks were removed due to memory limits
-    
-    ControllerStats() : tracks_in_controller(0), total_tracks_processed(0), 
-                       memory_slots_used(0), tracks_evicted(0) {}
-};
-
 /**
  * @brief Professional DJ Session System Orchestrator
  */
@@ -41,6 +29,7 @@ private:
     SessionConfig session_config;
     std::vector<std::string> track_titles;
     bool play_all;
+    std::ofstream trace_out;            // request trace for bin/cache_sim (optional)
 
     // Session statistics
     struct SessionStats {
@@ -50,8 +39,15 @@ private:
         size_t cache_evictions = 0;
         size_t deck_loads_a = 0;
         size_t deck_loads_b = 0;
+        std::vector<size_t> deck_loads_more = std::vector<size_t>();   // decks C, D, ... in order
         size_t transitions = 0;
-        size_t errors = 0;
+        std::atomic<size_t> errors{0};      // counted by both the cache and the deck pipeline stages
+        std::vector<CachePolicyStats> policy_stats = std::vector<CachePolicyStats>();  // shadow replay, per policy
+        TrackAllocationStats allocations = TrackAllocationStats();  // cache/deck path only
+        size_t playlist_switches = 0;
+        size_t playlist_clones = 0;          // track copies made while loading playlists
+        std::vector<double> transition_us = std::vector<double>();   // cache + deck time per track
+        std::vector<double> suggestion_us = std::vector<double>();   // mix candidate query time per load
     } stats;
 
 public:
@@ -97,6 +93,20 @@ public:
      */
     void simulate_dj_performance();
 
+    /**
+     * Contract: Pre-analyze every library track (no playlists are played)
+     * - Input: worker threads (0 = one per hardware thread) and the sidecar file for the results
+     * - Output: false if the configuration cannot be loaded or the sidecar cannot be written
+     */
+    bool run_batch_analysis(size_t threads, const std::string& sidecar_path);
+
+    /**
+     * Contract: Reorder playlists for the cheapest transitions (nothing is played)
+     * - Input: a playlist name, or empty for every configured playlist in name order
+     * - Output: false if the configuration cannot be loaded or the playlist is unknown or empty
+     */
+    bool run_playlist_optimizer(const std::string& playlist_name);
+
 
     // ========== STATUS & DISPLAY METHODS ==========
 
@@ -107,6 +117,11 @@ public:
 private:
     // Helpers that we've built
     bool process_playlist(const std::string& playlist_name);
+    void process_tracks_pipelined();
+    void prefetch_upcoming(size_t track_index);
+    int load_to_controller(const std::string& track_name, AudioTrack* library_track);
+    bool load_to_mixer_deck(const std::string& track_title, const std::function<void()>& cache_released);
+    void suggest_next_tracks();
 
     // ========== PROVIDED HELPER METHODS (Menu and Config) ==========
     
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "AudioTrack.h"
+#include "PointerWrapper.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One mixer deck as the scheduler sees it
+ */
+struct MixerDeck {
+    AudioTrack* track;          // owned by MixingEngineService, nullptr = empty
+    size_t finished_at;         // load number at which the deck stopped being active, 0 = never
+
+    MixerDeck() : track(nullptr), finished_at(0) {}
+};
+
+/**
+ * @brief Picks the deck an incoming track is loaded to (Strategy)
+ *
+ * choose() never returns the active deck while there is another one, and
+ * returns deck 0 while every deck is empty.
+ */
+class DeckScheduler {
+public:
+    virtual ~DeckScheduler() {}
+
+    /**
+     * @brief Short scheduler name used in config and reports
+     */
+    virtual const char* name() const = 0;
+
+    virtual size_t choose(const std::vector<MixerDeck>& decks, size_t active, const AudioTrack& incoming) const = 0;
+};
+
+/**
+ * @brief The deck after the active one (with two decks: alternate)
+ */
+class RoundRobinScheduler : public DeckScheduler {
+public:
+    const char* name() const override { return "round_robin"; }
+    size_t choose(const std::vector<MixerDeck>& decks, size_t active, const AudioTrack& incoming) const override;
+};
+
+/**
+ * @brief An empty deck, else the one that finished playing longest ago
+ */
+class LeastRecentlyFinishedScheduler : public DeckScheduler {
+public:
+    const char* name() const override { return "least_recently_finished"; }
+    size_t choose(const std::vector<MixerDeck>& decks, size_t active, const AudioTrack& incoming) const override;
+};
+
+/**
+ * @brief An empty deck, else the one whose track is closest in BPM to the
+ * incoming track (ties: finished longest ago), so each deck's tempo moves least
+ */
+class BpmNearestScheduler : public DeckScheduler {
+public:
+    const char* name() const override { return "bpm_nearest"; }
+    size_t choose(const std::vector<MixerDeck>& decks, size_t active, const AudioTrack& incoming) const override;
+};
+
+/**
+ * @brief Create a scheduler by config name
+ * @param name "round_robin" (or empty), "least_recently_finished" (alias "lrf"),
+ *             "bpm_nearest"; case-insensitive
+ * @return The scheduler, or an empty wrapper if the name is unknown
+ */
+PointerWrapper<DeckScheduler> make_deck_scheduler(const std::string& name);
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Float kernels of the render path (resampling, time-stretch)
+ *
+ * The plain names use SSE2 when the compiler targets it (always on x86-64)
+ * and fall back to the scalar versions otherwise; the *_scalar variants are
+ * always available for checking and benchmarks. Buffers need no alignment.
+ */
+class DspKernels {
+public:
+    /**
+     * @brief Sum of a[i] * b[i]
+     */
+    static float dot(const float* a, const float* b, size_t n);
+
+    /**
+     * @brief out[i] += in[i] * gain[i]
+     */
+    static void multiply_add(float* out, const float* in, const float* gain, size_t n);
+
+    /**
+     * @brief Interleave two planar channels into stereo frames
+     */
+    static void interleave(const float* left, const float* right, float* out, size_t frames);
+
+    static float dot_scalar(const float* a, const float* b, size_t n);
+    static void multiply_add_scalar(float* out, const float* in, const float* gain, size_t n);
+    static void interleave_scalar(const float* left, const float* right, float* out, size_t frames);
+
+    /**
+     * @brief true if the plain kernels use SIMD in this build
+     */
+    static bool vectorized();
+};
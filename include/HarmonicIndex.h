@@ -0,0 +1,113 @@
+#pragma once
+
+#include "AudioTrack.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A "what can I mix next?" request against the library
+ */
+struct MixQuery {
+    int bpm;                    // tempo of the playing track
+    int key;                    // Camelot key code (HarmonicIndex::parse_key), -1 = any
+    int energy;                 // 1..10, 0 = any
+    int bpm_tolerance;          // same window as MixingEngineService::can_mix_tracks
+    int energy_tolerance;       // largest energy step, up or down
+    bool half_double;           // also match half/double time: set when the playing track has a measured
+                                // grid; candidates need one too
+    const AudioTrack* exclude;  // usually the library copy of the playing track
+
+    MixQuery() : bpm(0), key(-1), energy(0), bpm_tolerance(0), energy_tolerance(2), half_double(false),
+                 exclude(nullptr) {}
+};
+
+/**
+ * @brief One compatible track; lower score mixes better
+ */
+struct MixCandidate {
+    AudioTrack* track;
+    double score;
+    int bpm_gap;                // after halving/doubling for a half/double-time match
+    int key_distance;           // Camelot steps, -1 if either key is unknown
+    int energy_gap;             // -1 if either energy is unknown
+    bool half_double;
+
+    MixCandidate() : track(nullptr), score(0.0), bpm_gap(0), key_distance(-1), energy_gap(-1), half_double(false) {}
+};
+
+/**
+ * @brief Library index for harmonic mixing candidates (non-owning)
+ *
+ * Tracks are bucketed by Camelot key (24 + unknown) and energy (10 +
+ * unknown), and each bucket is sorted by BPM. A query visits only the
+ * buckets whose key is compatible with the playing one (same key, one step
+ * around the wheel, or the relative major/minor) and whose energy is in
+ * range, and binary-searches each for the BPM window (plus the half- and
+ * double-time windows), so its cost follows the number of compatible
+ * tracks rather than the library size. Tracks with an unknown key or
+ * energy are never ruled out by it but rank behind known matches.
+ *
+ * score = bpm_gap / (bpm_tolerance + 1) + key_distance + energy_gap / (energy_tolerance + 1)
+ *         (+ UNKNOWN_KEY_COST, UNKNOWN_ENERGY_COST, HALF_DOUBLE_COST where they apply)
+ *
+ * Like LibraryIndex it stores pointers and reads BPM, key and energy at
+ * build time; the owner rebuilds it when the library changes
+ * (DJLibraryService::refreshIndexes). Library tracks carry measured BPMs
+ * and grids once their audio is in the AnalysisCache when the library is
+ * built (a cache file from -B or an earlier session), or after -B; only
+ * then can half/double-time candidates match.
+ */
+class HarmonicIndex {
+public:
+    static const int KEY_COUNT = 24;        // Camelot 1A..12B
+    static const int MAX_ENERGY = 10;
+    static const double UNKNOWN_KEY_COST;
+    static const double UNKNOWN_ENERGY_COST;
+    static const double HALF_DOUBLE_COST;
+
+private:
+    struct Entry {
+        int bpm;
+        uint32_t order;         // library position, breaks score ties
+        AudioTrack* track;
+    };
+
+    std::vector<std::vector<Entry>> buckets;    // [(key + 1) * (MAX_ENERGY + 1) + energy], by bpm then order
+    size_t track_count;
+
+public:
+    HarmonicIndex();
+
+    void build(const std::vector<AudioTrack*>& tracks);
+    void clear();
+    size_t size() const { return track_count; }
+
+    /**
+     * @brief The k best-scoring compatible tracks, best first (ties: library order)
+     */
+    std::vector<MixCandidate> find_compatible(const MixQuery& query, size_t k) const;
+
+    // ========== CAMELOT KEYS ==========
+
+    /**
+     * @brief Key code 0..23 from Camelot ("8A", "12B") or musical notation
+     * ("Am", "F#m", "Db", "Ebmin"); case-insensitive
+     * @return The code ((number - 1) * 2, +1 for B/major), or -1 if not a key
+     */
+    static int parse_key(const std::string& text);
+
+    /**
+     * @brief Camelot name of a key code ("8A"), empty for -1
+     */
+    static std::string key_name(int key);
+
+    /**
+     * @brief Steps on the Camelot wheel: around the wheel plus one for A <-> B
+     */
+    static int key_distance(int a, int b);
+
+private:
+    size_t bucket_index(int key, int energy) const { return (key + 1) * (MAX_ENERGY + 1) + energy; }
+};
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "CacheSlot.h"
+#include "CachePolicy.h"
 #include "AudioTrack.h"
 #include "PointerWrapper.h"
 #include <vector>
+#include <unordered_map>
 #include <cstddef>
 #include <cstdint>
 #include <string>
@@ -19,12 +21,36 @@
  * - Used by DJControllerService with fixed capacity in this assignment.
  * - get() marks entries MRU by updating their access time.
  * - put() inserts as MRU and evicts true LRU when full.
+ *
+ * Complexity: slots are indexed by a hash map from track id to slot index,
+ * and the recency order is an intrusive list threaded through the slots
+ * (head = MRU, tail = LRU). get/put/contains/evictLRU/size are O(1).
+ *
+ * Replacement is delegated to a CachePolicy. LRU is the default; ARC and
+ * W-TinyLFU are scan-resistant alternatives selected by name.
+ *
+ * Besides the slot count, the cache can enforce a byte budget: each entry
+ * is charged AudioTrack::get_memory_footprint(), and put() keeps evicting
+ * until the new entry fits. A single entry larger than the whole budget is
+ * still stored (the controller must hold the track it is about to play).
  */
 class LRUCache {
 private:
     std::vector<CacheSlot> slots;
     size_t max_size;
     uint64_t access_counter;
+    std::unordered_map<std::string, size_t> index;  // track id -> slot
+    PointerWrapper<CachePolicy> policy;             // owns the recency/frequency order
+    size_t used;                                    // occupied slots
+    size_t max_bytes;                               // byte budget, 0 = slot count only
+    size_t used_bytes;
+    size_t evicted_bytes;                           // running total
+    size_t evictions;                               // running total
+    std::vector<size_t> free_slots;                 // empty slots, next to fill on top
+
+    // Rule of Three: the cache owns its tracks and policy
+    LRUCache(const LRUCache&);
+    LRUCache& operator=(const LRUCache&);
 
 public:
     /**
@@ -32,6 +58,13 @@ public:
      * @param capacity Maximum number of tracks to cache
      */
     explicit LRUCache(size_t capacity);
+
+    /**
+     * @brief Construct cache with a specific replacement policy
+     * @param capacity Maximum number of tracks to cache
+     * @param cache_policy Policy to use (transfers ownership); LRU if empty
+     */
+    LRUCache(size_t capacity, PointerWrapper<CachePolicy> cache_policy);
     
     /**
      * @brief Check if cache contains a track
@@ -60,6 +93,17 @@ public:
      */
     bool put(PointerWrapper<AudioTrack> track);
     
+    /**
+     * @brief Record an access by key only, without a track payload
+     * @param track_id Track identifier
+     * @return true on hit; on miss a key-only entry is inserted (evicting if full)
+     *
+     * Used for shadow policy comparison and trace replay, where building
+     * real tracks would dominate the cost. get() returns nullptr for
+     * key-only entries, so do not mix touch() with put() on one cache.
+     */
+    bool touch(const std::string& track_id);
+
     /**
      * @brief Manually evict the least recently used track
      * @return true if a track was evicted
@@ -72,6 +116,29 @@ public:
      */
     size_t size() const;
     
+    /**
+     * @brief Set the memory budget in bytes (0 disables it); evicts until it fits
+     */
+    void set_byte_budget(size_t bytes);
+
+    size_t byte_budget() const { return max_bytes; }
+    size_t bytes_used() const { return used_bytes; }
+
+    /**
+     * @brief Total bytes released by evictions since construction
+     */
+    size_t bytes_evicted() const { return evicted_bytes; }
+
+    /**
+     * @brief Total number of evictions since construction
+     */
+    size_t eviction_count() const { return evictions; }
+
+    /**
+     * @brief Name of the active replacement policy ("lru", "arc", "tinylfu")
+     */
+    const char* policy_name() const { return policy->name(); }
+
     /**
      * @brief Get maximum cache capacity
      */
@@ -105,14 +172,32 @@ private:
     size_t findSlot(const std::string& track_id) const;
     
     /**
-     * @brief Find the least recently used slot
-     * @return Slot index of LRU entry
+     * @brief Find the slot the policy wants to evict next
+     * @return Slot index of the victim, or max_size if the cache is empty
      */
-    size_t findLRUSlot() const;
+    size_t findLRUSlot();
     
     /**
      * @brief Find first empty slot
      * @return Slot index, or max_size if cache is full
      */
     size_t findEmptySlot() const;
+
+    /**
+     * @brief Rebuild the free-slot stack so the lowest empty index is filled first
+     */
+    void resetFreeSlots();
+
+    /**
+     * @brief Claim a free slot (evicting until a slot and `bytes` are available)
+     * and index it under track_id
+     * @param evicted Set to true if an eviction was needed
+     * @return Slot index to fill
+     */
+    size_t claimSlot(const std::string& track_id, size_t bytes, bool& evicted);
+
+    /**
+     * @brief Whether an entry of `bytes` needs another eviction to fit
+     */
+    bool needsRoom(size_t bytes) const;
 };
\ No newline at end of file
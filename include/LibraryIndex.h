@@ -0,0 +1,69 @@
+#pragma once
+
+#include "AudioTrack.h"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Lookup structures over the track library (non-owning)
+ *
+ * - title  -> track         hash index, O(1)
+ * - artist -> tracks        inverted index over get_artists(), O(1) + results
+ * - BPM                     sorted (bpm, track) array; a +-tolerance range is
+ *                           two binary searches, O(log n) + results
+ *
+ * The index only stores pointers; the owner (DJLibraryService) must rebuild
+ * it whenever tracks are added or freed. BPM is copied at build time, so
+ * it must also be rebuilt when a track's BPM changes in place (batch
+ * analysis); DJLibraryService::refreshIndexes() does both.
+ */
+class LibraryIndex {
+public:
+    typedef std::pair<int, AudioTrack*> BpmEntry;
+    typedef std::vector<BpmEntry>::const_iterator BpmIterator;
+
+private:
+    std::unordered_map<std::string, AudioTrack*> by_title;               // first track with the title
+    std::unordered_map<std::string, std::vector<AudioTrack*>> by_artist;  // library order
+    std::vector<BpmEntry> by_bpm;                                         // sorted by bpm, then library order
+
+public:
+    LibraryIndex() : by_title(), by_artist(), by_bpm() {}
+
+    /**
+     * @brief Replace the index contents with the given tracks (library order)
+     */
+    void build(const std::vector<AudioTrack*>& tracks);
+    void clear();
+
+    size_t size() const { return by_bpm.size(); }
+
+    /**
+     * @return The first library track with this exact title, or nullptr
+     */
+    AudioTrack* find_title(const std::string& title) const;
+
+    /**
+     * @return Every track listing this exact artist name, in library order
+     */
+    const std::vector<AudioTrack*>& find_artist(const std::string& artist) const;
+
+    /**
+     * @brief Tracks with bpm in [bpm - tolerance, bpm + tolerance] as an
+     * iterator range over the BPM index (no allocation), ordered by BPM
+     */
+    std::pair<BpmIterator, BpmIterator> bpm_range(int bpm, int tolerance) const;
+
+    /**
+     * @brief Same range as bpm_range(), copied into a vector
+     */
+    std::vector<AudioTrack*> find_bpm(int bpm, int tolerance) const;
+
+    /**
+     * @brief Number of tracks in the BPM range, O(log n)
+     */
+    size_t count_bpm(int bpm, int tolerance) const;
+};
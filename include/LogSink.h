@@ -0,0 +1,37 @@
+#pragma once
+
+#include <ostream>
+
+/**
+ * @brief Per-thread destination for track processing logs
+ *
+ * Track construction, load and analysis messages, and the controller's
+ * cache loading and status output, go to LogSink::out(), which is
+ * std::cout unless the calling thread installed a Capture.
+ * Background workers capture a track's messages into a buffer so the main
+ * thread can print them at the point where the serial code would have,
+ * keeping session output ordered.
+ */
+class LogSink {
+public:
+    /**
+     * @brief Stream for the calling thread (std::cout by default)
+     */
+    static std::ostream& out();
+
+    /**
+     * @brief RAII redirect of the calling thread's log stream
+     */
+    class Capture {
+    private:
+        std::ostream* previous;
+
+        // Rule of Three: restores thread state on destruction
+        Capture(const Capture&);
+        Capture& operator=(const Capture&);
+
+    public:
+        explicit Capture(std::ostream& target);
+        ~Capture();
+    };
+};
@@ -2,6 +2,10 @@
 #define MP3TRACK_H
 
 #include "AudioTrack.h"
+#include "BlockPool.h"
+#include "Mp3File.h"
+#include <memory>
+#include <string>
 
 /**
  * MP3Track - Represents an MP3 audio file with lossy compression
@@ -13,18 +17,32 @@
  * - analyze_beatgrid(): run immediately after load() in this assignment for compatibility checks.
  * - get_quality_score(): derived from bitrate (e.g., normalized by 320kbps).
  * - clone(): return a deep polymorphic copy used by the mixer; source remains unchanged.
+ *
+ * A track may name a real .mp3 file. The first load() on any copy of the
+ * track scans its frames into a seek table (skipping the ID3v2 tag when
+ * has_id3_tags is set); later loads on cached or cloned copies reuse it.
  */
 class MP3Track : public AudioTrack {
 private:
     int bitrate;        // Compression level: 128, 192, 320 kbps (higher = better quality)
     bool has_id3_tags;  // Whether file contains ID3 metadata (artist, album, etc.)
+    std::shared_ptr<Mp3File> file;   // nullptr if the track has no file path
+
+    static WaveformFormat default_waveform_format;   // applied to new tracks
+
+    // Index the file (once per file) and write its measured bitrate and
+    // duration to kbps/seconds; false (values untouched) without an index
+    bool measure(int& kbps, int& seconds) const;
+    void print_load(bool indexed, int kbps, int seconds) const;
+    void print_analysis(int kbps, int seconds) const;
 
 public:
     /**
      * Constructor for MP3Track
      */
     MP3Track(const std::string& title, const std::vector<std::string>& artists, 
-             int duration, int bpm, int bitrate, bool has_tags = true);
+             int duration, int bpm, int bitrate, bool has_tags = true,
+             const std::string& file_path = "");
 
     // ========== TODO: IMPLEMENT VIRTUAL FUNCTIONS ==========
 
@@ -40,6 +58,8 @@ public:
      */
     void analyze_beatgrid() override;
 
+    void prepare() const override;
+
     /**
      * TODO: Implement quality score calculation
      * HINT: Use bitrate to determine quality (higher bitrate = better quality)
@@ -52,9 +72,42 @@ public:
      */
     PointerWrapper<AudioTrack> clone() const override;
 
+    /**
+     * Base footprint plus the encoded MP3 stream audio payload
+     */
+    size_t get_memory_footprint() const override;
+
+    /**
+     * Waveform storage format for MP3 tracks constructed from now on (f64 by default);
+     * set before tracks are built on other threads
+     */
+    static void set_default_waveform_format(WaveformFormat format) { default_waveform_format = format; }
+    static WaveformFormat get_default_waveform_format() { return default_waveform_format; }
+
+    /**
+     * MP3Tracks are allocated from a per-class BlockPool, so clone() and
+     * destruction never reach the system heap once the pool is warm.
+     * Ownership is unchanged: PointerWrapper's delete lands here through the
+     * virtual destructor. Derived classes of another size use the global heap.
+     */
+    static void* operator new(size_t size);
+    static void operator delete(void* block, size_t size);
+    static BlockPoolStats get_pool_stats();
+
     // Getters
     int get_bitrate() const { return bitrate; }
     bool has_tags() const { return has_id3_tags; }
+    std::string get_file_path() const { return file ? file->get_path() : std::string(); }
+
+    /**
+     * Frame index of the file (nullptr if there is no file or load() has not indexed it)
+     */
+    const Mp3FrameIndex* get_frame_index() const;
+
+    /**
+     * Byte offset in the file to start decoding at the given time (0 without an index)
+     */
+    size_t seek_offset(double seconds) const;
 };
 
 #endif // MP3TRACK_H
\ No newline at end of file
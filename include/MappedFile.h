@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * Used by the audio file readers to parse containers in place. Not
+ * thread-safe by itself; owners serialize map()/unmap().
+ */
+class MappedFile {
+private:
+    unsigned char* bytes;
+    size_t length;
+
+    // Rule of Three: owns the mapping
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+public:
+    MappedFile() : bytes(nullptr), length(0) {}
+    ~MappedFile();
+
+    /**
+     * @brief Map path (replacing any current mapping)
+     * @param error Set to the reason on failure
+     * @return false if the file cannot be opened, is empty or cannot be mapped
+     */
+    bool map(const std::string& path, std::string& error);
+    void unmap();
+
+    /**
+     * @brief Hint that the mapping will be read front to back
+     */
+    void advise_sequential() const;
+
+    /**
+     * @brief 64-bit hash of the mapped bytes (0 if nothing is mapped)
+     * Reads the whole file once; four independent lanes of 8-byte words
+     * keep it near memory bandwidth. Not cryptographic.
+     */
+    uint64_t content_hash() const;
+
+    bool is_mapped() const { return bytes != nullptr; }
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
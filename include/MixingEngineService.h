@@ -1,22 +1,39 @@
 #ifndef MIXINGENGINESERVICE_H
 #define MIXINGENGINESERVICE_H
 
+#include "AudioRenderer.h"
 #include "AudioTrack.h"
+#include "DeckScheduler.h"
+#include "PointerWrapper.h"
 #include <string>
+#include <vector>
 
 // Service responsible for deck operations and track analysis
 // Phase 4 binding:
 // - Enforces instant transitions and deck alternation policy.
 // - After loading to a deck: call track.load(); then analyze_beatgrid(); then switch active deck.
 // - The previously active deck becomes finished and is unloaded immediately.
+// When rendering is enabled, deck changes are also sent to an AudioRenderer,
+// which plays the decks on its own thread and crossfades between them.
+// The deck count is configurable (2 by default); a DeckScheduler picks the
+// deck each track goes to (round-robin by default, which alternates 0/1
+// with two decks).
 class MixingEngineService {
+public:
+    static const size_t MAX_DECKS = 16;
+
 private:
-    AudioTrack* decks[2];
+    std::vector<MixerDeck> decks;       // sized by set_deck_count, never while loading
     size_t active_deck;
+    size_t loading_deck;                // target of the load in progress
+    size_t loads;                       // load counter, stamps MixerDeck::finished_at
+    PointerWrapper<DeckScheduler> scheduler;
     bool auto_sync;
     int bpm_tolerance;
+    PointerWrapper<AudioRenderer> renderer;     // nullptr unless rendering is enabled
+    double crossfade_seconds;
 
-    // Rule of Three: prevent shallow copy of raw pointer array
+    // Rule of Three: prevent shallow copy of the owned deck tracks
     MixingEngineService(const MixingEngineService&);
     MixingEngineService& operator=(const MixingEngineService&);
 public:
@@ -25,18 +42,27 @@ public:
 
     /** Contract: Load a track to the next deck per instant-transition policy
      * - @param track: reference to a cached track to be cloned for the mixer
-     * - @return: index of the deck the track was loaded to (0 or 1), or -1 on failure.
+     * - @return: index of the deck the track was loaded to (0 or 1 with two decks), or -1 on failure.
      * - @brief: This function clones the track, unloads the target deck if needed, loads the new track, analyzes the beatgrid, switches the active deck, and unloads the previous deck.
      * - @attention: on clone failure, log an error and return
      */
     int loadTrackToDeck(const AudioTrack& track);
 
+    /**
+     * @brief Load a copy the caller already made of a cached track (ownership taken)
+     * Same as loadTrackToDeck(track) from the clone on, so the cache is free
+     * for other work while the deck loads. Returns -1 for an empty copy.
+     */
+    int loadTrackToDeck(PointerWrapper<AudioTrack> copy);
+
     // Display deck status
     void displayDeckStatus() const;
 
     /**
      * Contract: Determine if decks A and the given track can be mixed
      * @return true if mixable by BPM/key criteria; false otherwise
+     * When both tracks carry a beat grid measured from their audio, a
+     * half- or double-time tempo match also counts as mixable.
      */
     bool can_mix_tracks(const PointerWrapper<AudioTrack>& track) const;
 
@@ -54,6 +80,7 @@ public:
      */
     void set_auto_sync(bool enabled) {
         auto_sync = enabled;
+        if (renderer) renderer->set_auto_sync(enabled);
     }
 
     /**
@@ -63,7 +90,51 @@ public:
     void set_bpm_tolerance(int tolerance) {
         bpm_tolerance = tolerance;
     }
+    int get_bpm_tolerance() const { return bpm_tolerance; }
+
+    /**
+     * @brief Track on the active deck (owned by the mixer), or nullptr
+     */
+    const AudioTrack* get_active_track() const { return decks[active_deck].track; }
+
+    /**
+     * @brief Number of decks (1..MAX_DECKS); tracks on decks that go away are unloaded.
+     * Call before enable_rendering.
+     */
+    void set_deck_count(size_t count);
+    size_t get_deck_count() const { return decks.size(); }
+
+    /**
+     * @brief Deck assignment by name (see make_deck_scheduler)
+     * @return false if the name is unknown (the scheduler is unchanged)
+     */
+    bool set_deck_scheduler(const std::string& name);
+    const char* get_deck_scheduler() const { return scheduler->name(); }
+
+    /**
+     * @brief Start rendering the decks to a sink
+     * @param sink_spec "null", or a .wav file to write
+     * @param block_frames Frames per rendered block (e.g. 128 or 256)
+     * @param crossfade_seconds Length of the crossfade to each newly loaded deck
+     * @return false (with a warning) if the sink cannot be created
+     * @note The renderer runs on demand: each deck load renders its crossfade
+     * (at least one block) as fast as the sink takes it before returning
+     */
+    bool enable_rendering(const std::string& sink_spec, size_t block_frames, int sample_rate, double crossfade_seconds);
+
+    /**
+     * @brief Wait until the renderer has applied every deck command and
+     * rendered what was asked; its stats are then a consistent snapshot
+     */
+    void drain_rendering() { if (renderer) renderer->sync(); }
+
+    /**
+     * @brief The running renderer, or nullptr
+     */
+    const AudioRenderer* get_renderer() const { return renderer ? renderer.get() : nullptr; }
 
+private:
+    int place_on_deck(PointerWrapper<AudioTrack> copy);
 };
 
 #endif // MIXINGENGINESERVICE_H
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "Mp3FrameIndex.h"
+#include <cstddef>
+#include <mutex>
+#include <string>
+
+/**
+ * @brief An MP3 file on disk with its frame index, built once on first use
+ *
+ * Construction only records the path, so an Mp3File is created with a track
+ * and shared by all of its copies: the first open() maps the file and scans
+ * it, every later call (from any copy, on any thread) reuses that index.
+ */
+class Mp3File {
+private:
+    mutable std::mutex lock;
+    std::string path;
+    bool attempted;
+    std::string error;
+    MappedFile mapping;
+    Mp3FrameIndex index;
+
+    // Rule of Three: owns the mapping (and a mutex)
+    Mp3File(const Mp3File&);
+    Mp3File& operator=(const Mp3File&);
+
+public:
+    explicit Mp3File(const std::string& path);
+    ~Mp3File();
+
+    /**
+     * @brief Map and index the file (only the first call does any work)
+     * @param skip_id3 Skip a leading ID3v2 tag instead of resyncing over it
+     * @return false if the file is missing or holds no MPEG audio frames
+     */
+    bool open(bool skip_id3);
+
+    bool is_open() const;
+    const std::string& get_path() const { return path; }
+    std::string get_error() const;
+    size_t file_bytes() const;
+
+    /**
+     * @brief The frame index (empty until open() succeeds; immutable after)
+     */
+    const Mp3FrameIndex& get_index() const { return index; }
+
+    /**
+     * @brief Frame data of the mapped file (nullptr until open() succeeds)
+     */
+    const unsigned char* data() const;
+
+    /**
+     * @brief Number of frame scans performed by all Mp3Files in the process
+     */
+    static size_t index_builds();
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Decoded fields of one MPEG audio frame header
+ */
+struct Mp3FrameHeader {
+    int version;        // 10 = MPEG-1, 20 = MPEG-2, 25 = MPEG-2.5
+    int layer;          // 1, 2 or 3
+    int bitrate_kbps;
+    int sample_rate;
+    bool padding;
+    bool mono;
+    size_t frame_bytes;
+    int samples;        // PCM samples per channel in this frame
+
+    Mp3FrameHeader()
+        : version(0), layer(0), bitrate_kbps(0), sample_rate(0), padding(false), mono(false),
+          frame_bytes(0), samples(0) {}
+};
+
+/**
+ * @brief Frame offset / seek table of an MPEG audio (MP3) stream
+ *
+ * build() walks the frame headers once: it skips a leading ID3v2 tag when
+ * asked to, resynchronizes over junk (a candidate frame must be followed by
+ * a matching header, the end of the data or an ID3v1 tag), and leaves out a
+ * Xing/Info metadata frame. Each audio frame costs 8 bytes in the table: its
+ * byte offset and first sample, so time -> frame is a binary search.
+ * Free-format streams are not supported. Offsets are 32-bit (files < 4 GB).
+ */
+class Mp3FrameIndex {
+public:
+    struct Entry {
+        uint32_t offset;        // byte offset of the frame header in the data
+        uint32_t first_sample;  // samples per channel before this frame
+    };
+
+private:
+    std::vector<Entry> frames;
+    int sample_rate;
+    uint64_t total_samples;
+    uint64_t audio_bytes;       // bytes of the indexed frames
+    size_t id3_bytes;           // leading ID3v2 tag skipped
+    size_t skipped_bytes;       // junk passed over while resynchronizing
+    bool variable_bitrate;
+
+public:
+    Mp3FrameIndex();
+
+    /**
+     * @brief Index a complete stream held in memory
+     * @param skip_id3 Skip a leading ID3v2 tag by its declared size
+     * @param error Set to the reason on failure
+     * @return false if no frames were found
+     */
+    bool build(const unsigned char* data, size_t size, bool skip_id3, std::string& error);
+    void clear();
+
+    /**
+     * @brief Decode a 4-byte frame header
+     * @return false if p does not start a valid (non free-format) header
+     */
+    static bool parse_header(const unsigned char* p, Mp3FrameHeader& header);
+
+    size_t frame_count() const { return frames.size(); }
+    const Entry& frame(size_t i) const { return frames[i]; }
+    int get_sample_rate() const { return sample_rate; }
+    double duration_seconds() const;
+    int average_bitrate_kbps() const;
+    bool is_vbr() const { return variable_bitrate; }
+    size_t get_id3_bytes() const { return id3_bytes; }
+    size_t get_skipped_bytes() const { return skipped_bytes; }
+    size_t memory_bytes() const { return frames.capacity() * sizeof(Entry); }
+
+    /**
+     * @brief Frame containing the given time, clamped to the last frame (O(log n))
+     */
+    size_t frame_at(double seconds) const;
+
+    /**
+     * @brief Byte offset to start decoding at for the given time (0 if empty)
+     */
+    size_t offset_at(double seconds) const;
+};
@@ -4,6 +4,8 @@
 #include "AudioTrack.h"
 #include <string>
 #include <vector>
+#include <unordered_map>
+#include <cstddef>
 
 /**
  * ⚠️  WARNING: THIS CLASS HAS INTENTIONAL MEMORY LEAKS! ⚠️
@@ -13,27 +15,38 @@
  * @note In phase 4, the library service should provide canonical ownership semantics
  * for tracks referenced by playlists. Fixes in earlier phases should ensure
  * clear ownership and safe iteration without leaks.
+ *
+ * Tracks are stored contiguously in insertion order. A title -> index hash
+ * makes find_track O(1); with duplicate titles the most recently added track
+ * wins (it is found and removed first), and each slot links to the previous
+ * slot with the same title so removing it exposes the older one in O(1).
+ * remove_track leaves a nullptr hole that is compacted away once holes make
+ * up half of the store.
+ *
+ * A playlist either owns its tracks (deletes them, deep-clones on copy) or
+ * borrows them from a longer-lived owner such as the library (never deletes,
+ * copies share the pointers). Moves never clone in either mode.
  */
-
-struct PlaylistNode {
-    AudioTrack* track; 
-    PlaylistNode* next;
-
-    PlaylistNode(AudioTrack* t) : track(t), next(nullptr) {}
-    ~PlaylistNode() = default;
-};
-
 class Playlist {
+public:
+    enum TrackOwnership { OWNS_TRACKS, BORROWS_TRACKS };
+
 private:
-    PlaylistNode* head;
+    static const size_t NO_INDEX = static_cast<size_t>(-1);
+
+    std::vector<AudioTrack*> tracks;                      // insertion order, nullptr = removed
+    std::vector<size_t> prev_same_title;                  // parallel to tracks
+    std::unordered_map<std::string, size_t> title_index;  // title -> newest slot
     std::string playlist_name;
     int track_count;
+    TrackOwnership ownership;
 
 public:
     /**
      * Constructor
+     * @param ownership BORROWS_TRACKS for a view over tracks owned elsewhere
      */
-    Playlist(const std::string& name="");
+    Playlist(const std::string& name="", TrackOwnership ownership = OWNS_TRACKS);
 
     /**
      * Destructor
@@ -41,18 +54,34 @@ public:
     ~Playlist();
 
     /**
-     * Copy constructor - deep copy of all nodes and tracks
+     * Copy constructor - deep copy of all tracks (owning playlists only)
      */
     Playlist(const Playlist& other);
 
     /**
-     * Copy assignment operator - deep copy of all nodes and tracks
+     * Copy assignment operator - deep copy of all tracks (owning playlists only)
      */
     Playlist& operator=(const Playlist& other);
 
+    /**
+     * Move constructor - takes over the tracks; other is left empty
+     */
+    Playlist(Playlist&& other) noexcept;
+
+    /**
+     * Move assignment operator - releases own tracks, takes over other's
+     */
+    Playlist& operator=(Playlist&& other) noexcept;
+
+    /**
+     * Reserve room for a number of tracks before adding them
+     */
+    void reserve(size_t count);
+
     /**
      * Add a track to the playlist
-     * @param track Pointer to AudioTrack to add
+     * @param track Pointer to AudioTrack to add (ownership passes to the
+     * playlist unless it borrows its tracks)
      */
     void add_track(AudioTrack* track);
 
@@ -63,7 +92,7 @@ public:
     void remove_track(const std::string& title);
 
     /**
-     * Display all tracks in the playlist
+     * Display all tracks in the playlist (most recently added first)
      */
     void display() const;
 
@@ -73,6 +102,7 @@ public:
      */
     int get_track_count() const { return track_count; }
     const std::string& get_name() const { return playlist_name; }
+    bool owns_tracks() const { return ownership == OWNS_TRACKS; }
 
     /**
      * @param title Title of the track to find
@@ -84,7 +114,7 @@ public:
     /**
      * Check if playlist is empty
      */
-    bool is_empty() const { return head == nullptr; }
+    bool is_empty() const { return track_count == 0; }
 
     /**
      * Calculate total duration of all tracks
@@ -92,10 +122,16 @@ public:
     int get_total_duration() const;
 
     /**
-     * Get all tracks as a vector
+     * Get all tracks in insertion order (no copy)
+     * @note Removed tracks leave nullptr entries until the store is compacted
      */
-    std::vector<AudioTrack*> getTracks() const;
+    const std::vector<AudioTrack*>& getTracks() const { return tracks; }
 
+private:
+    void append(AudioTrack* track);
+    void clear();
+    void compact();
+    void copy_from(const Playlist& other);
 };
 
 
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "AudioTrack.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Outcome of PlaylistOptimizer::optimize
+ */
+struct PlaylistPlan {
+    std::vector<AudioTrack*> order;     // the optimized sequence
+    double cost_before;                 // sum of transition costs in the given order
+    double cost_nearest;                // after the nearest-neighbour construction
+    double cost_after;
+    size_t syncs_before;                // transitions can_mix_tracks would reject (forced sync_bpm)
+    size_t syncs_after;
+    size_t two_opt_moves;
+    size_t or_opt_moves;
+    size_t passes;
+    double milliseconds;
+
+    PlaylistPlan() : order(), cost_before(0.0), cost_nearest(0.0), cost_after(0.0), syncs_before(0), syncs_after(0),
+                     two_opt_moves(0), or_opt_moves(0), passes(0), milliseconds(0.0) {}
+};
+
+/**
+ * @brief Reorders a playlist to minimize the sum of its transition costs
+ *
+ * A transition costs its BPM gap (the metric of
+ * MixingEngineService::can_mix_tracks: direct, or half/double time when
+ * both tracks have measured grids), plus KEY_STEP_COST per step on the
+ * Camelot wheel (UNKNOWN_KEY_COST when either key is unknown), plus
+ * SYNC_COST when the gap exceeds the BPM tolerance and the mixer would
+ * have to force sync_bpm. Costs are symmetric.
+ *
+ * The solver keeps the first track as the opener and builds an open path:
+ * nearest-neighbour construction, then 2-opt (segment reversal) and Or-opt
+ * (moving runs of 1-3 tracks, either way round) until neither improves.
+ * Both local searches only try joining a track to one of its NEIGHBOURS
+ * cheapest partners, so a pass checks O(n * NEIGHBOURS) moves. The lists
+ * are found by walking out from each track's tempo in BPM order, which the
+ * BPM gap bounds, rather than by comparing every pair; 5000 tracks take
+ * well under a second.
+ * The result depends only on the input order.
+ */
+class PlaylistOptimizer {
+public:
+    static const double KEY_STEP_COST;
+    static const double UNKNOWN_KEY_COST;
+    static const double SYNC_COST;
+    static const size_t NEIGHBOURS = 10;
+    static const size_t MAX_SEGMENT = 3;
+    static const size_t MAX_PASSES = 50;
+
+private:
+    // Track attributes the cost reads, packed for the inner loops
+    struct Node {
+        int bpm;
+        int key;
+        bool measured;
+    };
+
+    int bpm_tolerance;
+    std::vector<Node> nodes;
+    std::vector<int> by_bpm;                    // nodes sorted by BPM
+    std::vector<std::vector<int>> neighbours;   // per node, cheapest partners first
+    std::vector<int> order;                     // node per position
+    std::vector<int> position;                  // position per node
+    std::vector<unsigned> seen;                 // closest(): last search that visited each node
+    unsigned stamp;
+
+public:
+    explicit PlaylistOptimizer(int bpm_tolerance);
+
+    /**
+     * @brief BPM gap between two tracks as can_mix_tracks measures it
+     */
+    static int bpm_gap(const AudioTrack& a, const AudioTrack& b);
+
+    double transition_cost(const AudioTrack& from, const AudioTrack& to) const;
+
+    /**
+     * @brief Sum of transition costs along tracks (nullptr entries skipped)
+     */
+    double sequence_cost(const std::vector<AudioTrack*>& tracks) const;
+
+    /**
+     * @brief Forced syncs along tracks: transitions whose gap exceeds the tolerance
+     */
+    size_t sequence_syncs(const std::vector<AudioTrack*>& tracks) const;
+
+    /**
+     * @brief Optimize the order of tracks (nullptr entries dropped); the first track stays first
+     */
+    PlaylistPlan optimize(const std::vector<AudioTrack*>& tracks);
+
+private:
+    double cost(int a, int b) const;
+    double edge(size_t from_position) const;
+    double path_cost() const;
+    void closest(int node, size_t count, const std::vector<bool>* skip, std::vector<std::pair<double, int>>& found);
+    void build_neighbours();
+    void nearest_neighbour();
+    bool two_opt_pass(size_t& moves);
+    bool or_opt_pass(size_t& moves);
+    void reverse(size_t first, size_t last);
+    void move_segment(size_t first, size_t length, int after, bool reversed);
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Windowed-sinc sample rate converter with a polyphase coefficient table
+ *
+ * The low-pass kernel (Kaiser-windowed sinc, cut off just below the lower
+ * of the two Nyquist rates) is tabulated once at PHASES sub-sample offsets
+ * of TAPS taps each. An output sample at a fractional input position is the
+ * dot product of the TAPS surrounding input samples with the two nearest
+ * phases, interpolated linearly, so any ratio works (44.1 <-> 48 <-> 96 kHz)
+ * without a rational L/M factorization.
+ *
+ * The table is built in the constructor; process() only reads it and can
+ * run on the render thread.
+ */
+class PolyphaseResampler {
+public:
+    static const size_t TAPS = 32;
+    static const size_t HALF_TAPS = TAPS / 2;
+    static const size_t PHASES = 256;
+
+private:
+    double step;                        // input frames per output frame
+    std::vector<float> coefficients;    // (PHASES + 1) rows of TAPS
+    bool use_simd;
+
+public:
+    PolyphaseResampler(double input_rate, double output_rate, bool vectorized = true);
+
+    double get_step() const { return step; }
+    bool vectorized() const { return use_simd; }
+
+    /**
+     * @brief Resample one channel
+     *
+     * The output sample at input position p is built from
+     * in[floor(p) - HALF_TAPS + 1 .. floor(p) + HALF_TAPS], so position must
+     * be at least HALF_TAPS - 1. Stops when out is full or the next sample
+     * would need input past in_frames.
+     *
+     * @param position Input position of the next output sample; advanced past the last one made
+     * @return Output samples written
+     */
+    size_t process(const float* in, size_t in_frames, double& position, float* out, size_t out_frames) const;
+
+    /**
+     * @brief Input frames process() keeps before the position (its history)
+     */
+    static size_t history() { return HALF_TAPS - 1; }
+};
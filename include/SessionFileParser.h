@@ -21,6 +21,9 @@ struct SessionConfig {
         int bpm;
         int extra_param1;        // bitrate for MP3, sample_rate for WAV
         int extra_param2;        // has_tags for MP3, bit_depth for WAV
+        std::string file_path;   // optional path=... attribute (WAV files are read from it)
+        int key;                 // optional key=... (Camelot or musical), as a HarmonicIndex key code, -1 = none
+        int energy;              // optional energy=1..10, 0 = none
         
         TrackInfo() 
             : type(""), 
@@ -29,18 +32,43 @@ struct SessionConfig {
               duration_seconds(0), 
               bpm(0), 
               extra_param1(0), 
-              extra_param2(0) {}
+              extra_param2(0), 
+              file_path(""),
+              key(-1),
+              energy(0) {}
     };
     
     std::vector<TrackInfo> library_tracks;
+    int library_build_threads;       // threads constructing library tracks, 1 = serial
+    size_t waveform_memory_budget;   // bytes of resident waveforms, 0 = unlimited
+    std::string waveform_format_mp3; // f64 | f32 | i16 | peaks, empty = f64
+    std::string waveform_format_wav;
     
     // Cache settings
     int controller_cache_size;
+    int controller_cache_shards;     // >1 enables the sharded, thread-safe cache
+    size_t controller_cache_bytes;   // memory budget in bytes, 0 = slot count only
+    std::string controller_cache_policy;        // lru | arc | tinylfu
+    bool controller_cache_compare_policies;     // replay requests through every policy
+    int controller_prefetch_depth;   // upcoming tracks prepared on a background thread, 0 = off
     
+    // Diagnostics
+    std::string session_trace_file;  // append every controller request here (cache_sim input)
+    bool session_allocation_stats;   // report track copies/waveform allocations in the summary
+    bool session_pipeline;           // lookup, cache load and deck load on one thread each
+    std::string analysis_cache_file; // beat analysis results kept across runs, empty = memory only
+
     // Mixing settings
     int default_crossfade_time;
     int bpm_tolerance;
     bool auto_sync;
+    int mixer_deck_count;
+    std::string mixer_deck_scheduler;   // round_robin | least_recently_finished | bpm_nearest
+    std::string mixer_render_sink;   // null | path of a .wav file, empty = no rendering
+    int mixer_block_frames;
+    int mixer_sample_rate;
+    int mixer_suggestions;          // compatible next tracks listed after each load, 0 = off
+    int mixer_energy_tolerance;     // largest energy step a suggestion may take
     
     // Playlists - name mapped to list of track indices
     std::map<std::string, std::vector<int>> playlists;
@@ -48,10 +76,30 @@ struct SessionConfig {
         : app_name(""), 
           version(""), 
           library_tracks(), 
+          library_build_threads(1), 
+          waveform_memory_budget(0), 
+          waveform_format_mp3(""), 
+          waveform_format_wav(""), 
           controller_cache_size(8), 
+          controller_cache_shards(1), 
+          controller_cache_bytes(0), 
+          controller_cache_policy("lru"), 
+          controller_cache_compare_policies(false), 
+          controller_prefetch_depth(0), 
+          session_trace_file(""), 
+          session_allocation_stats(false), 
+          session_pipeline(false), 
+          analysis_cache_file(""), 
           default_crossfade_time(5), 
           bpm_tolerance(10), 
           auto_sync(true), 
+          mixer_deck_count(2), 
+          mixer_deck_scheduler("round_robin"), 
+          mixer_render_sink(""), 
+          mixer_block_frames(256), 
+          mixer_sample_rate(44100), 
+          mixer_suggestions(0), 
+          mixer_energy_tolerance(2), 
           playlists() {}
 };
 
@@ -81,7 +129,8 @@ struct PlaylistData {
  * This helper class handles parsing of the file formats.
  * Phase 4 note: Playlists are discovered under ./playlists (interactive selection).
  * The app uses bpm_tolerance and auto_sync settings; default_crossfade_time is ignored
- * for logging/behavior in the instant-transition model.
+ * for logging/behavior in the instant-transition model, and only sets the crossfade
+ * length of the rendered audio when mixer_render_sink is set.
  */
 class SessionFileParser {
 public:
@@ -97,9 +146,31 @@ public:
      * version=2.0
      * library_track_1=MP3,title,{artist1;artist2;},duration,bpm,bitrate,has_tags
      * library_track_2=WAV,title,{artist1;artist2;},duration,bpm,sample_rate,bit_depth
+     * library_track_3=WAV,title,{artist;},duration,bpm,sample_rate,bit_depth,path=/music/a.wav
+     * library_track_4=MP3,title,{artist;},duration,bpm,bitrate,has_tags,key=8A,energy=6
+     * library_build_threads=1
+     * waveform_memory_budget=64M   (optional K/M/G suffix)
+     * waveform_format=f64          (or waveform_format_mp3 / waveform_format_wav)
      * controller_cache_size=8
+     * controller_cache_shards=1
+     * controller_cache_bytes=512M   (optional K/M/G suffix)
+     * controller_cache_policy=lru
+     * controller_cache_compare_policies=false
+     * controller_prefetch_depth=0
+     * session_trace_file=cache_trace.txt
+     * session_allocation_stats=false
+     * session_pipeline=false
+     * analysis_cache_file=bin/analysis_cache.txt
      * bpm_tolerance=10
      * auto_sync=true
+     * default_crossfade_time=5     (seconds)
+     * mixer_deck_count=2
+     * mixer_deck_scheduler=round_robin
+     * mixer_render_sink=null       (or a .wav file to write)
+     * mixer_block_frames=256
+     * mixer_sample_rate=44100
+     * mixer_suggestions=0          (top-K compatible next tracks after each load)
+     * mixer_energy_tolerance=2
      * playlistname=1,2,3
      */
     static bool parse_config_file(const std::string& config_path, SessionConfig& config);
@@ -153,6 +224,14 @@ private:
      * @return Parsed boolean value
      */
     static bool parse_bool(const std::string& str);
+
+    /**
+     * @brief Parse a byte count with optional K/M/G suffix (powers of 1024)
+     * @param str String such as "4096", "64K" or "1.5G"
+     * @return Parsed number of bytes
+     * @throws std::invalid_argument if the string is not a number
+     */
+    static size_t parse_byte_size(const std::string& str);
     
     /**
      * @brief Check if line is a comment (starts with #)
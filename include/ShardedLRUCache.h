@@ -0,0 +1,117 @@
+#pragma once
+
+#include "LRUCache.h"
+#include "AudioTrack.h"
+#include "PointerWrapper.h"
+#include <vector>
+#include <cstddef>
+#include <string>
+#include <mutex>
+
+/**
+ * @brief Thread-safe LRU cache split into independently locked shards
+ *
+ * Each track id is mapped to one shard by hashing its title. A shard is a
+ * plain LRUCache guarded by its own mutex, so it keeps its own recency order
+ * and access counter; threads that touch different shards never contend.
+ * LRU order is therefore per shard, not global.
+ *
+ * With a single shard the behaviour (and displayStatus output) is identical
+ * to a bare LRUCache, which is how DJControllerService runs by default.
+ * Every shard runs its own instance of the configured CachePolicy.
+ *
+ * Pointer lifetime: get() returns a pointer owned by the cache that stays
+ * valid only until another thread evicts the entry. Threads sharing the cache
+ * should use getClone() to obtain an owned copy under the shard lock.
+ */
+class ShardedLRUCache {
+private:
+    struct Shard {
+        LRUCache cache;
+        mutable std::mutex lock;
+
+        Shard(size_t capacity, PointerWrapper<CachePolicy> policy)
+            : cache(capacity, std::move(policy)), lock() {}
+    };
+
+    std::vector<PointerWrapper<Shard>> shards;
+    size_t max_size;
+    size_t max_bytes;       // total byte budget, split evenly over shards (0 = off)
+    std::string policy;     // policy name every shard is built with
+
+    // Rule of Three: shards own mutexes and tracks
+    ShardedLRUCache(const ShardedLRUCache&);
+    ShardedLRUCache& operator=(const ShardedLRUCache&);
+
+public:
+    /**
+     * @brief Construct a sharded cache
+     * @param capacity Total number of tracks across all shards
+     * @param shard_count Number of shards (clamped to [1, capacity])
+     * @param policy_name Replacement policy for every shard (see make_cache_policy)
+     */
+    explicit ShardedLRUCache(size_t capacity, size_t shard_count = 1,
+                             const std::string& policy_name = "lru");
+
+    bool contains(const std::string& track_id) const;
+
+    /**
+     * @brief Get a track (updates the owning shard's LRU order)
+     * @return Raw pointer owned by the cache, or nullptr if not found
+     */
+    AudioTrack* get(const std::string& track_id);
+
+    /**
+     * @brief Get an owned clone of a cached track (updates LRU order)
+     * @return Clone made under the shard lock, or an empty wrapper if not found
+     */
+    PointerWrapper<AudioTrack> getClone(const std::string& track_id);
+
+    /**
+     * @brief Put a track into its shard (evicts that shard's LRU if full)
+     * @return true if an eviction occurred
+     */
+    bool put(PointerWrapper<AudioTrack> track);
+
+    /**
+     * @brief Evict the LRU entry of the fullest shard
+     * @return true if a track was evicted
+     */
+    bool evictLRU();
+
+    size_t size() const;
+    size_t capacity() const { return max_size; }
+    size_t shard_count() const { return shards.size(); }
+    const std::string& policy_name() const { return policy; }
+    bool isFull() const { return size() >= max_size; }
+
+    /**
+     * @brief Set the total memory budget in bytes (0 disables it)
+     */
+    void set_byte_budget(size_t bytes);
+    size_t byte_budget() const { return max_bytes; }
+    size_t bytes_used() const;
+    size_t bytes_evicted() const;
+    size_t eviction_count() const;
+    void clear();
+    void displayStatus() const;
+
+    /**
+     * @brief Resize and re-shard the cache. Existing entries are dropped
+     * unless the shard count and policy are unchanged.
+     * Not safe to call while other threads use the cache.
+     * @return false if policy_name is unknown (LRU is used instead)
+     */
+    bool configure(size_t capacity, size_t shard_count, const std::string& policy_name);
+
+    /**
+     * @brief Update the total capacity keeping the current shard count and policy
+     */
+    void set_capacity(size_t capacity) { configure(capacity, shards.size(), policy); }
+
+private:
+    Shard& shardFor(const std::string& track_id) const;
+    void buildShards(size_t capacity, size_t shard_count);
+    PointerWrapper<CachePolicy> newPolicy() const;
+    static size_t shardCapacity(size_t capacity, size_t shard_count, size_t shard);
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "BlockPool.h"
+#include <cstddef>
+
+/**
+ * @brief Size-class slabs for variable-sized buffers (waveforms, shared track data)
+ *
+ * Requests up to MAX_POOLED bytes are rounded up to the next power of two
+ * (at least MIN_POOLED) and served from that class's BlockPool; larger ones
+ * go straight to the system heap. The pools live for the whole process.
+ */
+class BufferSlabs {
+public:
+    static const size_t MIN_POOLED = 64;
+    static const size_t MAX_POOLED = 64 * 1024;
+
+    static void* allocate(size_t bytes);
+    static void deallocate(void* buffer, size_t bytes);
+
+    /**
+     * @brief Requests larger than MAX_POOLED, served by the system heap
+     */
+    static size_t heap_allocations();
+
+private:
+    static BlockPool* pool_for(size_t bytes);
+};
+
+/**
+ * @brief Standard allocator drawing from BufferSlabs
+ *
+ * Stateless, so containers and shared_ptr control blocks using it can
+ * exchange memory freely.
+ */
+template<typename T>
+class SlabAllocator {
+public:
+    typedef T value_type;
+
+    SlabAllocator() {}
+    template<typename U>
+    SlabAllocator(const SlabAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(BufferSlabs::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+        BufferSlabs::deallocate(p, n * sizeof(T));
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const SlabAllocator<T>&, const SlabAllocator<U>&) { return true; }
+
+template<typename T, typename U>
+bool operator!=(const SlabAllocator<T>&, const SlabAllocator<U>&) { return false; }
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Bounded lock-free queue for exactly one producer and one consumer thread
+ *
+ * A power-of-two ring of preallocated slots with a free-running head
+ * (next to pop, written only by the consumer) and tail (next to push,
+ * written only by the producer). Neither side ever blocks, locks or
+ * allocates: try_push() fails when the ring is full and try_pop() when it
+ * is empty. Each side also keeps a private copy of the other side's index
+ * and only rereads the shared one when the copy says full/empty, so in
+ * steady state the two threads do not bounce each other's cache lines.
+ */
+template<typename T>
+class SpscQueue {
+private:
+    static const size_t CACHE_LINE = 64;
+
+    std::vector<T> slots;
+    size_t mask;
+
+    std::atomic<size_t> head;           // consumer position
+    char head_pad[CACHE_LINE];
+    size_t tail_cache;                  // consumer's last view of tail
+    char consumer_pad[CACHE_LINE];
+
+    std::atomic<size_t> tail;           // producer position
+    char tail_pad[CACHE_LINE];
+    size_t head_cache;                  // producer's last view of head
+
+    // Rule of Three: shared between two threads by address
+    SpscQueue(const SpscQueue&);
+    SpscQueue& operator=(const SpscQueue&);
+
+    static size_t round_up(size_t n) {
+        size_t size = 2;
+        while (size < n) size <<= 1;
+        return size;
+    }
+
+public:
+    /**
+     * @param capacity Minimum number of queued items (rounded up to a power of two)
+     */
+    explicit SpscQueue(size_t capacity)
+        : slots(round_up(capacity)), mask(slots.size() - 1), head(0), head_pad(), tail_cache(0),
+          consumer_pad(), tail(0), tail_pad(), head_cache(0) {}
+
+    size_t capacity() const { return slots.size(); }
+
+    /**
+     * @brief Producer side: copy item into the ring
+     * @return false if the ring is full (item is not queued)
+     */
+    bool try_push(const T& item) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        if (position - head_cache == slots.size()) {
+            head_cache = head.load(std::memory_order_acquire);
+            if (position - head_cache == slots.size()) return false;
+        }
+        slots[position & mask] = item;
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer side: move the oldest item out
+     * @return false if the ring is empty
+     */
+    bool try_pop(T& item) {
+        size_t position = head.load(std::memory_order_relaxed);
+        if (position == tail_cache) {
+            tail_cache = tail.load(std::memory_order_acquire);
+            if (position == tail_cache) return false;
+        }
+        item = slots[position & mask];
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Items queued right now (exact only on the producer or consumer thread)
+     */
+    size_t size() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+};
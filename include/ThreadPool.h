@@ -0,0 +1,53 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed-size pool of worker threads with a shared FIFO task queue
+ *
+ * submit() queues a task; wait() blocks until every submitted task has
+ * finished and rethrows the first exception a task threw. Tasks must not
+ * call wait() on their own pool. The destructor finishes queued tasks.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    size_t active;                      // tasks currently running
+    bool stopping;
+    std::exception_ptr first_error;
+
+    std::mutex lock;
+    std::condition_variable task_ready;
+    std::condition_variable all_done;
+
+    // Rule of Three: owns threads
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+
+public:
+    /**
+     * @param threads Number of workers (at least 1)
+     */
+    explicit ThreadPool(size_t threads);
+    ~ThreadPool();
+
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Wait for all submitted tasks; rethrows the first task exception
+     */
+    void wait();
+
+    size_t size() const { return workers.size(); }
+
+private:
+    void run();
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Streaming WSOLA time-stretcher for planar stereo
+ *
+ * Changes tempo without changing pitch. Output is built from Hann-windowed
+ * segments of WINDOW frames laid down every WINDOW/2 output frames, while
+ * the read position in the input advances ratio * WINDOW/2 per segment.
+ * Each segment is taken from within +-WINDOW/4 of that nominal position, at
+ * the offset whose start correlates best with the audio that naturally
+ * followed the previous segment, so waveforms line up in the overlap and
+ * beats are not smeared (Waveform Similarity Overlap-Add).
+ *
+ * Input is pushed and output pulled in blocks of any size; the ratio can
+ * change between calls and takes effect from the next segment. Every buffer
+ * is allocated in the constructor, so push/pull/set_ratio/reset are safe on
+ * the render thread.
+ */
+class TimeStretcher {
+public:
+    static const double MIN_RATIO;
+    static const double MAX_RATIO;
+
+private:
+    size_t window;              // segment length in frames
+    size_t hop;                 // output frames per segment
+    size_t tolerance;           // search radius around the nominal position
+    size_t max_block;           // largest pull
+    double ratio;               // input frames consumed per output frame
+    bool use_simd;
+
+    std::vector<float> hann;
+    std::vector<float> in_left;     // input not yet consumed, planar
+    std::vector<float> in_right;
+    std::vector<float> in_mono;     // (left + right) / 2, for the similarity search
+    size_t in_count;
+    double next_position;           // nominal start of the next segment, in in_* frames
+    size_t previous;                // start of the previous segment
+    bool have_previous;
+
+    std::vector<double> energy;     // prefix sums of in_mono^2 over the search range
+    std::vector<float> overlap_left;    // windowed segments still being summed
+    std::vector<float> overlap_right;
+    std::vector<float> output;      // interleaved stereo, finished frames
+    size_t out_read;
+    size_t out_count;
+    size_t segments;
+
+public:
+    /**
+     * @param max_block Largest number of frames pull() is asked for at once
+     */
+    TimeStretcher(int sample_rate, size_t max_block, bool vectorized = true);
+
+    /**
+     * @brief Drop all buffered audio (e.g. a new track was loaded)
+     */
+    void reset();
+
+    /**
+     * @brief Tempo factor: 2 plays twice as fast (clamped to MIN_RATIO..MAX_RATIO)
+     */
+    void set_ratio(double ratio);
+    double get_ratio() const { return ratio; }
+
+    /**
+     * @brief Append input, making as much output as there is room for
+     * @return Frames taken (fewer than frames only when the output is full)
+     */
+    size_t push(const float* left, const float* right, size_t frames);
+
+    /**
+     * @brief Input frames still needed before the next segment can be made
+     */
+    size_t input_wanted() const;
+
+    /**
+     * @brief Finished output frames ready to pull
+     */
+    size_t available() const { return out_count; }
+
+    /**
+     * @brief Copy up to frames finished stereo frames to out (interleaved)
+     * @return Frames copied
+     */
+    size_t pull(float* out, size_t frames);
+
+    size_t get_window() const { return window; }
+    size_t get_segments() const { return segments; }
+    bool vectorized() const { return use_simd; }
+
+private:
+    bool make_segment();
+    size_t find_offset(size_t low, size_t high, size_t target);
+    float similarity(size_t candidate, size_t target, size_t low) const;
+    void discard_consumed();
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CachePolicy.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Count-min sketch of 4-bit access counters with periodic aging
+ *
+ * Estimates how often a key was seen recently. After sample_size increments
+ * every counter is halved so old popularity fades.
+ */
+class FrequencySketch {
+private:
+    static const size_t DEPTH = 4;
+    std::vector<uint8_t> table;   // DEPTH rows of `width` counters
+    size_t width;                 // power of two
+    size_t additions;
+    size_t sample_size;
+
+public:
+    FrequencySketch() : table(), width(0), additions(0), sample_size(0) {}
+
+    void resize(size_t expected_entries);
+    void increment(const std::string& key);
+    unsigned frequency(const std::string& key) const;
+
+private:
+    size_t indexOf(uint64_t hash, size_t row) const;
+    void age();
+};
+
+/**
+ * @brief W-TinyLFU: small LRU window in front of a segmented LRU main area
+ *
+ * New keys always enter the window (~1% of capacity). When the window
+ * overflows, its LRU candidate competes with the main area's victim and is
+ * admitted only if the sketch says it is used more often. The main area is
+ * split into probation (20%) and protected (80%) segments; a hit in
+ * probation promotes to protected. One-hit wonders from a long scan stay in
+ * the window and never displace the hot set.
+ */
+class TinyLFUPolicy : public CachePolicy {
+private:
+    enum Segment { NONE = 0, WINDOW = 1, PROBATION = 2, PROTECTED = 3 };
+
+    size_t capacity;
+    size_t window_capacity;
+    size_t protected_capacity;
+    CacheSlotList window;
+    CacheSlotList probation;
+    CacheSlotList protected_list;
+    std::vector<unsigned char> segment;   // slot -> Segment
+    FrequencySketch sketch;
+
+public:
+    TinyLFUPolicy();
+
+    const char* name() const override { return "tinylfu"; }
+    void reset(size_t capacity) override;
+    void on_hit(std::vector<CacheSlot>& slots, size_t slot) override;
+    void before_insert(const std::string& key) override;
+    size_t select_victim(std::vector<CacheSlot>& slots) override;
+    void on_evict(std::vector<CacheSlot>& slots, size_t slot) override;
+    void on_insert(std::vector<CacheSlot>& slots, size_t slot) override;
+    PointerWrapper<CachePolicy> create_empty() const override;
+
+private:
+    void ensureSlot(size_t slot);
+    void moveTo(std::vector<CacheSlot>& slots, size_t slot, Segment target);
+    CacheSlotList& listFor(Segment seg);
+    size_t mainVictim() const;
+};
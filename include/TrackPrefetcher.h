@@ -0,0 +1,104 @@
+#pragma once
+
+#include "AudioTrack.h"
+#include "PointerWrapper.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+/**
+ * @brief Prefetch counters reported in the session summary
+ */
+struct PrefetchStats {
+    size_t requested;   // tracks queued for prefetch
+    size_t completed;   // tracks cloned, loaded and analyzed by the worker
+    size_t hits;        // cache misses served by a prefetched track
+    size_t waited;      // ... of which the worker was still preparing
+    size_t wasted;      // prefetched tracks dropped unused
+
+    PrefetchStats() : requested(0), completed(0), hits(0), waited(0), wasted(0) {}
+};
+
+/**
+ * @brief Background worker that prepares upcoming tracks for the controller
+ *
+ * The worker clones a library track, runs load() and analyze_beatgrid() on
+ * the clone and stages the result together with the log it produced. It never
+ * touches the controller cache: the owner adopts staged tracks on the main
+ * thread (take()), so cache order, hits and evictions match a serial run and
+ * no raw pointer handed out by the cache can be invalidated by the worker.
+ *
+ * Requested tracks must outlive the request (library tracks do).
+ * With depth 0 no thread is started and every call is a no-op.
+ */
+class TrackPrefetcher {
+private:
+    struct Staged {
+        PointerWrapper<AudioTrack> track;
+        std::string log;    // load/analysis output captured on the worker
+
+        Staged() : track(), log() {}
+    };
+
+    size_t max_depth;
+    std::deque<const AudioTrack*> pending;
+    std::unordered_map<std::string, Staged> staged;
+    std::string in_flight;  // title being prepared ("" if idle)
+    bool busy;
+    bool stopping;
+    PrefetchStats stats;
+
+    mutable std::mutex lock;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+    std::thread worker;
+
+    // Rule of Three: owns a thread and staged tracks
+    TrackPrefetcher(const TrackPrefetcher&);
+    TrackPrefetcher& operator=(const TrackPrefetcher&);
+
+public:
+    TrackPrefetcher();
+    ~TrackPrefetcher();
+
+    /**
+     * @brief Set the lookahead depth; starts the worker on first use
+     */
+    void set_depth(size_t depth);
+    size_t depth() const { return max_depth; }
+    bool enabled() const { return max_depth > 0; }
+
+    /**
+     * @brief Queue a track unless it is already pending, in flight or staged
+     */
+    void request(const AudioTrack& track);
+
+    /**
+     * @brief Hand over the prepared track for a title
+     *
+     * Waits if the worker is preparing it right now; cancels it if still queued.
+     * @param log Receives the output the worker captured for the track
+     * @return The prepared clone, or an empty wrapper if it was never requested
+     */
+    PointerWrapper<AudioTrack> take(const std::string& title, std::string& log);
+
+    /**
+     * @brief Drop a staged or queued title that is not needed (counted as wasted)
+     */
+    void discard(const std::string& title);
+
+    /**
+     * @brief Cancel queued work and drop all staged tracks (counted as wasted)
+     */
+    void discard_all();
+
+    PrefetchStats get_stats() const;
+
+private:
+    void run();
+    void stop();
+};
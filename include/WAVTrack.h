@@ -2,6 +2,10 @@
 #define WAVTRACK_H
 
 #include "AudioTrack.h"
+#include "BlockPool.h"
+#include "WavFile.h"
+#include <memory>
+#include <string>
 
 /**
  * WAVTrack - Represents a WAV audio file with high-quality uncompressed audio
@@ -14,18 +18,36 @@
  * - get_quality_score(): derived from sample_rate and bit_depth (higher => better).
  * - clone(): return a deep polymorphic copy used by the mixer; source remains unchanged.
  * - get_quality_score(): function of sample_rate and bit_depth (both higher -> better).
+ *
+ * A track may name a real .wav file. load() then memory-maps it (once, shared
+ * by every copy of the track), takes sample_rate, bit_depth and duration from
+ * its header and exposes the PCM frames through get_pcm() without copying,
+ * and analyze_beatgrid() detects the tempo and beat grid from those frames.
  */
 class WAVTrack : public AudioTrack {
 private:
     int sample_rate;    // Samples per second: 44100 (CD), 48000 (pro), 96000+ (hi-res)
     int bit_depth;      // Bits per sample: 16 (CD), 24 (pro), 32 (float)
+    std::shared_ptr<WavFile> file;   // nullptr if the track has no file path
+
+    static WaveformFormat default_waveform_format;   // applied to new tracks
+
+    // Map the file (once per file) and write its header format to
+    // rate/depth/seconds; false (values untouched) if it cannot be read
+    bool read_header(int& rate, int& depth, int& seconds) const;
+    void print_load(bool mapped, int rate, int depth, int seconds) const;
+    // Grid carried by this track, else the analysis cache's (analyzing on a
+    // miss); nullptr unless the file is mapped
+    std::shared_ptr<const BeatGrid> measure_grid() const;
+    void print_analysis(const BeatGrid* grid, int seconds) const;
 
 public:
     /**
      * Constructor for WAVTrack
      */
     WAVTrack(const std::string& title, const std::vector<std::string>& artists, 
-             int duration, int bpm, int sample_rate, int bit_depth);
+             int duration, int bpm, int sample_rate, int bit_depth,
+             const std::string& file_path = "");
 
     // ========== TODO: IMPLEMENT VIRTUAL FUNCTIONS ==========
 
@@ -41,6 +63,13 @@ public:
      */
     void analyze_beatgrid() override;
 
+    void prepare() const override;
+
+    /**
+     * Maps the file to hash it; header values are still applied by load()
+     */
+    bool apply_cached_beatgrid() override;
+
     /**
      * TODO: Implement quality score calculation
      * HINT: Use sample rate and bit depth for quality (both higher = better)
@@ -53,9 +82,38 @@ public:
      */
     PointerWrapper<AudioTrack> clone() const override;
 
+    /**
+     * Base footprint plus the decoded PCM audio payload
+     */
+    size_t get_memory_footprint() const override;
+
+    /**
+     * Waveform storage format for WAV tracks constructed from now on (f64 by default);
+     * set before tracks are built on other threads
+     */
+    static void set_default_waveform_format(WaveformFormat format) { default_waveform_format = format; }
+    static WaveformFormat get_default_waveform_format() { return default_waveform_format; }
+
+    /**
+     * WAVTracks are allocated from a per-class BlockPool, so clone() and
+     * destruction never reach the system heap once the pool is warm.
+     * Ownership is unchanged: PointerWrapper's delete lands here through the
+     * virtual destructor. Derived classes of another size use the global heap.
+     */
+    static void* operator new(size_t size);
+    static void operator delete(void* block, size_t size);
+    static BlockPoolStats get_pool_stats();
+
     // Getters
     int get_sample_rate() const { return sample_rate; }
     int get_bit_depth() const { return bit_depth; }
+    std::string get_file_path() const { return file ? file->get_path() : std::string(); }
+
+    /**
+     * PCM frames of the mapped file (empty if there is no file or load() has
+     * not mapped it); valid while any copy of this track lives
+     */
+    PcmView get_pcm() const { return file ? file->pcm() : PcmView(); }
 };
 
 #endif // WAVTRACK_H
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+/**
+ * @brief Read-only view of interleaved PCM frames inside a mapped WAV file
+ *
+ * Points straight into the mapping; valid while the owning WavFile lives.
+ */
+struct PcmView {
+    const unsigned char* bytes;
+    size_t frames;
+    int channels;
+    int bits_per_sample;     // container bits: 8, 16, 24 or 32
+    bool is_float;           // IEEE float (32-bit) instead of integer PCM
+    size_t block_align;      // bytes per frame
+
+    PcmView() : bytes(nullptr), frames(0), channels(0), bits_per_sample(0), is_float(false), block_align(0) {}
+
+    /**
+     * @brief One sample scaled to [-1, 1]
+     */
+    double sample(size_t frame, int channel) const;
+
+    /**
+     * @brief Convert frames [first, first + count) to interleaved floats in [-1, 1]
+     * @return Frames written to out (which must hold count * channels floats)
+     */
+    size_t decode(size_t first, size_t count, float* out) const;
+};
+
+/**
+ * @brief Memory-mapped RIFF/WAVE reader
+ *
+ * open() maps the file and parses the RIFF, fmt and data chunks in place;
+ * nothing is copied, the PCM frames are read through pcm() straight from the
+ * page cache. Integer PCM (8/16/24/32-bit), 32-bit float and
+ * WAVE_FORMAT_EXTENSIBLE headers are accepted.
+ *
+ * Construction only records the path, so a WavFile can be created with a
+ * track and shared by all of its copies; the first open() does the work and
+ * later calls return its result. Thread-safe.
+ */
+class WavFile {
+private:
+    mutable std::mutex lock;
+    std::string path;
+    bool attempted;
+    std::string error;          // why open() failed, empty on success
+    MappedFile mapping;
+    PcmView view;
+    int rate;
+    uint64_t hash;              // content_hash(), 0 until first asked
+
+    // Rule of Three: owns the mapping (and a mutex)
+    WavFile(const WavFile&);
+    WavFile& operator=(const WavFile&);
+
+public:
+    explicit WavFile(const std::string& path);
+    ~WavFile();
+
+    /**
+     * @brief Map and parse the file (only the first call does any work)
+     * @return false if the file is missing or not a supported WAV
+     */
+    bool open();
+
+    bool is_open() const;
+    const std::string& get_path() const { return path; }
+    std::string get_error() const;
+
+    int sample_rate() const;
+    int bit_depth() const;
+    int channels() const;
+    size_t frame_count() const;
+    double duration_seconds() const;
+    size_t file_bytes() const;
+
+    /**
+     * @brief Zero-copy PCM frames (empty until open() succeeds)
+     */
+    PcmView pcm() const;
+
+    /**
+     * @brief Hash of the file contents, computed on first call (0 until open() succeeds)
+     */
+    uint64_t content_hash();
+
+private:
+    bool parse(std::string& why);
+};
@@ -0,0 +1,216 @@
+#pragma once
+
+#include "SlabAllocator.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief How a resident waveform keeps its samples
+ *
+ * PEAKS keeps only the peak/RMS mipmap resident; full-resolution samples are
+ * regenerated on request and not retained.
+ */
+enum WaveformFormat { WAVEFORM_F64, WAVEFORM_F32, WAVEFORM_I16, WAVEFORM_PEAKS };
+
+/**
+ * @brief Config name of a format ("f64", "f32", "i16", "peaks")
+ */
+const char* waveform_format_name(WaveformFormat format);
+
+/**
+ * @brief Parse a config name (case-insensitive)
+ * @return false if the name is unknown (format is left unchanged)
+ */
+bool parse_waveform_format(const std::string& name, WaveformFormat& format);
+
+/**
+ * @brief Process-wide waveform memory counters
+ */
+struct WaveformStats {
+    size_t allocations;         // buffers materialized or copied
+    size_t bytes_allocated;
+    size_t bytes_copied;        // copy-on-write detaches of resident buffers
+    size_t releases;            // buffers dropped (explicitly or by the budget)
+    size_t resident_bytes;      // bytes currently held by budget-managed waveforms
+
+    WaveformStats() : allocations(0), bytes_allocated(0), bytes_copied(0), releases(0), resident_bytes(0) {}
+};
+
+struct PeakRms {
+    float peak;     // max |sample| in the block
+    float rms;
+};
+
+/**
+ * @brief Multi-resolution peak/RMS summary for display and beat analysis
+ *
+ * Level 0 summarizes blocks of BASE_BLOCK samples; each further level halves
+ * the block count until a single block covers the whole waveform.
+ */
+class WaveformMipmap {
+public:
+    static const size_t BASE_BLOCK = 32;
+
+private:
+    std::vector<std::vector<PeakRms>> levels;
+
+public:
+    WaveformMipmap() : levels() {}
+
+    void build(const double* samples, size_t n);
+    size_t level_count() const { return levels.size(); }
+    const std::vector<PeakRms>& level(size_t k) const { return levels[k]; }
+    static size_t block_size(size_t k) { return BASE_BLOCK << k; }
+    size_t bytes() const;
+    static size_t bytes_for(size_t samples);
+};
+
+/**
+ * @brief Immutable materialized samples in one format (shared by readers)
+ */
+struct WaveformStorage {
+    WaveformFormat format;
+    size_t samples;
+    uint64_t seed;                  // regenerates PEAKS samples on request
+    std::vector<double, SlabAllocator<double>> f64;      // buffers come from the size-class slabs
+    std::vector<float, SlabAllocator<float>> f32;
+    std::vector<int16_t, SlabAllocator<int16_t>> i16;
+    WaveformMipmap mipmap;          // PEAKS only
+
+    WaveformStorage(WaveformFormat format, size_t samples, uint64_t seed)
+        : format(format), samples(samples), seed(seed), f64(), f32(), i16(), mipmap() {}
+
+    size_t bytes() const;
+
+    /**
+     * @brief Convert the first n samples to double (n <= samples)
+     */
+    void copy_to(double* out, size_t n) const;
+};
+
+/**
+ * @brief Read-only, pinned view of a waveform's samples
+ *
+ * Stays valid while held, even if the waveform is released meanwhile.
+ * Exactly one of f64()/f32()/i16()/mipmap() is non-null for a non-empty view.
+ */
+class WaveformSamples {
+private:
+    std::shared_ptr<const WaveformStorage> storage;
+
+public:
+    WaveformSamples() : storage() {}
+    explicit WaveformSamples(std::shared_ptr<const WaveformStorage> storage) : storage(std::move(storage)) {}
+
+    explicit operator bool() const { return static_cast<bool>(storage); }
+    size_t size() const { return storage ? storage->samples : 0; }
+    WaveformFormat format() const { return storage ? storage->format : WAVEFORM_F64; }
+
+    const double* f64() const { return storage && storage->format == WAVEFORM_F64 ? storage->f64.data() : nullptr; }
+    const float* f32() const { return storage && storage->format == WAVEFORM_F32 ? storage->f32.data() : nullptr; }
+    const int16_t* i16() const { return storage && storage->format == WAVEFORM_I16 ? storage->i16.data() : nullptr; }
+    const WaveformMipmap* mipmap() const {
+        return storage && storage->format == WAVEFORM_PEAKS ? &storage->mipmap : nullptr;
+    }
+
+    /**
+     * @brief Convert the first n samples to double (n <= size())
+     */
+    void copy_to(double* out, size_t n) const { if (storage) storage->copy_to(out, n); }
+};
+
+/**
+ * @brief Lazily materialized analysis waveform of one track
+ *
+ * Holds only a sample count, a format and a seed until something reads the
+ * samples; the first acquire() generates them deterministically from the
+ * seed, so a released waveform comes back identical. Copies share the
+ * materialized storage.
+ *
+ * With a memory budget set, resident waveforms are kept in a global LRU
+ * list and the least recently acquired ones are released once the budget is
+ * exceeded. A waveform handed out through mutable_data() holds edits that
+ * cannot be regenerated, so it is never released.
+ *
+ * All methods are thread-safe.
+ */
+class Waveform {
+private:
+    mutable std::mutex lock;
+    mutable std::shared_ptr<WaveformStorage> data;   // nullptr until materialized
+    size_t samples;
+    uint64_t seed;
+    WaveformFormat format;
+    bool dirty;                             // edited through mutable_data()
+
+    // Global LRU links, guarded by the registry lock
+    Waveform* lru_prev;
+    Waveform* lru_next;
+    bool listed;
+    size_t listed_bytes;
+
+    Waveform& operator=(const Waveform&);
+
+public:
+    Waveform(size_t samples, uint64_t seed, WaveformFormat format = WAVEFORM_F64);
+
+    /**
+     * @brief Copy sharing the other's materialized storage (no sample copy)
+     */
+    Waveform(const Waveform& other);
+    ~Waveform();
+
+    size_t size() const { return samples; }
+    bool resident() const;
+    WaveformFormat get_format() const;
+
+    /**
+     * @brief Bytes the samples occupy once materialized in the current format
+     */
+    size_t storage_bytes() const;
+
+    /**
+     * @brief Change the resident representation; a resident waveform is
+     * released and regenerated in the new format on next use. Ignored for
+     * edited waveforms, which stay f64.
+     */
+    void set_format(WaveformFormat new_format);
+
+    /**
+     * @brief Samples, materialized on first use; marks the waveform recently used
+     */
+    WaveformSamples acquire() const;
+
+    /**
+     * @brief Writable f64 samples (converted from the current format if needed);
+     * the caller must own this waveform exclusively
+     */
+    double* mutable_data();
+
+    /**
+     * @brief Drop the samples (regenerated on the next acquire())
+     * @return false if not resident or holding edits
+     */
+    bool release();
+
+    /**
+     * @brief Limit the bytes held by resident waveforms (0 = unlimited)
+     */
+    static void set_memory_budget(size_t bytes);
+    static size_t memory_budget();
+    static WaveformStats get_stats();
+
+    /**
+     * @brief The deterministic dummy samples of a seed, in [-1, 1)
+     */
+    static void generate(uint64_t seed, double* out, size_t n);
+
+private:
+    std::shared_ptr<WaveformStorage> materialize() const;
+    void touch() const;
+    void unlist() const;
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Sample conversion and reduction kernels used by Waveform
+ *
+ * The plain names use SSE2 when the compiler targets it (always on x86-64)
+ * and fall back to the scalar versions otherwise; the *_scalar variants are
+ * always available for checking and benchmarks. int16 samples map [-1, 1]
+ * to [-32767, 32767], rounding to nearest and saturating out-of-range values.
+ */
+class WaveformKernels {
+public:
+    static void f64_to_f32(const double* in, float* out, size_t n);
+    static void f32_to_f64(const float* in, double* out, size_t n);
+    static void f64_to_i16(const double* in, int16_t* out, size_t n);
+    static void i16_to_f64(const int16_t* in, double* out, size_t n);
+
+    /**
+     * @brief Peak (max |x|) and sum of squares of a block
+     */
+    static void peak_sumsq(const double* in, size_t n, double& peak, double& sumsq);
+
+    static void f64_to_f32_scalar(const double* in, float* out, size_t n);
+    static void f32_to_f64_scalar(const float* in, double* out, size_t n);
+    static void f64_to_i16_scalar(const double* in, int16_t* out, size_t n);
+    static void i16_to_f64_scalar(const int16_t* in, double* out, size_t n);
+    static void peak_sumsq_scalar(const double* in, size_t n, double& peak, double& sumsq);
+
+    /**
+     * @brief true if the plain kernels use SIMD in this build
+     */
+    static bool vectorized();
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "PointerWrapper.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Thread pool with one task deque per worker and work stealing
+ *
+ * submit() from outside the pool deals tasks round-robin over the worker
+ * deques; a task submitted from inside a worker goes to that worker's own
+ * deque. Workers run their own tasks newest first and, once out of work,
+ * steal the oldest task of another worker. Unlike ThreadPool's single FIFO,
+ * a worker stuck on a long task never holds up the short ones queued
+ * behind it, and workers only contend on a lock when stealing.
+ *
+ * wait() blocks until every submitted task has finished and rethrows the
+ * first exception a task threw. Tasks must not call wait() on their own
+ * pool. The destructor finishes queued tasks.
+ */
+class WorkStealingPool {
+private:
+    struct TaskQueue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+
+        TaskQueue() : lock(), tasks() {}
+    };
+
+    std::vector<PointerWrapper<TaskQueue>> queues;     // one per worker
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queued;         // tasks waiting in any deque
+    std::atomic<size_t> stolen;
+    size_t unfinished;                  // submitted and not yet finished
+    size_t next_queue;                  // round-robin target for outside submits
+    bool stopping;
+    std::exception_ptr first_error;
+
+    std::mutex lock;                    // guards unfinished, next_queue, stopping, first_error
+    std::condition_variable work_ready;
+    std::condition_variable all_done;
+
+    // Rule of Three: owns threads
+    WorkStealingPool(const WorkStealingPool&);
+    WorkStealingPool& operator=(const WorkStealingPool&);
+
+public:
+    /**
+     * @param threads Number of workers (at least 1)
+     */
+    explicit WorkStealingPool(size_t threads);
+    ~WorkStealingPool();
+
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Wait for all submitted tasks; rethrows the first task exception
+     */
+    void wait();
+
+    size_t size() const { return workers.size(); }
+
+    /**
+     * @brief Tasks run by a worker other than the one they were queued on
+     */
+    size_t steal_count() const { return stolen; }
+
+private:
+    void run(size_t self);
+    bool take(size_t self, std::function<void()>& task);
+};
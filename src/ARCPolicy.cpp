@@ -0,0 +1,133 @@
+#include "ARCPolicy.h"
+#include <algorithm>
+
+// ========== GhostList ==========
+
+void ARCPolicy::GhostList::push_front(const std::string& key) {
+    erase(key);
+    keys.push_front(key);
+    where[key] = keys.begin();
+}
+
+void ARCPolicy::GhostList::erase(const std::string& key) {
+    auto it = where.find(key);
+    if (it == where.end()) return;
+    keys.erase(it->second);
+    where.erase(it);
+}
+
+void ARCPolicy::GhostList::pop_back() {
+    if (keys.empty()) return;
+    where.erase(keys.back());
+    keys.pop_back();
+}
+
+// ========== ARCPolicy ==========
+
+ARCPolicy::ARCPolicy()
+    : capacity(0), target_t1(0), t1(), t2(), b1(), b2(), membership(),
+      pending_in_b2(false), pending_ghost_hit(false), drop_next_victim(false) {}
+
+void ARCPolicy::reset(size_t new_capacity) {
+    capacity = new_capacity;
+    target_t1 = 0;
+    t1.reset();
+    t2.reset();
+    b1.clear();
+    b2.clear();
+    membership.assign(capacity, NONE);
+    pending_in_b2 = pending_ghost_hit = drop_next_victim = false;
+}
+
+void ARCPolicy::on_hit(std::vector<CacheSlot>& slots, size_t slot) {
+    // Case I: any resident hit becomes MRU of T2
+    ensureSlot(slot);
+    if (membership[slot] == T1) t1.unlink(slots, slot);
+    else if (membership[slot] == T2) t2.unlink(slots, slot);
+    t2.push_front(slots, slot);
+    membership[slot] = T2;
+}
+
+void ARCPolicy::before_insert(const std::string& key) {
+    pending_in_b2 = pending_ghost_hit = drop_next_victim = false;
+
+    if (b1.contains(key)) {
+        // Case II: recency ghost hit -> grow T1's target
+        size_t delta = std::max<size_t>(b1.size() ? b2.size() / b1.size() : 1, 1);
+        target_t1 = std::min(capacity, target_t1 + delta);
+        b1.erase(key);
+        pending_ghost_hit = true;
+        return;
+    }
+    if (b2.contains(key)) {
+        // Case III: frequency ghost hit -> shrink T1's target
+        size_t delta = std::max<size_t>(b2.size() ? b1.size() / b2.size() : 1, 1);
+        target_t1 = (target_t1 > delta) ? target_t1 - delta : 0;
+        b2.erase(key);
+        pending_ghost_hit = true;
+        pending_in_b2 = true;
+        return;
+    }
+
+    // Case IV: complete miss, keep the directory within 2c entries
+    size_t l1 = t1.size() + b1.size();
+    size_t total = l1 + t2.size() + b2.size();
+    if (l1 >= capacity) {
+        if (t1.size() < capacity) b1.pop_back();
+        else drop_next_victim = true;
+    } else if (total >= 2 * capacity) {
+        b2.pop_back();
+    }
+}
+
+size_t ARCPolicy::select_victim(std::vector<CacheSlot>& slots) {
+    (void)slots;
+    if (t1.empty()) return t2.back();
+    if (t2.empty()) return t1.back();
+    if (drop_next_victim) return t1.back();
+
+    // REPLACE(x, p)
+    bool from_t1 = (pending_in_b2 && t1.size() == target_t1) || t1.size() > target_t1;
+    return from_t1 ? t1.back() : t2.back();
+}
+
+void ARCPolicy::on_evict(std::vector<CacheSlot>& slots, size_t slot) {
+    ensureSlot(slot);
+    const std::string& key = slots[slot].getKey();
+
+    if (membership[slot] == T1) {
+        t1.unlink(slots, slot);
+        if (!drop_next_victim) b1.push_front(key);
+        drop_next_victim = false;
+    } else if (membership[slot] == T2) {
+        t2.unlink(slots, slot);
+        b2.push_front(key);
+    }
+    membership[slot] = NONE;
+
+    // Manual evictions bypass case IV; keep ghosts bounded anyway
+    while (b1.size() + b2.size() > capacity) {
+        if (b1.size() > b2.size()) b1.pop_back();
+        else b2.pop_back();
+    }
+}
+
+void ARCPolicy::on_insert(std::vector<CacheSlot>& slots, size_t slot) {
+    ensureSlot(slot);
+    if (pending_ghost_hit) {
+        t2.push_front(slots, slot);
+        membership[slot] = T2;
+    } else {
+        t1.push_front(slots, slot);
+        membership[slot] = T1;
+    }
+    pending_in_b2 = pending_ghost_hit = drop_next_victim = false;
+}
+
+PointerWrapper<CachePolicy> ARCPolicy::create_empty() const {
+    return PointerWrapper<CachePolicy>(new ARCPolicy());
+}
+
+void ARCPolicy::ensureSlot(size_t slot) {
+    if (slot >= membership.size()) membership.resize(slot + 1, NONE);
+}
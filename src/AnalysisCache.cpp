@@ -0,0 +1,145 @@
+#include "AnalysisCache.h"
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+static const char* FILE_MAGIC = "# dj analysis cache v";
+
+AnalysisCache::AnalysisCache()
+    : lock(), entries(), file_path(), dirty(false), stats() {}
+
+AnalysisCache& AnalysisCache::instance() {
+    static AnalysisCache cache;
+    return cache;
+}
+
+std::string AnalysisCache::make_key(const std::string& type, const std::string& title, uint64_t content_hash) {
+    std::ostringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0') << content_hash << '\t' << type << '\t' << title;
+    return key.str();
+}
+
+std::shared_ptr<const BeatGrid> AnalysisCache::beat_grid(const std::string& type, const std::string& title,
+                                                         uint64_t content_hash, const std::function<BeatGrid()>& analyze) {
+    std::string key = make_key(type, title, content_hash);
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            stats.hits++;
+            return it->second;
+        }
+        stats.misses++;
+    }
+
+    // Two threads missing on the same key both analyze; the first result is kept
+    std::shared_ptr<const BeatGrid> grid = std::make_shared<const BeatGrid>(analyze());
+    std::lock_guard<std::mutex> guard(lock);
+    auto inserted = entries.insert(std::make_pair(key, grid));
+    if (inserted.second) dirty = true;
+    return inserted.first->second;
+}
+
+std::shared_ptr<const BeatGrid> AnalysisCache::find(const std::string& type, const std::string& title,
+                                                    uint64_t content_hash) {
+    std::string key = make_key(type, title, content_hash);
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = entries.find(key);
+    if (it == entries.end()) return nullptr;
+    stats.hits++;
+    return it->second;
+}
+
+bool AnalysisCache::empty() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return entries.empty();
+}
+
+size_t AnalysisCache::open_file(const std::string& path) {
+    std::lock_guard<std::mutex> guard(lock);
+    file_path = path;
+    std::ifstream in(path.c_str());
+    if (!in.is_open()) return 0;
+
+    std::string line;
+    std::ostringstream expected;
+    expected << FILE_MAGIC << VERSION;
+    if (!std::getline(in, line) || line != expected.str()) return 0;
+
+    size_t loaded = 0;
+    while (std::getline(in, line)) {
+        // hash, bpm, first_beat, beat_count, confidence, type, title
+        std::vector<std::string> fields;
+        size_t start = 0;
+        for (int i = 0; i < 6; ++i) {
+            size_t tab = line.find('\t', start);
+            if (tab == std::string::npos) break;
+            fields.push_back(line.substr(start, tab - start));
+            start = tab + 1;
+        }
+        if (fields.size() != 6) continue;
+        fields.push_back(line.substr(start));
+
+        BeatGrid grid;
+        uint64_t content_hash = 0;
+        try {
+            content_hash = std::stoull(fields[0], nullptr, 16);
+            grid.bpm = std::stod(fields[1]);
+            grid.first_beat = std::stod(fields[2]);
+            grid.beat_count = static_cast<size_t>(std::stoull(fields[3]));
+            grid.confidence = std::stod(fields[4]);
+        } catch (const std::exception&) {
+            continue;
+        }
+        std::string key = make_key(fields[5], fields[6], content_hash);
+        if (entries.insert(std::make_pair(key, std::make_shared<const BeatGrid>(grid))).second) loaded++;
+    }
+    stats.loaded += loaded;
+    return loaded;
+}
+
+bool AnalysisCache::save() {
+    std::lock_guard<std::mutex> guard(lock);
+    if (file_path.empty() || !dirty) return true;
+
+    // Write a temporary file and rename it over the old one, so a crash never leaves half a cache
+    std::string temp_path = file_path + ".tmp";
+    std::ofstream out(temp_path.c_str(), std::ios::trunc);
+    if (!out.is_open()) return false;
+    out << FILE_MAGIC << VERSION << '\n' << std::setprecision(17);
+    size_t written = 0;
+    for (const auto& entry : entries) {
+        // The key is already "hash<TAB>type<TAB>title"; keys holding a newline cannot round-trip
+        if (entry.first.find('\n') != std::string::npos) continue;
+        const std::string& key = entry.first;
+        size_t type_start = key.find('\t') + 1;
+        const BeatGrid& grid = *entry.second;
+        out << key.substr(0, type_start) << grid.bpm << '\t' << grid.first_beat << '\t' << grid.beat_count
+            << '\t' << grid.confidence << '\t' << key.substr(type_start) << '\n';
+        written++;
+    }
+    out.close();
+    if (!out || std::rename(temp_path.c_str(), file_path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    dirty = false;
+    stats.saved = written;
+    return true;
+}
+
+AnalysisCacheStats AnalysisCache::get_stats() const {
+    std::lock_guard<std::mutex> guard(lock);
+    AnalysisCacheStats snapshot = stats;
+    snapshot.entries = entries.size();
+    return snapshot;
+}
+
+void AnalysisCache::clear() {
+    std::lock_guard<std::mutex> guard(lock);
+    entries.clear();
+    dirty = false;
+    stats = AnalysisCacheStats();
+}
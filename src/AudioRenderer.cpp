@@ -0,0 +1,458 @@
+#include "AudioRenderer.h"
+#include "WAVTrack.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+const double AudioRenderer::MAX_STEP = 4.0;
+
+static const size_t HISTOGRAM_BUCKETS = 8192;       // 1 us each; the last also holds anything slower
+static const double PI = 3.14159265358979324;
+static const double HALF_PI = PI / 2.0;
+static const double CLICK_HZ = 880.0;
+static const double CLICK_DECAY = 60.0;             // per second
+static const double CLICK_SECONDS = 0.08;
+static const int IDLE_SLEEP_US = 50;                // on-demand render thread with nothing to do
+
+AudioRenderer::AudioRenderer(AudioSink* sink, size_t block_frames, int sample_rate, size_t deck_count, bool realtime)
+    : block_frames(block_frames), sample_rate(sample_rate > 0 ? sample_rate : 44100), realtime(realtime),
+      on_demand(false), sink(sink), commands(COMMAND_QUEUE_SIZE), retired(2 * COMMAND_QUEUE_SIZE),
+      decks(deck_count > 0 ? deck_count : 1), mix(), click(), auto_sync(true), deck_bpm(decks.size(), 0.0), posted(0),
+      render_thread(), running(false), blocks(0), applied(0), block_limit(0), misses(0), total_ns(0), max_ns(0),
+      histogram(HISTOGRAM_BUCKETS) {
+    if (this->block_frames < MIN_BLOCK_FRAMES) this->block_frames = MIN_BLOCK_FRAMES;
+    if (this->block_frames > AudioSink::MAX_BLOCK_FRAMES) this->block_frames = AudioSink::MAX_BLOCK_FRAMES;
+
+    // Every buffer the render thread writes is sized here. The stretcher is
+    // fed at most a block at a time, which the resampler makes from at most
+    // block * MAX_STEP frames plus its filter history.
+    size_t history_frames = static_cast<size_t>(this->block_frames * MAX_STEP) + PolyphaseResampler::TAPS + 4;
+    for (Deck& deck : decks) {
+        deck.scratch.assign(history_frames * MAX_CHANNELS, 0.0f);
+        deck.history_left.assign(history_frames, 0.0f);
+        deck.history_right.assign(history_frames, 0.0f);
+        deck.chunk_left.assign(this->block_frames, 0.0f);
+        deck.chunk_right.assign(this->block_frames, 0.0f);
+        deck.stretcher = PointerWrapper<TimeStretcher>(new TimeStretcher(this->sample_rate, this->block_frames));
+        deck.out.assign(this->block_frames * 2, 0.0f);
+    }
+    mix.assign(this->block_frames * 2, 0.0f);
+
+    click.assign(static_cast<size_t>(CLICK_SECONDS * this->sample_rate) + 1, 0.0f);
+    for (size_t i = 0; i < click.size(); ++i) {
+        double t = i / static_cast<double>(this->sample_rate);
+        click[i] = static_cast<float>(0.5 * std::exp(-t * CLICK_DECAY) * std::sin(2.0 * PI * CLICK_HZ * t));
+    }
+}
+
+AudioRenderer::~AudioRenderer() {
+    stop();
+    for (Deck& deck : decks) {
+        delete deck.source;
+        deck.source = nullptr;
+    }
+    collect_retired();
+}
+
+void AudioRenderer::start() {
+    if (running) return;
+    running = true;
+    render_thread = std::thread(&AudioRenderer::run, this);
+}
+
+void AudioRenderer::stop() {
+    if (running) {
+        running = false;
+        render_thread.join();
+    }
+    // Commands the thread did not get to still apply, so deck state stays consistent
+    Command command;
+    while (commands.try_pop(command)) apply(command);
+    collect_retired();
+    if (sink) sink->close();
+}
+
+// ========== CONTROL ==========
+
+void AudioRenderer::advance(double seconds) {
+    size_t count = seconds > 0.0 ? static_cast<size_t>(std::ceil(seconds * sample_rate / block_frames)) : 1;
+    if (count == 0) count = 1;
+    size_t target = block_limit.fetch_add(count, std::memory_order_release) + count;
+    while (running && blocks.load(std::memory_order_acquire) < target) std::this_thread::yield();
+    collect_retired();
+}
+
+void AudioRenderer::sync() {
+    while (running && (applied.load(std::memory_order_acquire) < posted
+                       || blocks.load(std::memory_order_acquire) < block_limit.load(std::memory_order_relaxed))) {
+        std::this_thread::yield();
+    }
+    collect_retired();
+}
+
+void AudioRenderer::post(const Command& command) {
+    collect_retired();
+    posted++;
+    if (!running) {
+        // No render thread: the control thread owns the deck state
+        apply(command);
+        collect_retired();
+        return;
+    }
+    // Only the control side ever waits, and only while the render thread catches up
+    while (!commands.try_push(command)) std::this_thread::yield();
+}
+
+void AudioRenderer::collect_retired() {
+    DeckSource* source = nullptr;
+    while (retired.try_pop(source)) delete source;
+}
+
+AudioRenderer::DeckSource* AudioRenderer::make_source(const AudioTrack& track) const {
+    DeckSource* source = new DeckSource();
+    source->track = track.clone();
+    source->bpm = track.get_bpm() > 0 ? track.get_bpm() : 120.0;
+
+    const WAVTrack* wav = dynamic_cast<const WAVTrack*>(source->track.get());
+    if (wav) {
+        PcmView pcm = wav->get_pcm();
+        int rate = wav->get_sample_rate();
+        if (pcm.frames > 0 && pcm.channels > 0 && static_cast<size_t>(pcm.channels) <= MAX_CHANNELS
+            && rate > 0 && rate <= sample_rate * MAX_STEP) {
+            source->pcm = pcm;
+            source->source_rate = rate;
+            // Filter table built here, off the render thread
+            if (rate != sample_rate) {
+                source->resampler = PointerWrapper<PolyphaseResampler>(new PolyphaseResampler(rate, sample_rate));
+            }
+            return source;
+        }
+    }
+
+    // No audio to play: a click on every beat
+    source->beat_frames = sample_rate * 60.0 / source->bpm;
+    source->source_rate = sample_rate;
+    return source;
+}
+
+void AudioRenderer::load_deck(size_t deck, const AudioTrack& track) {
+    if (deck >= decks.size()) return;
+    Command command;
+    command.type = LOAD_DECK;
+    command.deck = deck;
+    command.source = make_source(track);
+    deck_bpm[deck] = command.source->bpm;
+    post(command);
+}
+
+void AudioRenderer::set_deck_bpm(size_t deck, int bpm) {
+    if (deck >= decks.size() || deck_bpm[deck] <= 0.0 || bpm <= 0) return;
+    Command command;
+    command.type = SET_RATE;
+    command.deck = deck;
+    command.value = bpm / deck_bpm[deck];
+    post(command);
+}
+
+void AudioRenderer::set_auto_sync(bool enabled) {
+    Command command;
+    command.type = SET_AUTO_SYNC;
+    command.value = enabled ? 1.0 : 0.0;
+    post(command);
+}
+
+void AudioRenderer::crossfade_to(size_t deck, double seconds) {
+    if (deck >= decks.size()) return;
+    Command command;
+    command.type = CROSSFADE;
+    command.deck = deck;
+    command.frames = seconds > 0.0 ? static_cast<size_t>(seconds * sample_rate) : 0;
+    post(command);
+}
+
+void AudioRenderer::layer_deck(size_t deck, double seconds) {
+    if (deck >= decks.size()) return;
+    Command command;
+    command.type = LAYER;
+    command.deck = deck;
+    command.frames = seconds > 0.0 ? static_cast<size_t>(seconds * sample_rate) : 0;
+    post(command);
+}
+
+// ========== RENDER THREAD ==========
+
+void AudioRenderer::apply(const Command& command) {
+    switch (command.type) {
+        case LOAD_DECK: {
+            Deck& deck = decks[command.deck];
+            // The retired ring holds twice the command ring and the control side
+            // empties it before every post, so it always has room
+            if (deck.source) retired.try_push(deck.source);
+            deck.source = command.source;
+            deck.rate = 1.0;
+            rewind(deck);
+            break;
+        }
+        case SET_RATE:
+            decks[command.deck].rate = command.value;
+            break;
+        case SET_AUTO_SYNC:
+            auto_sync = command.value != 0.0;
+            break;
+        case CROSSFADE:
+            for (size_t i = 0; i < decks.size(); ++i) {
+                start_fade(decks[i], i == command.deck ? HALF_PI : 0.0, command.frames);
+            }
+            break;
+        case LAYER:
+            start_fade(decks[command.deck], HALF_PI, command.frames);
+            break;
+    }
+    // Counted here so commands applied without the thread (stopped, draining) count too
+    applied.fetch_add(1, std::memory_order_release);
+}
+
+// Full range (0 <-> pi/2) takes frames; a deck part-way there keeps that speed
+void AudioRenderer::start_fade(Deck& deck, double target, size_t frames) {
+    deck.theta_target = target;
+    if (frames == 0) {
+        deck.theta = target;
+        deck.theta_step = 0.0;
+    } else {
+        deck.theta_step = HALF_PI / frames;
+    }
+}
+
+// Start a deck's source from the top, keeping every buffer
+void AudioRenderer::rewind(Deck& deck) {
+    deck.position = 0.0;
+    deck.source_frame = 0;
+    deck.tail = 0;
+    // The resampler's first output needs history() frames before it
+    deck.history_count = PolyphaseResampler::history();
+    std::fill(deck.history_left.begin(), deck.history_left.begin() + deck.history_count, 0.0f);
+    std::fill(deck.history_right.begin(), deck.history_right.begin() + deck.history_count, 0.0f);
+    deck.resample_position = static_cast<double>(deck.history_count);
+    deck.stretcher->reset();
+}
+
+// Decode the next frames of the deck's PCM as two planar channels, silence past the end
+size_t AudioRenderer::decode_planar(Deck& deck, float* left, float* right, size_t frames) {
+    const PcmView& pcm = deck.source->pcm;
+    size_t decoded = deck.source_frame < pcm.frames ? pcm.decode(deck.source_frame, frames, deck.scratch.data()) : 0;
+    deck.source_frame += decoded;
+    const float* in = deck.scratch.data();
+    size_t channels = static_cast<size_t>(pcm.channels);
+    size_t second = channels > 1 ? 1 : 0;
+    for (size_t i = 0; i < decoded; ++i) {
+        left[i] = in[i * channels];
+        right[i] = in[i * channels + second];
+    }
+    std::fill(left + decoded, left + frames, 0.0f);
+    std::fill(right + decoded, right + frames, 0.0f);
+    return decoded;
+}
+
+// Fill the deck's chunk with frames of PCM at the output rate
+void AudioRenderer::read_source(Deck& deck, size_t frames) {
+    const DeckSource* source = deck.source;
+    if (!source->resampler) {
+        decode_planar(deck, deck.chunk_left.data(), deck.chunk_right.data(), frames);
+        return;
+    }
+    const PolyphaseResampler& resampler = *source->resampler;
+    // One frame of slack for rounding in the resampler's position steps
+    size_t needed = static_cast<size_t>(deck.resample_position + (frames - 1) * resampler.get_step())
+                    + PolyphaseResampler::HALF_TAPS + 2;
+    if (needed > deck.history_count) {
+        size_t more = std::min(needed, deck.history_left.size()) - deck.history_count;
+        decode_planar(deck, &deck.history_left[deck.history_count], &deck.history_right[deck.history_count], more);
+        deck.history_count += more;
+    }
+    double position = deck.resample_position;
+    size_t made = resampler.process(deck.history_left.data(), deck.history_count, position, deck.chunk_left.data(),
+                                    frames);
+    position = deck.resample_position;
+    resampler.process(deck.history_right.data(), deck.history_count, position, deck.chunk_right.data(), frames);
+    std::fill(deck.chunk_left.begin() + made, deck.chunk_left.begin() + frames, 0.0f);
+    std::fill(deck.chunk_right.begin() + made, deck.chunk_right.begin() + frames, 0.0f);
+
+    // Keep only the filter history behind the new position
+    size_t base = static_cast<size_t>(position);
+    size_t drop = base > PolyphaseResampler::history() ? base - PolyphaseResampler::history() : 0;
+    drop = std::min(drop, deck.history_count);
+    size_t keep = deck.history_count - drop;
+    std::memmove(deck.history_left.data(), &deck.history_left[drop], keep * sizeof(float));
+    std::memmove(deck.history_right.data(), &deck.history_right[drop], keep * sizeof(float));
+    deck.history_count = keep;
+    deck.resample_position = position - drop;
+}
+
+// Clicks keep their pitch: the sync ratio shortens or lengthens the beat
+void AudioRenderer::render_click(Deck& deck) {
+    float* out = deck.out.data();
+    double rate = auto_sync ? deck.rate : 1.0;
+    if (!(rate > 0.0)) rate = 1.0;
+    double length = deck.source->beat_frames / rate;
+    const float* table = click.data();
+    size_t last = click.size() - 1;
+    double position = deck.position;
+    if (position >= length) position = 0.0;
+    for (size_t i = 0; i < block_frames; ++i) {
+        size_t index = static_cast<size_t>(position);
+        float value = index < last ? table[index] : 0.0f;
+        out[2 * i] = value;
+        out[2 * i + 1] = value;
+        position += 1.0;
+        if (position >= length) position -= length;
+    }
+    deck.position = position;
+}
+
+void AudioRenderer::render_deck(Deck& deck) {
+    float* out = deck.out.data();
+    const DeckSource* source = deck.source;
+    if (!source) {
+        std::memset(out, 0, block_frames * 2 * sizeof(float));
+        return;
+    }
+    if (source->beat_frames > 0.0) {
+        render_click(deck);
+        return;
+    }
+
+    TimeStretcher& stretcher = *deck.stretcher;
+    // Once the stretcher has flushed the end of the track the deck is silent
+    if (deck.tail > 4 * stretcher.get_window() && stretcher.available() == 0) {
+        std::memset(out, 0, block_frames * 2 * sizeof(float));
+        return;
+    }
+    stretcher.set_ratio(auto_sync ? deck.rate : 1.0);
+    while (stretcher.available() < block_frames) {
+        size_t frames = std::min(stretcher.input_wanted(), block_frames);
+        if (frames == 0) break;
+        read_source(deck, frames);
+        if (deck.source_frame >= source->pcm.frames) deck.tail += frames;
+        stretcher.push(deck.chunk_left.data(), deck.chunk_right.data(), frames);
+    }
+    size_t pulled = stretcher.pull(out, block_frames);
+    std::fill(out + pulled * 2, out + block_frames * 2, 0.0f);
+}
+
+void AudioRenderer::render_block(float* out) {
+    size_t samples = block_frames * 2;
+    std::memset(out, 0, samples * sizeof(float));
+    for (Deck& deck : decks) {
+        if (deck.theta <= 0.0 && deck.theta_target <= 0.0) continue;
+
+        double theta_end = deck.theta;
+        if (theta_end < deck.theta_target) {
+            theta_end = std::min(deck.theta_target, theta_end + deck.theta_step * block_frames);
+        } else if (theta_end > deck.theta_target) {
+            theta_end = std::max(deck.theta_target, theta_end - deck.theta_step * block_frames);
+        }
+        float gain = static_cast<float>(std::sin(deck.theta));
+        float gain_end = static_cast<float>(std::sin(theta_end));
+        deck.theta = theta_end;
+
+        render_deck(deck);
+        const float* in = deck.out.data();
+        if (gain == gain_end) {
+            for (size_t i = 0; i < samples; ++i) out[i] += gain * in[i];
+            continue;
+        }
+        float slope = (gain_end - gain) / block_frames;
+        for (size_t i = 0; i < block_frames; ++i) {
+            float g = gain + slope * i;
+            out[2 * i] += g * in[2 * i];
+            out[2 * i + 1] += g * in[2 * i + 1];
+        }
+    }
+}
+
+void AudioRenderer::record(uint64_t ns) {
+    total_ns.fetch_add(ns, std::memory_order_relaxed);
+    uint64_t seen = max_ns.load(std::memory_order_relaxed);
+    while (ns > seen && !max_ns.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {}
+    size_t bucket = static_cast<size_t>(ns / 1000);
+    if (bucket >= HISTOGRAM_BUCKETS) bucket = HISTOGRAM_BUCKETS - 1;
+    histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void AudioRenderer::run() {
+    typedef std::chrono::steady_clock Clock;
+    const Clock::duration period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(block_frames / static_cast<double>(sample_rate)));
+    Clock::time_point due = Clock::now() + period;
+
+    while (running.load(std::memory_order_acquire)) {
+        Command command;
+        if (on_demand && (blocks.load(std::memory_order_relaxed) >= block_limit.load(std::memory_order_acquire)
+                          || !sink->ready())) {
+            // Nothing requested (or the sink is full): keep deck state current and wait
+            while (commands.try_pop(command)) apply(command);
+            std::this_thread::sleep_for(std::chrono::microseconds(IDLE_SLEEP_US));
+            continue;
+        }
+        Clock::time_point start = Clock::now();
+        size_t count = 0;
+        while (count < COMMAND_QUEUE_SIZE && commands.try_pop(command)) {
+            apply(command);
+            count++;
+        }
+        render_block(mix.data());
+        sink->write(mix.data(), block_frames);
+        Clock::time_point finish = Clock::now();
+
+        record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count()));
+        blocks.fetch_add(1, std::memory_order_release);
+
+        if (!realtime || on_demand) {
+            if (finish - start > period) misses.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        if (finish > due) {
+            misses.fetch_add(1, std::memory_order_relaxed);
+            // A whole block behind: restart the clock instead of rendering a burst to catch up
+            if (finish - due > period) due = finish;
+        }
+        std::this_thread::sleep_until(due);
+        due += period;
+    }
+}
+
+// ========== STATS ==========
+
+RenderStats AudioRenderer::get_stats() const {
+    RenderStats stats;
+    stats.blocks = blocks.load(std::memory_order_acquire);
+    stats.frames = stats.blocks * block_frames;
+    stats.commands = applied;
+    stats.deadline_misses = misses;
+    stats.dropped_blocks = sink ? sink->dropped_blocks() : 0;
+    stats.budget_us = block_budget_us();
+    if (stats.blocks == 0) return stats;
+    stats.mean_us = total_ns / 1e3 / stats.blocks;
+    stats.max_us = max_ns / 1e3;
+
+    uint64_t counted = 0;
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) counted += histogram[i].load(std::memory_order_relaxed);
+    uint64_t cumulative = 0;
+    bool have_p50 = false;
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+        cumulative += histogram[i].load(std::memory_order_relaxed);
+        // Upper edge of the bucket: a conservative percentile
+        if (!have_p50 && cumulative * 2 >= counted) {
+            stats.p50_us = static_cast<double>(i + 1);
+            have_p50 = true;
+        }
+        if (cumulative * 100 >= counted * 99) {
+            stats.p99_us = static_cast<double>(i + 1);
+            break;
+        }
+    }
+    if (stats.p99_us > stats.max_us) stats.p99_us = stats.max_us;
+    if (stats.p50_us > stats.max_us) stats.p50_us = stats.max_us;
+    return stats;
+}
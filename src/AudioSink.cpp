@@ -0,0 +1,126 @@
+#include "AudioSink.h"
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+static const std::chrono::milliseconds WRITER_IDLE(2);     // writer sleep when the ring is empty
+
+AudioSink* AudioSink::create(const std::string& spec, int sample_rate, std::string& why) {
+    if (spec == "null") return new NullSink();
+    WavFileSink* sink = new WavFileSink(spec, sample_rate);
+    if (!sink->open()) {
+        why = "cannot create " + spec;
+        delete sink;
+        return nullptr;
+    }
+    return sink;
+}
+
+bool NullSink::write(const float*, size_t count) {
+    frames.fetch_add(count, std::memory_order_relaxed);
+    return true;
+}
+
+// ========== WAV FILE SINK ==========
+
+WavFileSink::WavFileSink(const std::string& path, int sample_rate)
+    : path(path), sample_rate(sample_rate), file(nullptr), queue(QUEUE_BLOCKS), staging(), frames(0), dropped(0),
+      closing(false), writer() {}
+
+WavFileSink::~WavFileSink() {
+    close();
+}
+
+bool WavFileSink::open() {
+    if (file) return true;
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    if (!write_header(0)) {
+        std::fclose(file);
+        file = nullptr;
+        return false;
+    }
+    writer = std::thread(&WavFileSink::run, this);
+    return true;
+}
+
+bool WavFileSink::write(const float* interleaved, size_t count) {
+    if (count > MAX_BLOCK_FRAMES) count = MAX_BLOCK_FRAMES;
+    staging.frames = count;
+    std::memcpy(staging.samples, interleaved, count * 2 * sizeof(float));
+    if (file && queue.try_push(staging)) return true;
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void WavFileSink::run() {
+    Block block;
+    while (true) {
+        bool idle = true;
+        while (queue.try_pop(block)) {
+            store(block);
+            idle = false;
+        }
+        if (!idle) continue;
+        if (closing.load(std::memory_order_acquire)) {
+            // Blocks pushed before close() are visible now
+            while (queue.try_pop(block)) store(block);
+            return;
+        }
+        std::this_thread::sleep_for(WRITER_IDLE);
+    }
+}
+
+void WavFileSink::store(const Block& block) {
+    int16_t pcm[MAX_BLOCK_FRAMES * 2];
+    size_t n = block.frames * 2;
+    for (size_t i = 0; i < n; ++i) {
+        float x = block.samples[i];
+        if (x > 1.0f) x = 1.0f;
+        if (x < -1.0f) x = -1.0f;
+        pcm[i] = static_cast<int16_t>(x * 32767.0f);
+    }
+    // Host order is little-endian on every target this builds for, like the RIFF readers assume
+    if (std::fwrite(pcm, sizeof(int16_t), n, file) == n) frames += block.frames;
+}
+
+void WavFileSink::close() {
+    if (!file) return;
+    closing.store(true, std::memory_order_release);
+    if (writer.joinable()) writer.join();
+    write_header(frames);
+    std::fclose(file);
+    file = nullptr;
+}
+
+static void put_u16(unsigned char*& p, unsigned value) {
+    *p++ = static_cast<unsigned char>(value & 0xFF);
+    *p++ = static_cast<unsigned char>((value >> 8) & 0xFF);
+}
+
+static void put_u32(unsigned char*& p, unsigned long value) {
+    put_u16(p, static_cast<unsigned>(value & 0xFFFF));
+    put_u16(p, static_cast<unsigned>((value >> 16) & 0xFFFF));
+}
+
+bool WavFileSink::write_header(size_t frame_count) {
+    unsigned char header[44];
+    unsigned char* p = header;
+    unsigned long data_bytes = static_cast<unsigned long>(frame_count * 4);
+    std::memcpy(p, "RIFF", 4); p += 4;
+    put_u32(p, 36 + data_bytes);
+    std::memcpy(p, "WAVEfmt ", 8); p += 8;
+    put_u32(p, 16);
+    put_u16(p, 1);                                  // integer PCM
+    put_u16(p, 2);                                  // stereo
+    put_u32(p, static_cast<unsigned long>(sample_rate));
+    put_u32(p, static_cast<unsigned long>(sample_rate) * 4);
+    put_u16(p, 4);                                  // block align
+    put_u16(p, 16);                                 // bits per sample
+    std::memcpy(p, "data", 4); p += 4;
+    put_u32(p, data_bytes);
+
+    if (std::fseek(file, 0, SEEK_SET) != 0) return false;
+    bool ok = std::fwrite(header, 1, sizeof(header), file) == sizeof(header);
+    return std::fseek(file, 0, SEEK_END) == 0 && ok;
+}
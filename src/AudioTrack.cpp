@@ -1,70 +1,85 @@
 #include "AudioTrack.h"
+#include "LogSink.h"
 #include <iostream>
-#include <cstring>
-#include <random>
+#include <atomic>
+
+// Process-wide counters behind get_allocation_stats() (waveform counters live in Waveform)
+static std::atomic<size_t> tracks_constructed(0);
+static std::atomic<size_t> track_copies(0);
+
+// FNV-1a: a stable per-title seed, so a track's waveform is the same whenever it is generated
+static uint64_t waveform_seed(const std::string& title) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (unsigned char c : title) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
 
-AudioTrack::AudioTrack(const std::string& title, const std::vector<std::string>& artists, 
-                      int duration, int bpm, size_t waveform_samples)
-    : title(title), artists(artists), duration_seconds(duration), bpm(bpm), 
-      waveform_data(nullptr), waveform_size(waveform_samples) {
+// ========== SHARED DATA ==========
 
-    // Allocate memory for waveform analysis
-    waveform_data = new double[waveform_size];
+AudioTrack::SharedData::SharedData(const std::string& title, const std::vector<std::string>& artists,
+                                   size_t waveform_samples)
+    : title(title), artists(artists), waveform(waveform_samples, waveform_seed(title)) {}
 
-    // Generate some dummy waveform data for testing
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+// Copy for copy-on-write; the waveform storage is detached by its mutable_data()
+AudioTrack::SharedData::SharedData(const SharedData& other)
+    : title(other.title), artists(other.artists), waveform(other.waveform) {}
 
-    for (size_t i = 0; i < waveform_size; ++i) {
-        waveform_data[i] = dis(gen);
-    }
+AudioTrack::SharedData::~SharedData() {}
+
+std::shared_ptr<AudioTrack::SharedData> AudioTrack::empty_shared() {
+    // One empty block for every moved-from track, so moves never allocate
+    static std::shared_ptr<SharedData> empty(new SharedData("", std::vector<std::string>(), 0));
+    return empty;
+}
+
+// ========== CONSTRUCTION ==========
+
+AudioTrack::AudioTrack(const std::string& title, const std::vector<std::string>& artists, 
+                      int duration, int bpm, size_t waveform_samples)
+    : shared(std::allocate_shared<SharedData>(SlabAllocator<SharedData>(), title, artists, waveform_samples)),
+      duration_seconds(duration), bpm(bpm), key(-1), energy(0), beat_grid() {
+
+    tracks_constructed++;
     #ifdef DEBUG
-    std::cout << "AudioTrack created: " << title << " by " << std::endl;
+    LogSink::out() << "AudioTrack created: " << title << " by " << std::endl;
     for (const auto& artist : artists) {
-        std::cout << artist << " ";
+        LogSink::out() << artist << " ";
     }
-    std::cout << std::endl;
+    LogSink::out() << std::endl;
     #endif
 }
 
-// ========== TODO: STUDENTS IMPLEMENT RULE OF 5 ==========
+// ========== RULE OF 5 ==========
 
 // Destructor
 AudioTrack::~AudioTrack() {
     #ifdef DEBUG
-    std::cout << "AudioTrack destructor called for: " << title << std::endl;
+    std::cout << "AudioTrack destructor called for: " << get_title() << std::endl;
     #endif
 
-    // Reset the WaveForm Data
-    delete[] waveform_data;
-    waveform_data = nullptr;
-    waveform_size = 0;
+    // The shared_ptr frees the waveform once the last copy is gone
 }
 
 // Copy Constructor
 AudioTrack::AudioTrack(const AudioTrack& other)
-    : title(other.title), artists(other.artists), 
-      duration_seconds(other.duration_seconds), bpm(other.bpm),
-      waveform_data(nullptr), waveform_size(other.waveform_size)
+    : shared(other.shared),
+      duration_seconds(other.duration_seconds), bpm(other.bpm), key(other.key), energy(other.energy),
+      beat_grid(other.beat_grid)
 {
     #ifdef DEBUG
-    std::cout << "AudioTrack copy constructor called for: " << other.title << std::endl;
+    std::cout << "AudioTrack copy constructor called for: " << other.get_title() << std::endl;
     #endif
 
-    // Deep copy waveform_data
-    if (waveform_size > 0) {
-        waveform_data = new double[waveform_size];
-        for (size_t i = 0; i < waveform_size; i++) {
-            waveform_data[i] = other.waveform_data[i];
-        }
-    }
+    track_copies++;
 }
 
 // Copy Assigment Operator
 AudioTrack& AudioTrack::operator=(const AudioTrack& other) {    
     #ifdef DEBUG
-    std::cout << "AudioTrack copy assignment called for: " << other.title << std::endl;
+    std::cout << "AudioTrack copy assignment called for: " << other.get_title() << std::endl;
     #endif
 
     // Self Assignment Guard
@@ -72,22 +87,14 @@ AudioTrack& AudioTrack::operator=(const AudioTrack& other) {
         return *this;
     }
 
-    // Delete the old data
-    delete[] waveform_data;
-    waveform_data = nullptr;
-
-    // Copy all of the data
-    this->title = other.title;
-    this->artists = other.artists;
+    // Share the immutable data, copy the per-instance fields
+    this->shared = other.shared;
     this->duration_seconds = other.duration_seconds;
     this->bpm = other.bpm;
-    this->waveform_size = other.waveform_size;
-
-    // Deep copy waveform_data
-    this->waveform_data = new double[this->waveform_size];
-    for (size_t i = 0; i < this->waveform_size; i++)  {
-        this->waveform_data[i] = other.waveform_data[i];
-    }
+    this->key = other.key;
+    this->energy = other.energy;
+    this->beat_grid = other.beat_grid;
+    track_copies++;
 
     // Return this
     return *this;
@@ -95,23 +102,22 @@ AudioTrack& AudioTrack::operator=(const AudioTrack& other) {
 
 // Move Constructor
 AudioTrack::AudioTrack(AudioTrack&& other) noexcept
-    : title(std::move(other.title)), artists(std::move(other.artists)),
-      duration_seconds(other.duration_seconds), bpm(other.bpm),
-      waveform_data(other.waveform_data), waveform_size(other.waveform_size)
+    : shared(std::move(other.shared)),
+      duration_seconds(other.duration_seconds), bpm(other.bpm), key(other.key), energy(other.energy),
+      beat_grid(std::move(other.beat_grid))
 {
     #ifdef DEBUG
-    std::cout << "AudioTrack move constructor called for: " << other.title << std::endl;
+    std::cout << "AudioTrack move constructor called for: " << get_title() << std::endl;
     #endif
 
-    // Reset other's data
-    other.waveform_data = nullptr;
-    other.waveform_size = 0;
+    // Leave other as a valid, empty track
+    other.shared = empty_shared();
 }
 
 // Move Assigment Operator
 AudioTrack& AudioTrack::operator=(AudioTrack&& other) noexcept {
     #ifdef DEBUG
-    std::cout << "AudioTrack move assignment called for: " << other.title << std::endl;
+    std::cout << "AudioTrack move assignment called for: " << other.get_title() << std::endl;
     #endif
 
     // Self Assignment Guard
@@ -119,31 +125,81 @@ AudioTrack& AudioTrack::operator=(AudioTrack&& other) noexcept {
         return *this;
     }
 
-    // Reset the WaveForm Data
-    delete[] waveform_data;
-    waveform_data = nullptr;
-    waveform_size = 0; //?
-
-    // Move all of the data
-    this->title = std::move(other.title);
-    this->artists = std::move(other.artists);
-    this->duration_seconds = std::move(other.duration_seconds);
-    this->bpm = std::move(other.bpm);
-    this->waveform_size = std::move(other.waveform_size);
-
-    // Steal the pointer from Other
-    this->waveform_data = other.waveform_data;
+    // Steal the shared data from Other
+    this->shared = std::move(other.shared);
+    this->duration_seconds = other.duration_seconds;
+    this->bpm = other.bpm;
+    this->key = other.key;
+    this->energy = other.energy;
+    this->beat_grid = std::move(other.beat_grid);
 
-    // Delete Data from Other
-    other.waveform_data = nullptr;
-    other.waveform_size = 0;
+    // Leave other as a valid, empty track
+    other.shared = empty_shared();
 
     // Return this
     return *this;
 }
 
+double* AudioTrack::mutable_waveform() {
+    if (shared.use_count() > 1) {
+        shared = std::allocate_shared<SharedData>(SlabAllocator<SharedData>(), *shared);
+    }
+    return shared->waveform.mutable_data();
+}
+
 void AudioTrack::get_waveform_copy(double* buffer, size_t buffer_size) const {
-    if (buffer && waveform_data && buffer_size <= waveform_size) {
-        std::memcpy(buffer, waveform_data, buffer_size * sizeof(double));
+    if (buffer && buffer_size > 0 && buffer_size <= shared->waveform.size()) {
+        WaveformSamples samples = shared->waveform.acquire();
+        samples.copy_to(buffer, buffer_size);
+    }
+}
+
+size_t AudioTrack::get_memory_footprint() const {
+    size_t bytes = sizeof(AudioTrack) + sizeof(SharedData) + shared->title.capacity();
+    bytes += shared->artists.capacity() * sizeof(std::string);
+    for (const auto& artist : shared->artists) {
+        bytes += artist.capacity();
     }
-}
\ No newline at end of file
+    bytes += shared->waveform.storage_bytes();   // as when materialized
+    return bytes;
+}
+
+TrackAllocationStats AudioTrack::get_allocation_stats() {
+    TrackAllocationStats stats;
+    stats.tracks_constructed = tracks_constructed;
+    stats.track_copies = track_copies;
+    WaveformStats waveform = Waveform::get_stats();
+    stats.waveform_allocations = waveform.allocations;
+    stats.waveform_bytes_allocated = waveform.bytes_allocated;
+    stats.waveform_bytes_copied = waveform.bytes_copied;
+    stats.waveform_releases = waveform.releases;
+    BlockPoolStats pools = BlockPool::get_total_stats();
+    stats.pool_allocations = pools.allocations;
+    stats.heap_allocations = pools.slabs + BufferSlabs::heap_allocations();
+    return stats;
+}
+
+TrackAllocationStats TrackAllocationStats::operator-(const TrackAllocationStats& earlier) const {
+    TrackAllocationStats delta;
+    delta.tracks_constructed = tracks_constructed - earlier.tracks_constructed;
+    delta.track_copies = track_copies - earlier.track_copies;
+    delta.waveform_allocations = waveform_allocations - earlier.waveform_allocations;
+    delta.waveform_bytes_allocated = waveform_bytes_allocated - earlier.waveform_bytes_allocated;
+    delta.waveform_bytes_copied = waveform_bytes_copied - earlier.waveform_bytes_copied;
+    delta.waveform_releases = waveform_releases - earlier.waveform_releases;
+    delta.pool_allocations = pool_allocations - earlier.pool_allocations;
+    delta.heap_allocations = heap_allocations - earlier.heap_allocations;
+    return delta;
+}
+
+TrackAllocationStats& TrackAllocationStats::operator+=(const TrackAllocationStats& other) {
+    tracks_constructed += other.tracks_constructed;
+    track_copies += other.track_copies;
+    waveform_allocations += other.waveform_allocations;
+    waveform_bytes_allocated += other.waveform_bytes_allocated;
+    waveform_bytes_copied += other.waveform_bytes_copied;
+    waveform_releases += other.waveform_releases;
+    pool_allocations += other.pool_allocations;
+    heap_allocations += other.heap_allocations;
+    return *this;
+}
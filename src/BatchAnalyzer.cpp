@@ -0,0 +1,199 @@
+#include "BatchAnalyzer.h"
+#include "LogSink.h"
+#include "MP3Track.h"
+#include "WAVTrack.h"
+#include "WorkStealingPool.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+static const char SIDECAR_MAGIC[4] = {'D', 'J', 'B', 'A'};
+static const uint8_t FLAG_MEASURED = 1;     // grid detected from audio
+
+static double elapsed_seconds(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+}
+
+BatchAnalyzer::BatchAnalyzer(size_t threads) : threads(threads) {
+    if (this->threads == 0) this->threads = std::thread::hardware_concurrency();
+    if (this->threads == 0) this->threads = 1;
+}
+
+BatchTrackResult BatchAnalyzer::analyze_track(AudioTrack& track) {
+    BatchTrackResult result;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    track.load();
+    track.analyze_beatgrid();
+    result.quality = track.get_quality_score();
+    result.analysis_ms = elapsed_seconds(start) * 1e3;
+
+    result.title = track.get_title();
+    if (dynamic_cast<MP3Track*>(&track)) result.type = "MP3";
+    else if (dynamic_cast<WAVTrack*>(&track)) result.type = "WAV";
+    result.bpm = track.get_bpm();
+    if (track.get_beat_grid()) result.grid = *track.get_beat_grid();
+    return result;
+}
+
+BatchReport BatchAnalyzer::run(const std::vector<AudioTrack*>& tracks, std::ostream* progress) const {
+    BatchReport report;
+    report.threads = threads;
+    report.results.resize(tracks.size());
+    if (tracks.empty()) return report;
+
+    std::atomic<size_t> done(0);
+    std::mutex progress_lock;
+    size_t reported_step = 0;       // tenths of the library already announced
+    const size_t total = tracks.size();
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    WorkStealingPool pool(threads);
+    for (size_t i = 0; i < total; ++i) {
+        pool.submit([&, i] {
+            std::ostringstream discard;
+            LogSink::Capture quiet(discard);
+            if (tracks[i]) report.results[i] = analyze_track(*tracks[i]);
+
+            size_t finished = ++done;
+            if (!progress) return;
+            std::lock_guard<std::mutex> guard(progress_lock);
+            size_t step = finished * 10 / total;
+            if (step > reported_step) {
+                reported_step = step;
+                *progress << "[Batch] " << finished << "/" << total << " tracks analyzed (" << finished * 100 / total
+                          << "%, " << static_cast<long>(elapsed_seconds(start) * 1e3) << " ms)" << std::endl;
+            }
+        });
+    }
+    pool.wait();
+    report.wall_seconds = elapsed_seconds(start);
+    report.steals = pool.steal_count();
+    for (const BatchTrackResult& result : report.results) report.track_seconds += result.analysis_ms / 1e3;
+    return report;
+}
+
+// ========== SIDECAR FILE ==========
+
+static void put_u16(std::string& out, uint16_t value) {
+    out.push_back(static_cast<char>(value & 0xFF));
+    out.push_back(static_cast<char>(value >> 8));
+}
+
+static void put_u32(std::string& out, uint32_t value) {
+    put_u16(out, static_cast<uint16_t>(value & 0xFFFF));
+    put_u16(out, static_cast<uint16_t>(value >> 16));
+}
+
+static void put_f32(std::string& out, double value) {
+    float f = static_cast<float>(value);
+    uint32_t bits;
+    std::memcpy(&bits, &f, 4);
+    put_u32(out, bits);
+}
+
+static uint16_t get_u16(const unsigned char* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const unsigned char* p) {
+    return get_u16(p) | (static_cast<uint32_t>(get_u16(p + 2)) << 16);
+}
+
+static double get_f32(const unsigned char* p) {
+    uint32_t bits = get_u32(p);
+    float f;
+    std::memcpy(&f, &bits, 4);
+    return f;
+}
+
+static uint16_t clamp_u16(double value) {
+    if (value < 0.0) return 0;
+    if (value > 65535.0) return 65535;
+    return static_cast<uint16_t>(value + 0.5);
+}
+
+/**
+ * Record layout (32 bytes):
+ *   u32 title offset   u16 title length   u8 type (0 unknown, 1 MP3, 2 WAV)   u8 flags (1 = measured grid)
+ *   u16 bpm            u16 quality x 100  f32 grid bpm   f32 first beat (s)   u32 beat count
+ *   f32 confidence     u32 analysis time (us)
+ */
+bool BatchAnalyzer::write_sidecar(const std::string& path, const std::vector<BatchTrackResult>& results) {
+    std::string records;
+    std::string titles;
+    records.reserve(results.size() * RECORD_BYTES);
+    for (const BatchTrackResult& r : results) {
+        size_t length = r.title.size() < 0xFFFF ? r.title.size() : 0xFFFF;
+        put_u32(records, static_cast<uint32_t>(titles.size()));
+        put_u16(records, static_cast<uint16_t>(length));
+        records.push_back(static_cast<char>(r.type == "MP3" ? 1 : r.type == "WAV" ? 2 : 0));
+        records.push_back(static_cast<char>(r.grid.valid() ? FLAG_MEASURED : 0));
+        put_u16(records, clamp_u16(r.bpm));
+        put_u16(records, clamp_u16(r.quality * 100.0));
+        put_f32(records, r.grid.bpm);
+        put_f32(records, r.grid.first_beat);
+        put_u32(records, static_cast<uint32_t>(r.grid.beat_count));
+        put_f32(records, r.grid.confidence);
+        put_u32(records, static_cast<uint32_t>(r.analysis_ms * 1e3 + 0.5));
+        titles.append(r.title, 0, length);
+    }
+
+    std::string header(SIDECAR_MAGIC, 4);
+    put_u16(header, SIDECAR_VERSION);
+    put_u16(header, RECORD_BYTES);
+    put_u32(header, static_cast<uint32_t>(results.size()));
+    put_u32(header, static_cast<uint32_t>(titles.size()));
+
+    std::string temp_path = path + ".tmp";
+    std::ofstream out(temp_path.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+    out << header << records << titles;
+    out.close();
+    if (!out || std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool BatchAnalyzer::read_sidecar(const std::string& path, std::vector<BatchTrackResult>& results) {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in.is_open()) return false;
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(bytes.data());
+    if (bytes.size() < 16 || std::memcmp(p, SIDECAR_MAGIC, 4) != 0) return false;
+    if (get_u16(p + 4) != SIDECAR_VERSION || get_u16(p + 6) != RECORD_BYTES) return false;
+    size_t count = get_u32(p + 8);
+    size_t title_bytes = get_u32(p + 12);
+    if (bytes.size() != 16 + count * RECORD_BYTES + title_bytes) return false;
+
+    const unsigned char* titles = p + 16 + count * RECORD_BYTES;
+    results.clear();
+    results.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned char* record = p + 16 + i * RECORD_BYTES;
+        size_t offset = get_u32(record);
+        size_t length = get_u16(record + 4);
+        if (offset + length > title_bytes) return false;
+
+        BatchTrackResult r;
+        r.title.assign(reinterpret_cast<const char*>(titles + offset), length);
+        r.type = record[6] == 1 ? "MP3" : record[6] == 2 ? "WAV" : "";
+        r.bpm = get_u16(record + 8);
+        r.quality = get_u16(record + 10) / 100.0;
+        if (record[7] & FLAG_MEASURED) {
+            r.grid.bpm = get_f32(record + 12);
+            r.grid.first_beat = get_f32(record + 16);
+            r.grid.beat_count = get_u32(record + 20);
+            r.grid.confidence = get_f32(record + 24);
+        }
+        r.analysis_ms = get_u32(record + 28) / 1e3;
+        results.push_back(r);
+    }
+    return true;
+}
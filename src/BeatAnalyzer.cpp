@@ -0,0 +1,269 @@
+#include "BeatAnalyzer.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+static const double MIN_CONFIDENCE = 0.1;   // weaker periodicity is treated as "no steady tempo"
+static const double TEMPO_CENTER = 120.0;   // prior for octave ambiguity (BPM)
+static const double TEMPO_SPREAD = 1.0;     // prior width in octaves
+static const double HALF_PERIOD_RATIO = 0.9; // share of the peak half the period must reach to win
+static const size_t DECODE_HOPS = 64;       // hops decoded per block from a PcmView
+
+// ========== SCALAR ==========
+
+double BeatAnalyzer::sum_squares_scalar(const float* in, size_t n) {
+    double s = 0.0;
+    for (size_t i = 0; i < n; ++i) s += static_cast<double>(in[i]) * in[i];
+    return s;
+}
+
+double BeatAnalyzer::dot_scalar(const float* a, const float* b, size_t n) {
+    double s = 0.0;
+    for (size_t i = 0; i < n; ++i) s += static_cast<double>(a[i]) * b[i];
+    return s;
+}
+
+void BeatAnalyzer::downmix_scalar(const float* interleaved, size_t frames, int channels, float* mono) {
+    const float scale = 1.0f / channels;
+    for (size_t f = 0; f < frames; ++f, interleaved += channels) {
+        float s = 0.0f;
+        for (int c = 0; c < channels; ++c) s += interleaved[c];
+        mono[f] = s * scale;
+    }
+}
+
+// ========== SSE2 ==========
+
+#ifdef __SSE2__
+
+bool BeatAnalyzer::vectorized_build() { return true; }
+
+static float horizontal_sum(__m128 v) {
+    float lanes[4];
+    _mm_storeu_ps(lanes, v);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+double BeatAnalyzer::sum_squares(const float* in, size_t n) {
+    // Two accumulators so consecutive adds do not wait on each other
+    __m128 s0 = _mm_setzero_ps();
+    __m128 s1 = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128 a = _mm_loadu_ps(in + i);
+        __m128 b = _mm_loadu_ps(in + i + 4);
+        s0 = _mm_add_ps(s0, _mm_mul_ps(a, a));
+        s1 = _mm_add_ps(s1, _mm_mul_ps(b, b));
+    }
+    return horizontal_sum(_mm_add_ps(s0, s1)) + sum_squares_scalar(in + i, n - i);
+}
+
+double BeatAnalyzer::dot(const float* a, const float* b, size_t n) {
+    __m128 s0 = _mm_setzero_ps();
+    __m128 s1 = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        s0 = _mm_add_ps(s0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        s1 = _mm_add_ps(s1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    return horizontal_sum(_mm_add_ps(s0, s1)) + dot_scalar(a + i, b + i, n - i);
+}
+
+void BeatAnalyzer::downmix(const float* interleaved, size_t frames, int channels, float* mono) {
+    if (channels != 2) {
+        downmix_scalar(interleaved, frames, channels, mono);
+        return;
+    }
+    const __m128 half = _mm_set1_ps(0.5f);
+    size_t f = 0;
+    for (; f + 4 <= frames; f += 4) {
+        __m128 a = _mm_loadu_ps(interleaved + 2 * f);         // L0 R0 L1 R1
+        __m128 b = _mm_loadu_ps(interleaved + 2 * f + 4);     // L2 R2 L3 R3
+        __m128 left = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 right = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm_storeu_ps(mono + f, _mm_mul_ps(_mm_add_ps(left, right), half));
+    }
+    downmix_scalar(interleaved + 2 * f, frames - f, 2, mono + f);
+}
+
+#else
+
+bool BeatAnalyzer::vectorized_build() { return false; }
+
+double BeatAnalyzer::sum_squares(const float* in, size_t n) { return sum_squares_scalar(in, n); }
+double BeatAnalyzer::dot(const float* a, const float* b, size_t n) { return dot_scalar(a, b, n); }
+void BeatAnalyzer::downmix(const float* interleaved, size_t frames, int channels, float* mono) {
+    downmix_scalar(interleaved, frames, channels, mono);
+}
+
+#endif
+
+// ========== ANALYSIS ==========
+
+size_t BeatAnalyzer::hop_size(int sample_rate) {
+    size_t hop = static_cast<size_t>(sample_rate > 0 ? sample_rate : 0) / HOPS_PER_SECOND;
+    return hop > 0 ? hop : 1;
+}
+
+BeatGrid BeatAnalyzer::analyze(const float* mono, size_t n, int sample_rate) const {
+    size_t hop = hop_size(sample_rate);
+    std::vector<float> energies;
+    energies.reserve(n / hop);
+    add_energies(mono, n, hop, energies);
+    return grid_from_energies(energies, sample_rate, hop);
+}
+
+BeatGrid BeatAnalyzer::analyze(const PcmView& pcm, int sample_rate) const {
+    if (pcm.frames == 0 || pcm.channels <= 0) return BeatGrid();
+    size_t hop = hop_size(sample_rate);
+    size_t block = hop * DECODE_HOPS;
+    std::vector<float> interleaved(block * static_cast<size_t>(pcm.channels));
+    std::vector<float> mono(block);
+    std::vector<float> energies;
+    energies.reserve(pcm.frames / hop);
+
+    for (size_t first = 0; first < pcm.frames; first += block) {
+        size_t got = pcm.decode(first, block, interleaved.data());
+        if (use_simd) downmix(interleaved.data(), got, pcm.channels, mono.data());
+        else downmix_scalar(interleaved.data(), got, pcm.channels, mono.data());
+        add_energies(mono.data(), got, hop, energies);
+    }
+    return grid_from_energies(energies, sample_rate, hop);
+}
+
+void BeatAnalyzer::add_energies(const float* mono, size_t n, size_t hop, std::vector<float>& energies) const {
+    // A trailing partial hop is dropped; blocks are whole hops except the last
+    for (size_t i = 0; i + hop <= n; i += hop) {
+        double e = use_simd ? sum_squares(mono + i, hop) : sum_squares_scalar(mono + i, hop);
+        energies.push_back(static_cast<float>(e / hop));
+    }
+}
+
+BeatGrid BeatAnalyzer::grid_from_energies(const std::vector<float>& energies, int sample_rate, size_t hop) const {
+    BeatGrid grid;
+    const size_t frames = energies.size();
+    const double fps = static_cast<double>(sample_rate) / hop;
+    const size_t min_lag = static_cast<size_t>(std::floor(60.0 * fps / MAX_BPM));
+    const size_t max_lag = static_cast<size_t>(std::ceil(60.0 * fps / MIN_BPM));
+    if (min_lag < 2 || frames < 4 * max_lag) return grid;
+
+    // Onset strength: rise in log energy from one hop to the next
+    std::vector<float> flux(frames, 0.0f);
+    double previous = std::log(energies[0] + 1e-10);
+    for (size_t k = 1; k < frames; ++k) {
+        double level = std::log(energies[k] + 1e-10);
+        flux[k] = level > previous ? static_cast<float>(level - previous) : 0.0f;
+        previous = level;
+    }
+
+    // Remove the local mean (about one second) so loudness swells do not count as beats
+    std::vector<float> onset(frames, 0.0f);
+    const size_t radius = static_cast<size_t>(fps / 2);
+    double window_sum = 0.0;
+    size_t lo = 0, hi = 0;
+    for (size_t k = 0; k < frames; ++k) {
+        size_t want_hi = std::min(frames, k + radius + 1);
+        size_t want_lo = k > radius ? k - radius : 0;
+        for (; hi < want_hi; ++hi) window_sum += flux[hi];
+        for (; lo < want_lo; ++lo) window_sum -= flux[lo];
+        float d = static_cast<float>(flux[k] - window_sum / (hi - lo));
+        onset[k] = d > 0.0f ? d : 0.0f;
+    }
+
+    // Autocorrelate the zero-mean envelope, so steady noise correlates with nothing
+    double mean = 0.0;
+    for (size_t k = 0; k < frames; ++k) mean += onset[k];
+    mean /= frames;
+    std::vector<float> centered(frames);
+    for (size_t k = 0; k < frames; ++k) centered[k] = static_cast<float>(onset[k] - mean);
+
+    // Over the tempo range, plus one lag either side for refinement
+    const float* o = centered.data();
+    double r0 = (use_simd ? dot(o, o, frames) : dot_scalar(o, o, frames)) / frames;
+    if (r0 <= 0.0) return grid;
+    std::vector<double> r(max_lag + 2, 0.0);
+    for (size_t lag = min_lag - 1; lag <= max_lag + 1; ++lag) r[lag] = correlation(o, frames, lag);
+
+    size_t best = 0;
+    double best_score = 0.0;
+    for (size_t lag = min_lag; lag <= max_lag; ++lag) {
+        double octaves = std::log2(60.0 * fps / lag / TEMPO_CENTER) / TEMPO_SPREAD;
+        double score = r[lag] * std::exp(-0.5 * octaves * octaves);
+        if (score > best_score) {
+            best_score = score;
+            best = lag;
+        }
+    }
+    if (best == 0) return grid;
+
+    // A beat on every pulse correlates as well at twice the period; prefer the faster tempo then.
+    // Peaks are compared with their neighbours, as a fractional period spreads over two lags.
+    size_t half = (best + 1) / 2;
+    if (half >= min_lag) {
+        if (half - 1 >= min_lag && r[half - 1] > r[half]) --half;
+        double half_mass = r[half - 1] + r[half] + r[half + 1];
+        double best_mass = r[best - 1] + r[best] + r[best + 1];
+        if (half_mass >= HALF_PERIOD_RATIO * best_mass) best = half;
+    }
+    double confidence = r[best] / r0;
+    if (confidence < MIN_CONFIDENCE) return grid;
+
+    double period = best + parabolic_offset(r[best - 1], r[best], r[best + 1]);
+
+    // Refine against peaks at multiples of the period: an error of e frames per beat
+    // shows up as k * e at the k-th multiple, where the lag grid is just as fine
+    for (size_t multiple = 2; ; multiple *= 2) {
+        double centre = period * multiple;
+        size_t reach = multiple / 2 + 1;
+        if (centre + reach + 1 >= frames / 2.0) break;
+        size_t from = static_cast<size_t>(centre) - reach;
+        size_t to = static_cast<size_t>(centre) + reach;
+        size_t peak = from;
+        double peak_r = correlation(o, frames, from);
+        for (size_t lag = from + 1; lag <= to; ++lag) {
+            double value = correlation(o, frames, lag);
+            if (value > peak_r) {
+                peak_r = value;
+                peak = lag;
+            }
+        }
+        double refined = peak + parabolic_offset(correlation(o, frames, peak - 1), peak_r,
+                                                 correlation(o, frames, peak + 1));
+        period = refined / multiple;
+    }
+
+    // Phase: the offset whose comb of beats collects the most onset strength
+    size_t best_phase = 0;
+    double best_sum = -1.0;
+    for (size_t phase = 0; phase < static_cast<size_t>(period); ++phase) {
+        double sum = 0.0;
+        for (double t = static_cast<double>(phase); t < frames; t += period) {
+            sum += onset[static_cast<size_t>(t + 0.5) < frames ? static_cast<size_t>(t + 0.5) : frames - 1];
+        }
+        if (sum > best_sum) {
+            best_sum = sum;
+            best_phase = phase;
+        }
+    }
+
+    grid.bpm = 60.0 * fps / period;
+    grid.first_beat = best_phase / fps;
+    grid.beat_count = static_cast<size_t>((frames - 1 - best_phase) / period) + 1;
+    grid.confidence = std::min(1.0, confidence);
+    return grid;
+}
+
+double BeatAnalyzer::correlation(const float* envelope, size_t frames, size_t lag) const {
+    size_t n = frames - lag;
+    return (use_simd ? dot(envelope, envelope + lag, n) : dot_scalar(envelope, envelope + lag, n)) / n;
+}
+
+// Vertex of the parabola through three equally spaced points, relative to the middle one
+double BeatAnalyzer::parabolic_offset(double left, double middle, double right) {
+    double curvature = left - 2.0 * middle + right;
+    double shift = curvature < 0.0 ? 0.5 * (left - right) / curvature : 0.0;
+    return std::max(-0.5, std::min(0.5, shift));
+}
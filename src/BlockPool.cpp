@@ -0,0 +1,78 @@
+#include "BlockPool.h"
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+// Process-wide counters behind get_total_stats()
+static std::atomic<size_t> total_allocations(0);
+static std::atomic<size_t> total_releases(0);
+static std::atomic<size_t> total_slabs(0);
+static std::atomic<size_t> total_bytes_reserved(0);
+
+static size_t aligned_block_size(size_t size) {
+    const size_t align = alignof(std::max_align_t);
+    if (size < sizeof(void*)) size = sizeof(void*);
+    return (size + align - 1) / align * align;
+}
+
+BlockPool::BlockPool(size_t block_size, size_t blocks_per_slab)
+    : lock(), block_size(aligned_block_size(block_size)),
+      blocks_per_slab(blocks_per_slab > 0 ? blocks_per_slab : 1),
+      free_list(nullptr), slabs(), stats() {}
+
+BlockPool::~BlockPool() {
+    for (char* slab : slabs) {
+        ::operator delete(slab);
+    }
+}
+
+void* BlockPool::allocate() {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!free_list) grow();
+    FreeBlock* block = free_list;
+    free_list = block->next;
+    stats.allocations++;
+    total_allocations++;
+    return block;
+}
+
+void BlockPool::deallocate(void* block) {
+    if (!block) return;
+    std::lock_guard<std::mutex> guard(lock);
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = free_list;
+    free_list = freed;
+    stats.releases++;
+    total_releases++;
+}
+
+BlockPoolStats BlockPool::get_stats() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return stats;
+}
+
+BlockPoolStats BlockPool::get_total_stats() {
+    BlockPoolStats total;
+    total.allocations = total_allocations;
+    total.releases = total_releases;
+    total.slabs = total_slabs;
+    total.bytes_reserved = total_bytes_reserved;
+    return total;
+}
+
+// Called with the lock held: thread a new slab onto the free list in address order
+void BlockPool::grow() {
+    size_t bytes = block_size * blocks_per_slab;
+    slabs.push_back(nullptr);   // grow the list first so a throwing push_back cannot leak the slab
+    char* slab = static_cast<char*>(::operator new(bytes));
+    slabs.back() = slab;
+    for (size_t i = blocks_per_slab; i > 0; --i) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + (i - 1) * block_size);
+        block->next = free_list;
+        free_list = block;
+    }
+    stats.slabs++;
+    stats.bytes_reserved += bytes;
+    total_slabs++;
+    total_bytes_reserved += bytes;
+}
@@ -0,0 +1,59 @@
+#include "CachePolicy.h"
+#include "ARCPolicy.h"
+#include "TinyLFUPolicy.h"
+#include <algorithm>
+#include <cctype>
+
+// ========== LRUPolicy ==========
+
+void LRUPolicy::reset(size_t capacity) {
+    (void)capacity;
+    recency.reset();
+}
+
+void LRUPolicy::on_hit(std::vector<CacheSlot>& slots, size_t slot) {
+    recency.move_to_front(slots, slot);
+}
+
+size_t LRUPolicy::select_victim(std::vector<CacheSlot>& slots) {
+    (void)slots;
+    return recency.back();
+}
+
+void LRUPolicy::on_evict(std::vector<CacheSlot>& slots, size_t slot) {
+    recency.unlink(slots, slot);
+}
+
+void LRUPolicy::on_insert(std::vector<CacheSlot>& slots, size_t slot) {
+    recency.push_front(slots, slot);
+}
+
+PointerWrapper<CachePolicy> LRUPolicy::create_empty() const {
+    return PointerWrapper<CachePolicy>(new LRUPolicy());
+}
+
+// ========== Factory ==========
+
+PointerWrapper<CachePolicy> make_cache_policy(const std::string& name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+
+    if (lower.empty() || lower == "lru") {
+        return PointerWrapper<CachePolicy>(new LRUPolicy());
+    }
+    if (lower == "arc") {
+        return PointerWrapper<CachePolicy>(new ARCPolicy());
+    }
+    if (lower == "tinylfu" || lower == "w-tinylfu" || lower == "wtinylfu") {
+        return PointerWrapper<CachePolicy>(new TinyLFUPolicy());
+    }
+    return PointerWrapper<CachePolicy>();
+}
+
+std::vector<std::string> cache_policy_names() {
+    std::vector<std::string> names;
+    names.push_back("lru");
+    names.push_back("arc");
+    names.push_back("tinylfu");
+    return names;
+}
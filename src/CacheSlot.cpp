@@ -2,12 +2,26 @@
 
 CacheSlot::CacheSlot() : 
     track(nullptr), 
+    key(),
     last_access_time(0), 
-    occupied(false){
+    bytes(0),
+    occupied(false),
+    prev(NO_SLOT),
+    next(NO_SLOT){
 }
 
 void CacheSlot::store(PointerWrapper<AudioTrack> track_ptr, uint64_t access_time) {
     track = std::move(track_ptr);
+    key = track->get_title();
+    bytes = track->get_memory_footprint();
+    last_access_time = access_time;
+    occupied = true;
+}
+
+void CacheSlot::reserve(const std::string& track_id, uint64_t access_time) {
+    track.reset(nullptr);
+    key = track_id;
+    bytes = 0;
     last_access_time = access_time;
     occupied = true;
 }
@@ -19,12 +33,48 @@ AudioTrack* CacheSlot::access(uint64_t access_time) {
     }
     
     last_access_time = access_time;
-    return track.get();
+    return getTrack();
 }
 
 // 
 void CacheSlot::clear() {
     track.reset(nullptr);
+    key.clear();
     occupied = false;
     last_access_time = 0;
-}
\ No newline at end of file
+    bytes = 0;
+    prev = NO_SLOT;
+    next = NO_SLOT;
+}
+
+// ========== CacheSlotList ==========
+
+void CacheSlotList::push_front(std::vector<CacheSlot>& slots, size_t index) {
+    slots[index].setPrev(CacheSlot::NO_SLOT);
+    slots[index].setNext(head);
+    if (head != CacheSlot::NO_SLOT) slots[head].setPrev(index);
+    head = index;
+    if (tail == CacheSlot::NO_SLOT) tail = index;
+    count++;
+}
+
+void CacheSlotList::unlink(std::vector<CacheSlot>& slots, size_t index) {
+    size_t p = slots[index].getPrev();
+    size_t n = slots[index].getNext();
+
+    if (p != CacheSlot::NO_SLOT) slots[p].setNext(n);
+    else head = n;
+
+    if (n != CacheSlot::NO_SLOT) slots[n].setPrev(p);
+    else tail = p;
+
+    slots[index].setPrev(CacheSlot::NO_SLOT);
+    slots[index].setNext(CacheSlot::NO_SLOT);
+    count--;
+}
+
+void CacheSlotList::move_to_front(std::vector<CacheSlot>& slots, size_t index) {
+    if (head == index) return;
+    unlink(slots, index);
+    push_front(slots, index);
+}
@@ -1,21 +1,43 @@
 #include "DJControllerService.h"
+#include "LogSink.h"
 #include "MP3Track.h"
 #include "WAVTrack.h"
 #include <iostream>
 #include <memory>
 
 DJControllerService::DJControllerService(size_t cache_size)
-    : cache(cache_size) {}
+    : cache(cache_size), shadow_caches(), policy_stats(), shadow_lock(), tracks_processed(0), prefetcher() {}
 /**
  * TODO: Implement loadTrackToCache method
  */
 int DJControllerService::loadTrackToCache(AudioTrack& track) {
-    // check if track is in cache already (HIT)
+    tracks_processed++;
+
+    // feed the same request to every shadow policy
+    {
+        std::lock_guard<std::mutex> guard(shadow_lock);
+        for (size_t i = 0; i < shadow_caches.size(); ++i) {
+            if (shadow_caches[i]->touch(track.get_title())) policy_stats[i].hits++;
+            else policy_stats[i].misses++;
+        }
+    }
 
-    if (cache.contains(track.get_title())){   
-        cache.get(track.get_title());     // if true reset the MRU 
+    // check if track is in cache already (HIT)
+    // one locked lookup: get() resets the MRU and reports the hit, so a
+    // concurrent put cannot evict the track between the check and the touch
+    if (cache.get(track.get_title()) != nullptr) {
+        prefetcher.discard(track.get_title());
         return 1;
     }
+
+    // a prefetched clone is already loaded and analyzed; print its log where the work would have run
+    std::string prefetch_log;
+    PointerWrapper<AudioTrack> prefetched = prefetcher.take(track.get_title(), prefetch_log);
+    if (prefetched) {
+        LogSink::out() << prefetch_log;
+        return cache.put(std::move(prefetched)) ? -1 : 0;
+    }
+
     // creaating a clone of the song (if MISS)
     PointerWrapper<AudioTrack> wrappedClone = track.clone();
     // unwraping the pointer to be a raw pointer (.release)
@@ -40,11 +62,57 @@ int DJControllerService::loadTrackToCache(AudioTrack& track) {
 void DJControllerService::set_cache_size(size_t new_size) {
     cache.set_capacity(new_size);
 }
+
+void DJControllerService::configure_cache(size_t new_size, size_t shard_count) {
+    cache.configure(new_size, shard_count, cache.policy_name());
+    if (!shadow_caches.empty()) enable_policy_comparison(true);
+}
+
+void DJControllerService::set_cache_byte_budget(size_t bytes) {
+    cache.set_byte_budget(bytes);
+}
+
+ControllerStats DJControllerService::get_stats() const {
+    ControllerStats stats;
+    stats.tracks_in_controller = cache.size();
+    stats.total_tracks_processed = tracks_processed;
+    stats.memory_slots_used = stats.tracks_in_controller;
+    stats.tracks_evicted = cache.eviction_count();
+    stats.memory_budget_bytes = cache.byte_budget();
+    stats.bytes_used = cache.bytes_used();
+    stats.bytes_evicted = cache.bytes_evicted();
+    return stats;
+}
+
+bool DJControllerService::set_cache_policy(const std::string& policy_name) {
+    return cache.configure(cache.capacity(), cache.shard_count(), policy_name);
+}
+
+void DJControllerService::enable_policy_comparison(bool enabled) {
+    std::lock_guard<std::mutex> guard(shadow_lock);
+    shadow_caches.clear();
+    policy_stats.clear();
+    if (!enabled) return;
+
+    for (const std::string& name : cache_policy_names()) {
+        shadow_caches.push_back(PointerWrapper<LRUCache>(new LRUCache(cache.capacity(), make_cache_policy(name))));
+        policy_stats.push_back(CachePolicyStats(name));
+    }
+}
+std::vector<CachePolicyStats> DJControllerService::get_policy_stats() const {
+    std::lock_guard<std::mutex> guard(shadow_lock);
+    return policy_stats;
+}
 //implemented
 void DJControllerService::displayCacheStatus() const {
-    std::cout << "\n=== Cache Status ===" << std::endl;
+    LogSink::out() << "\n=== Cache Status ===" << std::endl;
     cache.displayStatus();
-    std::cout << "====================" << std::endl;
+    LogSink::out() << "====================" << std::endl;
+}
+
+void DJControllerService::prefetchTrack(const AudioTrack& track) {
+    if (!prefetcher.enabled() || cache.contains(track.get_title())) return;
+    prefetcher.request(track);
 }
 
 /**
@@ -1,15 +1,42 @@
 #include "DJLibraryService.h"
+#include "AnalysisCache.h"
 #include "SessionFileParser.h"
 #include "MP3Track.h"
 #include "WAVTrack.h"
+#include "LogSink.h"
+#include "ThreadPool.h"
 #include <iostream>
 #include <memory>
 #include <filesystem>
 #include <algorithm>
+#include <sstream>
 
 
 DJLibraryService::DJLibraryService(const Playlist& playlist) 
-    : playlist(playlist), library() {}
+    : playlist(playlist), library(), index(), harmonic() {}
+
+DJLibraryService::DJLibraryService(Playlist&& playlist) 
+    : playlist(std::move(playlist)), library(), index(), harmonic() {}
+
+DJLibraryService::DJLibraryService(DJLibraryService&& other) noexcept
+    : playlist(std::move(other.playlist)), library(std::move(other.library)), index(std::move(other.index)),
+      harmonic(std::move(other.harmonic)) {
+    other.library.clear();
+    other.index.clear();
+    other.harmonic.clear();
+}
+
+DJLibraryService& DJLibraryService::operator=(DJLibraryService&& other) noexcept {
+    if (this != &other) {
+        // The playlist may borrow our library tracks: replace it before freeing them
+        playlist = std::move(other.playlist);
+        clearLibrary();
+        library.swap(other.library);
+        std::swap(index, other.index);
+        std::swap(harmonic, other.harmonic);
+    }
+    return *this;
+}
 /**
  * @brief Load a playlist from track indices referencing the library
  * @param library_tracks Vector of track info from config
@@ -17,50 +44,117 @@ DJLibraryService::DJLibraryService(const Playlist& playlist)
 
 //Destructor
 DJLibraryService::~DJLibraryService (){
+    // A borrowing playlist never touches its tracks on destruction
+    clearLibrary();
+}
+
+void DJLibraryService::clearLibrary() {
     // Reset library
     for (AudioTrack* curr_track: library) {
         delete curr_track;
     }
 
     library.clear();
+    index.clear();
+    harmonic.clear();
 }
 
 
 
 
 
-void DJLibraryService::buildLibrary(const std::vector<SessionConfig::TrackInfo>& library_tracks) {
-    for ( const auto& track_info : library_tracks){
+void DJLibraryService::buildLibrary(const std::vector<SessionConfig::TrackInfo>& library_tracks, size_t threads) {
+    if (threads > 1 && library_tracks.size() > 1) {
+        buildLibraryParallel(library_tracks, threads);
+    } else {
+        for ( const auto& track_info : library_tracks){
+            AudioTrack* new_track = createTrack(track_info);
+            if (new_track != nullptr){
+                library.push_back(new_track);
+            }
+        }
+    }
+    refreshIndexes();
+    std::cout << "[INFO] Track library built: " << library_tracks.size() << " tracks loaded" << std::endl;
+}
 
-        AudioTrack* new_track = nullptr;
+void DJLibraryService::refreshIndexes() {
+    index.build(library);
+    harmonic.build(library);
+}
 
-        if (track_info.type == "MP3"){
-            new_track = new MP3Track(
-                track_info.title,
-                track_info.artists,
-                track_info.duration_seconds,
-                track_info.bpm,
-                track_info.extra_param1,
-                (bool) track_info.extra_param2
-            );
-        }
+AudioTrack* DJLibraryService::createTrack(const SessionConfig::TrackInfo& track_info) {
+    AudioTrack* track = nullptr;
+    if (track_info.type == "MP3"){
+        track = new MP3Track(
+            track_info.title,
+            track_info.artists,
+            track_info.duration_seconds,
+            track_info.bpm,
+            track_info.extra_param1,
+            (bool) track_info.extra_param2,
+            track_info.file_path
+        );
+    } else if ( track_info.type == "WAV"){
+        track = new WAVTrack(
+            track_info.title,
+            track_info.artists,
+            track_info.duration_seconds,
+            track_info.bpm,
+            track_info.extra_param1,
+            track_info.extra_param2,
+            track_info.file_path
+        );
+    }
+    if (track) {
+        track->set_key(track_info.key);
+        track->set_energy(track_info.energy);
+        // Audio analyzed before starts with its measured BPM and grid, so the
+        // indexes are built from the values playback will use
+        if (!AnalysisCache::instance().empty()) track->apply_cached_beatgrid();
+    }
+    return track;
+}
 
-        else if ( track_info.type == "WAV"){
-            new_track = new WAVTrack(
-                track_info.title,
-                track_info.artists,
-                track_info.duration_seconds,
-                track_info.bpm,
-                track_info.extra_param1,
-                track_info.extra_param2
-            );
+/**
+ * Tracks are built in contiguous chunks on a thread pool. Each chunk writes
+ * its tracks into its own slots and captures its constructor output; both
+ * are then consumed in config order, so the library and the console output
+ * match the serial build exactly.
+ */
+void DJLibraryService::buildLibraryParallel(const std::vector<SessionConfig::TrackInfo>& library_tracks, size_t threads) {
+    const size_t count = library_tracks.size();
+    if (threads > count) threads = count;
+    const size_t chunks = threads * 4 < count ? threads * 4 : count;   // a few per thread to even out the load
+
+    std::vector<AudioTrack*> built(count, nullptr);
+    std::vector<std::string> logs(chunks);
+
+    try {
+        ThreadPool pool(threads);
+        for (size_t chunk = 0; chunk < chunks; ++chunk) {
+            size_t first = count * chunk / chunks;
+            size_t last = count * (chunk + 1) / chunks;
+            pool.submit([&library_tracks, &built, &logs, chunk, first, last] {
+                std::ostringstream log;
+                LogSink::Capture capture(log);
+                for (size_t i = first; i < last; ++i) {
+                    built[i] = createTrack(library_tracks[i]);
+                }
+                logs[chunk] = log.str();
+            });
         }
+        pool.wait();
+    } catch (...) {
+        for (AudioTrack* track : built) delete track;
+        throw;
+    }
 
-        if (new_track != nullptr){
-            library.push_back(new_track);
-        }
+    for (const std::string& log : logs) std::cout << log;
+    library.reserve(library.size() + count);
+    for (AudioTrack* track : built) {
+        if (track != nullptr) library.push_back(track);
     }
-    std::cout << "[INFO] Track library built: " << library_tracks.size() << " tracks loaded" << std::endl;
 }
 
 /**
@@ -108,7 +202,8 @@ void DJLibraryService::loadPlaylistFromIndices(const std::string& playlist_name,
 
     // create new Playlist with the given name
     std::cout << "[INFO] Loading playlist: " << playlist_name << std::endl;
-    this->playlist = Playlist(playlist_name);
+    this->playlist = Playlist(playlist_name, Playlist::BORROWS_TRACKS);   // move-assigned, no clones
+    playlist.reserve(track_indices.size());
     
     //  iterate over track_indices
     for (int index: track_indices) {
@@ -117,22 +212,16 @@ void DJLibraryService::loadPlaylistFromIndices(const std::string& playlist_name,
             continue;
         }
         // get track from library using 0-based indexing
-        AudioTrack* original_track = library[index -1];
-        // clone the track
-        PointerWrapper<AudioTrack> clone_track = original_track->clone();
+        AudioTrack* library_track = library[index -1];
 
-        // if clone was faild raise message
-        if (!clone_track){
-            std::cout << "[ERROR] Failed to clone track: " << original_track->get_title() << std::endl;
-            continue;
-        }
-        
-        clone_track->load();    // loading clone track
-        clone_track->analyze_beatgrid(); // beatgrid check
+        // prints the load and beatgrid check and warms the shared data
+        // (file mapping, frame index, analysis cache) that later cache and
+        // deck copies reuse, without changing the track: the library and
+        // its indexes keep the values they were built from
+        library_track->prepare();
 
-
-        // adding the unwrapped track to the playlist
-        playlist.add_track(clone_track.release());
+        // the playlist borrows the library's track
+        playlist.add_track(library_track);
 
     }
         // printing the loading message 
@@ -150,15 +239,33 @@ void DJLibraryService::loadPlaylistFromIndices(const std::string& playlist_name,
 std::vector<std::string> DJLibraryService::getTrackTitles() const {
     // new vector for track titles
     std::vector<std::string> track_titles;
+    track_titles.reserve(playlist.get_track_count());
     // itrate on playlist and 
-    for ( const auto& track_ptr : playlist.getTracks() ){
-        if (track_ptr != nullptr){   // for evrey track cheking if pointer or null 
+    for ( AudioTrack* track_ptr : playlist.getTracks() ){
+        if (track_ptr != nullptr){   // skip slots of removed tracks 
             track_titles.push_back(track_ptr->get_title());  // adding the track title to the new titles vector
         }
     }
 
-    // Reverse to get insertion order (add_track adds to front of linked list)
-    std::reverse(track_titles.begin(), track_titles.end());
-
     return track_titles;  // return vector of track titles as asked 
-}
\ No newline at end of file
+}
+
+AudioTrack* DJLibraryService::findLibraryTrack(const std::string& title) const {
+    return index.find_title(title);
+}
+
+const std::vector<AudioTrack*>& DJLibraryService::findTracksByArtist(const std::string& artist) const {
+    return index.find_artist(artist);
+}
+
+std::vector<AudioTrack*> DJLibraryService::findTracksInBpmRange(int bpm, int tolerance) const {
+    return index.find_bpm(bpm, tolerance);
+}
+
+size_t DJLibraryService::countTracksInBpmRange(int bpm, int tolerance) const {
+    return index.count_bpm(bpm, tolerance);
+}
+
+std::vector<MixCandidate> DJLibraryService::findMixCandidates(const MixQuery& query, size_t k) const {
+    return harmonic.find_compatible(query, k);
+}
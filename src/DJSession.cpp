@@ -1,10 +1,77 @@
 
 #include "DJSession.h"
+#include "AnalysisCache.h"
+#include "BatchAnalyzer.h"
+#include "BoundedQueue.h"
+#include "LogSink.h"
+#include "MP3Track.h"
+#include "PlaylistOptimizer.h"
+#include "WAVTrack.h"
+#include <iomanip>
 #include <iostream>
 #include <algorithm>
 #include <sstream>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <dirent.h>
 
+// Nearest-rank percentile of unsorted samples (0 if empty)
+static double percentile(std::vector<double> samples, double pct) {
+    if (samples.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(pct / 100.0 * samples.size() + 0.5);
+    if (rank > 0) rank--;
+    if (rank >= samples.size()) rank = samples.size() - 1;
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    return samples[rank];
+}
+
+// Set the waveform storage format for newly built tracks of one type (empty = keep f64)
+static void apply_waveform_format(const std::string& type, const std::string& name) {
+    if (name.empty()) return;
+    WaveformFormat format = WAVEFORM_F64;
+    if (!parse_waveform_format(name, format)) {
+        std::cout << "[WARNING] Unknown waveform format '" << name << "' for " << type
+                  << " tracks, using f64" << std::endl;
+    }
+    std::cout << type << " Waveform Format: " << waveform_format_name(format) << std::endl;
+    if (type == "MP3") MP3Track::set_default_waveform_format(format);
+    else WAVTrack::set_default_waveform_format(format);
+}
+
+static const size_t PIPELINE_QUEUE_DEPTH = 2;  // tracks a pipeline stage may run ahead of the next
+
+// One playlist track on its way through process_tracks_pipelined
+struct PipelineTrack {
+    size_t index;                   // position in the playlist
+    AudioTrack* library_track;      // lookup result, nullptr if not in the library
+    std::chrono::steady_clock::time_point start;   // cache load started
+
+    PipelineTrack() : index(0), library_track(nullptr), start() {}
+};
+
+// Hands the controller cache from the deck stage to the cache stage, one track at a time
+struct CacheTurn {
+    size_t next;                    // track whose cache load may start
+    std::mutex lock;
+    std::condition_variable changed;
+
+    CacheTurn() : next(0), lock(), changed() {}
+
+    void wait_for(size_t track) {
+        std::unique_lock<std::mutex> guard(lock);
+        changed.wait(guard, [this, track]() { return next >= track; });
+    }
+
+    // The deck stage is done with the cache for track
+    void pass(size_t track) {
+        std::lock_guard<std::mutex> guard(lock);
+        next = track + 1;
+        changed.notify_all();
+    }
+};
+
 // ========== CONSTRUCTORS & RULE OF 5 ==========
 
 
@@ -17,6 +84,7 @@ DJSession::DJSession(const std::string& name, bool play_all)
     session_config(),
     track_titles(),
     play_all(play_all),
+    trace_out(),
     stats()
       {
     std::cout << "DJ Session System initialized: " << session_name << std::endl;
@@ -72,19 +140,25 @@ bool DJSession::load_playlist(const std::string& playlist_name)  {
 
  */
 int DJSession::load_track_to_controller(const std::string& track_name) {
-
     // Find track in library
-    AudioTrack* trackToBeLoaded = library_service.findTrack(track_name);
+    return load_to_controller(track_name, library_service.findTrack(track_name));
+}
+
+// Cache load of a track already looked up in the library (nullptr if it is not there)
+int DJSession::load_to_controller(const std::string& track_name, AudioTrack* trackToBeLoaded) {
+
+    // Record the request for offline cache simulation
+    if (trace_out.is_open()) trace_out << track_name << '\n';
 
     // If track not found
     if (!trackToBeLoaded){
-        std::cout << "[ERROR] Track: " << track_name << " not found in library" << std::endl;
+        LogSink::out() << "[ERROR] Track: " << track_name << " not found in library" << std::endl;
         stats.errors++; // is this how to Increment stats.errors? im not sure
         return 0;       
     }
 
     // Log loading message
-    std::cout << "[System] Loading track '" << track_name << "' to controller..." << std::endl;
+    LogSink::out() << "[System] Loading track '" << track_name << "' to controller..." << std::endl;
 
     // Load track to cache and save the result
     int result = controller_service.loadTrackToCache(*trackToBeLoaded);
@@ -110,6 +184,11 @@ int DJSession::load_track_to_controller(const std::string& track_name) {
  * @return: Whether track was successfully loaded to a deck
  */
 bool DJSession::load_track_to_mixer_deck(const std::string& track_title) {
+    return load_to_mixer_deck(track_title, std::function<void()>());
+}
+
+// Deck load; cache_released (if set) runs once the cache is no longer needed for this track
+bool DJSession::load_to_mixer_deck(const std::string& track_title, const std::function<void()>& cache_released) {
     std::cout << "[System] Delegating track transfer to MixingEngineService for: " << track_title << std::endl;
 
     // Retrieve track from cache
@@ -117,13 +196,23 @@ bool DJSession::load_track_to_mixer_deck(const std::string& track_title) {
 
     // If track not in cache: 
     if (!track){
+        if (cache_released) cache_released();
         std::cout << "[ERROR] Track: " << track_title << " not found in cache" << std::endl;
         stats.errors++;
         return false;
     } 
 
     // Initalize result
-    int result = mixing_service.loadTrackToDeck(*track);
+    int result;
+    if (cache_released) {
+        // Copy the track off the cache, then let the next track's cache load run during this transition
+        PointerWrapper<AudioTrack> copy = track->clone();
+        if (!copy) std::cerr << "[ERROR] Track: \"" << track_title << "\" failed to clone" << std::endl;
+        cache_released();
+        result = mixing_service.loadTrackToDeck(std::move(copy));
+    } else {
+        result = mixing_service.loadTrackToDeck(*track);
+    }
 
     // if loadTrackToDeck failed to load the track:
     if (result == -1){
@@ -134,16 +223,61 @@ bool DJSession::load_track_to_mixer_deck(const std::string& track_title) {
 
     // Display deck status after loading !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
     mixing_service.displayDeckStatus();
+    if (session_config.mixer_suggestions > 0) suggest_next_tracks();
 
     // Counters updates
     stats.transitions++;                         // Track loaded into one of the decks - update counter
     if (result == 0 ) stats.deck_loads_a++;      // Track Loaded into deck 0 -> update the counter a
     else if (result == 1)  stats.deck_loads_b++; // Track Loaded into deck 1 -> update the counter b
+    else if (result > 1) {                       // decks beyond A and B (mixer_deck_count > 2)
+        if (stats.deck_loads_more.size() < static_cast<size_t>(result - 1)) stats.deck_loads_more.resize(result - 1);
+        stats.deck_loads_more[result - 2]++;
+    }
 
     // Track loaded -> return true
     return true;
 }
 
+/**
+ * @brief List the library tracks that mix best after the active deck's track
+ */
+void DJSession::suggest_next_tracks() {
+    const AudioTrack* playing = mixing_service.get_active_track();
+    if (!playing) return;
+
+    MixQuery query;
+    query.bpm = playing->get_bpm();
+    query.key = playing->get_key();
+    query.energy = playing->get_energy();
+    query.bpm_tolerance = mixing_service.get_bpm_tolerance();
+    query.energy_tolerance = session_config.mixer_energy_tolerance;
+    query.half_double = playing->get_beat_grid() != nullptr;
+    query.exclude = library_service.findLibraryTrack(playing->get_title());
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<MixCandidate> candidates =
+        library_service.findMixCandidates(query, static_cast<size_t>(session_config.mixer_suggestions));
+    stats.suggestion_us.push_back(
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+
+    std::cout << "[Mix Next] " << candidates.size() << " compatible tracks after '" << playing->get_title() << "' ("
+              << query.bpm << " BPM";
+    if (query.key >= 0) std::cout << ", " << HarmonicIndex::key_name(query.key);
+    if (query.energy > 0) std::cout << ", energy " << query.energy;
+    std::cout << ")" << std::endl;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        const MixCandidate& c = candidates[i];
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(2);
+        line << "  " << (i + 1) << ". " << c.track->get_title() << " - " << c.track->get_bpm() << " BPM";
+        if (c.half_double) line << " (half/double time)";
+        if (c.track->get_key() >= 0) line << ", " << HarmonicIndex::key_name(c.track->get_key());
+        if (c.track->get_energy() > 0) line << ", energy " << c.track->get_energy();
+        line << " (score " << c.score << ")";
+        std::cout << line.str() << std::endl;
+    }
+}
+
 /* 
  *
  * @brief Helper method to process a single playlist in the session.
@@ -153,7 +287,10 @@ bool DJSession::load_track_to_mixer_deck(const std::string& track_title) {
 bool DJSession::process_playlist(const std::string& playlist_name){
 
     // Initialize boolen value representing whether the load was successful or not
+    size_t copies_before = AudioTrack::get_allocation_stats().track_copies;
     bool loadFails = !load_playlist(playlist_name);
+    stats.playlist_switches++;
+    stats.playlist_clones += AudioTrack::get_allocation_stats().track_copies - copies_before;
 
     // If the load fails:
     if (loadFails) {
@@ -162,22 +299,48 @@ bool DJSession::process_playlist(const std::string& playlist_name){
         return false;
     }
 
-    // Iterate over each track in track_titles
-    for (const auto& track_title : track_titles) {
+    if (trace_out.is_open()) trace_out << "# playlist: " << playlist_name << '\n';
+
+    // Track copies and waveform work on the cache -> deck path only (not playlist loading)
+    TrackAllocationStats allocations_before = AudioTrack::get_allocation_stats();
+
+    // Iterate over each track in track_titles (stages overlapped on their own threads in pipeline mode)
+    if (session_config.session_pipeline) {
+        process_tracks_pipelined();
+    } else {
+        for (size_t i = 0; i < track_titles.size(); ++i) {
+            const std::string& track_title = track_titles[i];
+
+            // Prefetch Phase: let the controller prepare the next tracks in the background
+            prefetch_upcoming(i);
 
-        // Track Processing Phase:
-        std::cout << "\n--- Processing: " << track_title << " ---" << std::endl;
-        stats.tracks_processed++;
+            // Track Processing Phase:
+            std::cout << "\n--- Processing: " << track_title << " ---" << std::endl;
+            stats.tracks_processed++;
+            std::chrono::steady_clock::time_point transition_start = std::chrono::steady_clock::now();
 
-        // Cache Loading Phase:
-        load_track_to_controller(track_title);
+            // Cache Loading Phase:
+            load_track_to_controller(track_title);
 
-        // Deck Loading Phase:
-        bool trackFailedToLoadToDeck = !load_track_to_mixer_deck(track_title);
-        if (trackFailedToLoadToDeck) continue;
+            // Deck Loading Phase:
+            bool trackFailedToLoadToDeck = !load_track_to_mixer_deck(track_title);
+            stats.transition_us.push_back(std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - transition_start).count());
+            if (trackFailedToLoadToDeck) continue;
+        }
     }
 
+    // Unused prefetches refer to this playlist's tracks; drop them before it is replaced
+    controller_service.finish_prefetch();
+
+    stats.allocations += AudioTrack::get_allocation_stats() - allocations_before;
+
     // At the end of the playlist print session summary
+    stats.policy_stats = controller_service.get_policy_stats();
+    mixing_service.drain_rendering();   // render stats are read while the thread is idle
+    if (!AnalysisCache::instance().save()) {
+        std::cerr << "[WARNING] Cannot write analysis cache: " << AnalysisCache::instance().get_file() << std::endl;
+    }
     print_session_summary();
 
     // Reset all stats
@@ -193,6 +356,77 @@ bool DJSession::process_playlist(const std::string& playlist_name){
     return true;
 }
 
+void DJSession::prefetch_upcoming(size_t track_index) {
+    size_t prefetch_depth = controller_service.get_prefetch_depth();
+    for (size_t ahead = track_index + 1; ahead <= track_index + prefetch_depth && ahead < track_titles.size(); ++ahead) {
+        AudioTrack* upcoming = library_service.findTrack(track_titles[ahead]);
+        if (upcoming) controller_service.prefetchTrack(*upcoming);
+    }
+}
+
+/**
+ * @brief The track loop of process_playlist as three stages on their own threads
+ *
+ * Library lookup -> cache load/analysis -> deck load, connected by bounded
+ * queues. The controller cache is used in the serial order: the cache stage
+ * loads track N+1 only once the deck stage has copied track N off the
+ * cache, and then runs while track N is loaded onto its deck and
+ * transitions. The cache stage captures its output and the deck stage
+ * prints it before its own, so the log, final state and stats are those
+ * of the serial loop.
+ */
+void DJSession::process_tracks_pipelined() {
+    BoundedQueue<PipelineTrack> looked_up(PIPELINE_QUEUE_DEPTH);
+    BoundedQueue<PipelineTrack> cached(PIPELINE_QUEUE_DEPTH);
+    CacheTurn turn;
+    std::vector<std::string> logs(track_titles.size());    // cache stage output per track
+
+    std::thread lookup_stage([this, &looked_up]() {
+        for (size_t i = 0; i < track_titles.size(); ++i) {
+            PipelineTrack track;
+            track.index = i;
+            track.library_track = library_service.findTrack(track_titles[i]);
+            looked_up.push(track);
+        }
+        looked_up.close();
+    });
+
+    std::thread cache_stage([this, &looked_up, &cached, &turn, &logs]() {
+        PipelineTrack track;
+        while (looked_up.pop(track)) {
+            turn.wait_for(track.index);
+            std::ostringstream log;
+            {
+                LogSink::Capture capture(log);
+                prefetch_upcoming(track.index);
+                LogSink::out() << "\n--- Processing: " << track_titles[track.index] << " ---" << std::endl;
+                stats.tracks_processed++;
+                track.start = std::chrono::steady_clock::now();
+                load_to_controller(track_titles[track.index], track.library_track);
+            }
+            logs[track.index] = log.str();
+            cached.push(track);
+        }
+        cached.close();
+    });
+
+    std::thread deck_stage([this, &cached, &turn, &logs]() {
+        PipelineTrack track;
+        while (cached.pop(track)) {
+            std::cout << logs[track.index];
+            logs[track.index].clear();
+            size_t index = track.index;
+            load_to_mixer_deck(track_titles[index], [&turn, index]() { turn.pass(index); });
+            stats.transition_us.push_back(std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - track.start).count());
+        }
+    });
+
+    lookup_stage.join();
+    cache_stage.join();
+    deck_stage.join();
+}
+
 /**
  * @brief Main simulation loop that orchestrates the DJ performance session.
  * @note Updates session statistics (stats) throughout processing
@@ -208,7 +442,8 @@ void DJSession::simulate_dj_performance() {
     }
     
     // 2. Build track library from config
-    library_service.buildLibrary(session_config.library_tracks);
+    library_service.buildLibrary(session_config.library_tracks,
+                                 session_config.library_build_threads > 1 ? session_config.library_build_threads : 1);
     
     // 3. Get available playlists from config
     if (session_config.playlists.empty()) {
@@ -218,7 +453,9 @@ void DJSession::simulate_dj_performance() {
     std::cout << "\nStarting DJ performance simulation..." << std::endl;
     std::cout << "BPM Tolerance: " << session_config.bpm_tolerance << " BPM" << std::endl;
     std::cout << "Auto Sync: " << (session_config.auto_sync ? "enabled" : "disabled") << std::endl;
-    std::cout << "Cache Capacity: " << session_config.controller_cache_size << " slots (LRU policy)" << std::endl;
+    std::string policy_label = controller_service.get_cache_policy();
+    std::transform(policy_label.begin(), policy_label.end(), policy_label.begin(), ::toupper);
+    std::cout << "Cache Capacity: " << session_config.controller_cache_size << " slots (" << policy_label << " policy)" << std::endl;
     std::cout << "\n--- Processing Tracks ---" << std::endl;
 
     while (true) 
@@ -269,14 +506,179 @@ bool DJSession::load_configuration() {
     std::cout << "BPM Tolerance: " << session_config.bpm_tolerance << " BPM" << std::endl;
     std::cout << "Auto Sync: " << (session_config.auto_sync ? "enabled" : "disabled") << std::endl;
     std::cout << "Cache Size: " << session_config.controller_cache_size << " slots" << std::endl;
+    if (session_config.waveform_memory_budget > 0) {
+        std::cout << "Waveform Memory Budget: " << session_config.waveform_memory_budget << " bytes" << std::endl;
+        AudioTrack::set_waveform_memory_budget(session_config.waveform_memory_budget);
+    }
+    apply_waveform_format("MP3", session_config.waveform_format_mp3);
+    apply_waveform_format("WAV", session_config.waveform_format_wav);
     mixing_service.set_auto_sync(session_config.auto_sync);
     mixing_service.set_bpm_tolerance(session_config.bpm_tolerance);
 
-    //update cache size in LRUCache
-    controller_service.set_cache_size(session_config.controller_cache_size);
+    //update cache size (and shard count) in the controller cache
+    if (session_config.controller_cache_shards > 1) {
+        std::cout << "Cache Shards: " << session_config.controller_cache_shards << std::endl;
+    }
+    controller_service.configure_cache(session_config.controller_cache_size,
+                                       session_config.controller_cache_shards > 0 ? session_config.controller_cache_shards : 1);
+    if (session_config.controller_cache_bytes > 0) {
+        std::cout << "Cache Memory Budget: " << session_config.controller_cache_bytes << " bytes" << std::endl;
+        controller_service.set_cache_byte_budget(session_config.controller_cache_bytes);
+    }
+    if (!controller_service.set_cache_policy(session_config.controller_cache_policy)) {
+        std::cout << "[WARNING] Unknown cache policy '" << session_config.controller_cache_policy
+                  << "', using LRU" << std::endl;
+    }
+    controller_service.enable_policy_comparison(session_config.controller_cache_compare_policies);
+    if (session_config.controller_prefetch_depth > 0) {
+        std::cout << "Prefetch Depth: " << session_config.controller_prefetch_depth << " tracks" << std::endl;
+        controller_service.set_prefetch_depth(session_config.controller_prefetch_depth);
+    }
+
+    if (!session_config.analysis_cache_file.empty()) {
+        size_t loaded = AnalysisCache::instance().open_file(session_config.analysis_cache_file);
+        std::cout << "Analysis Cache: " << session_config.analysis_cache_file << " (" << loaded
+                  << " entries loaded)" << std::endl;
+    }
+
+    if (session_config.mixer_deck_count != 2 || session_config.mixer_deck_scheduler != "round_robin") {
+        mixing_service.set_deck_count(session_config.mixer_deck_count > 0
+                                      ? static_cast<size_t>(session_config.mixer_deck_count) : 1);
+        if (!mixing_service.set_deck_scheduler(session_config.mixer_deck_scheduler)) {
+            std::cout << "[WARNING] Unknown deck scheduler '" << session_config.mixer_deck_scheduler
+                      << "', using round_robin" << std::endl;
+            mixing_service.set_deck_scheduler("round_robin");
+        }
+        std::cout << "Mixer Decks: " << mixing_service.get_deck_count() << " (" << mixing_service.get_deck_scheduler()
+                  << " assignment)" << std::endl;
+    }
+    if (!session_config.mixer_render_sink.empty() && session_config.mixer_block_frames > 0
+        && mixing_service.enable_rendering(session_config.mixer_render_sink,
+                                           static_cast<size_t>(session_config.mixer_block_frames),
+                                           session_config.mixer_sample_rate, session_config.default_crossfade_time)) {
+        const AudioRenderer& renderer = *mixing_service.get_renderer();
+        std::cout << "Mixer Render: " << renderer.get_sink().describe() << ", " << renderer.get_block_frames()
+                  << "-frame blocks at " << renderer.get_sample_rate() << " Hz ("
+                  << static_cast<int>(renderer.block_budget_us()) << " us deadline)" << std::endl;
+    }
+
+    if (!session_config.session_trace_file.empty()) {
+        trace_out.open(session_config.session_trace_file.c_str(), std::ios::app);
+        if (trace_out.is_open()) {
+            std::cout << "Recording cache request trace to: " << session_config.session_trace_file << std::endl;
+        } else {
+            std::cerr << "[WARNING] Cannot open trace file: " << session_config.session_trace_file << std::endl;
+        }
+    }
     return true;
 }
 
+bool DJSession::run_batch_analysis(size_t threads, const std::string& sidecar_path) {
+    std::cout << "=== Batch Library Analysis ===" << std::endl;
+    if (!load_configuration()) {
+        std::cerr << "[ERROR] Failed to load configuration. Aborting batch analysis." << std::endl;
+        return false;
+    }
+    library_service.buildLibrary(session_config.library_tracks,
+                                 session_config.library_build_threads > 1 ? session_config.library_build_threads : 1);
+
+    const std::vector<AudioTrack*>& tracks = library_service.getLibrary();
+    BatchAnalyzer analyzer(threads);
+    std::cout << "\nAnalyzing " << tracks.size() << " tracks on " << analyzer.get_threads() << " threads..." << std::endl;
+    BatchReport report = analyzer.run(tracks, &std::cout);
+    library_service.refreshIndexes();   // analysis changed BPMs and grids in place
+
+    std::cout << "\n--- Track Analysis ---" << std::endl;
+    for (size_t i = 0; i < report.results.size(); ++i) {
+        const BatchTrackResult& r = report.results[i];
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(2);
+        line << (i + 1) << ". " << r.title << " [" << r.type << "] " << r.bpm << " BPM";
+        if (r.grid.valid()) line << " (measured, " << r.grid.beat_count << " beats from " << r.grid.first_beat << "s)";
+        line << ", quality " << r.quality << ", " << r.analysis_ms << " ms";
+        std::cout << line.str() << std::endl;
+    }
+
+    double concurrency = report.wall_seconds > 0.0 ? report.track_seconds / report.wall_seconds : 0.0;
+    std::ostringstream summary;
+    summary << std::fixed << std::setprecision(2);
+    summary << "Analyzed " << report.results.size() << " tracks in " << report.wall_seconds * 1e3 << " ms ("
+            << (report.wall_seconds > 0.0 ? report.results.size() / report.wall_seconds : 0.0) << " tracks/s, "
+            << report.track_seconds * 1e3 << " ms of track work, " << concurrency << " tracks in flight, "
+            << report.steals << " steals)";
+    std::cout << "\n" << summary.str() << std::endl;
+
+    bool written = BatchAnalyzer::write_sidecar(sidecar_path, report.results);
+    if (written) {
+        std::cout << "Results written to: " << sidecar_path << std::endl;
+    } else {
+        std::cerr << "[ERROR] Cannot write analysis sidecar: " << sidecar_path << std::endl;
+    }
+    if (!AnalysisCache::instance().save()) {
+        std::cerr << "[WARNING] Cannot write analysis cache: " << AnalysisCache::instance().get_file() << std::endl;
+    }
+    AnalysisCacheStats analysis = AnalysisCache::instance().get_stats();
+    std::cout << "Beat analysis cache: " << analysis.hits << " hits, " << analysis.misses << " misses ("
+              << analysis.entries << " entries)" << std::endl;
+    return written;
+}
+
+bool DJSession::run_playlist_optimizer(const std::string& playlist_name) {
+    std::cout << "=== Playlist Optimizer ===" << std::endl;
+    if (!load_configuration()) {
+        std::cerr << "[ERROR] Failed to load configuration. Aborting playlist optimization." << std::endl;
+        return false;
+    }
+    library_service.buildLibrary(session_config.library_tracks,
+                                 session_config.library_build_threads > 1 ? session_config.library_build_threads : 1);
+
+    std::vector<std::string> playlist_names;
+    if (!playlist_name.empty()) {
+        playlist_names.push_back(playlist_name);
+    } else {
+        for (const auto& pair : session_config.playlists) playlist_names.push_back(pair.first);
+        std::sort(playlist_names.begin(), playlist_names.end());
+    }
+    if (playlist_names.empty()) {
+        std::cerr << "[ERROR] No playlists found in configuration." << std::endl;
+        return false;
+    }
+    std::cout << "BPM Tolerance: " << session_config.bpm_tolerance << " BPM" << std::endl;
+
+    PlaylistOptimizer optimizer(session_config.bpm_tolerance);
+    bool all_loaded = true;
+    for (const std::string& name : playlist_names) {
+        std::cout << std::endl;
+        if (!load_playlist(name)) {
+            std::cerr << "[ERROR] Cannot optimize playlist: " << name << std::endl;
+            all_loaded = false;
+            continue;
+        }
+        PlaylistPlan plan = optimizer.optimize(library_service.getPlaylist().getTracks());
+
+        std::ostringstream summary;
+        summary << std::fixed << std::setprecision(1);
+        summary << "[Optimizer] " << name << ": " << plan.order.size() << " tracks, cost " << plan.cost_before
+                << " (" << plan.syncs_before << " forced syncs) -> " << plan.cost_after << " ("
+                << plan.syncs_after << " forced syncs); nearest neighbour " << plan.cost_nearest << ", "
+                << plan.two_opt_moves << " 2-opt + " << plan.or_opt_moves << " Or-opt moves in " << plan.passes
+                << " passes, " << plan.milliseconds << " ms";
+        std::cout << summary.str() << std::endl;
+
+        for (size_t i = 0; i < plan.order.size(); ++i) {
+            const AudioTrack* track = plan.order[i];
+            std::cout << "  " << (i + 1) << ". " << track->get_title() << " (" << track->get_bpm() << " BPM";
+            if (track->get_key() >= 0) std::cout << ", " << HarmonicIndex::key_name(track->get_key());
+            std::cout << ")";
+            if (i > 0 && PlaylistOptimizer::bpm_gap(*plan.order[i - 1], *track) > session_config.bpm_tolerance) {
+                std::cout << " [sync]";
+            }
+            std::cout << std::endl;
+        }
+    }
+    return all_loaded;
+}
+
 std::string DJSession::display_playlist_menu_from_config() {
     if (session_config.playlists.empty()) {
         return "";
@@ -333,7 +735,69 @@ void DJSession::print_session_summary() const {
     std::cout << "Cache evictions: " << stats.cache_evictions << std::endl;
     std::cout << "Deck A loads: " << stats.deck_loads_a << std::endl;
     std::cout << "Deck B loads: " << stats.deck_loads_b << std::endl;
+    for (size_t i = 0; i < stats.deck_loads_more.size(); ++i) {
+        std::cout << "Deck " << static_cast<char>('C' + i) << " loads: " << stats.deck_loads_more[i] << std::endl;
+    }
     std::cout << "Transitions: " << stats.transitions << std::endl;
     std::cout << "Errors: " << stats.errors << std::endl;
+    ControllerStats controller = controller_service.get_stats();
+    if (controller.memory_budget_bytes > 0) {
+        std::cout << "Cache memory: " << controller.bytes_used << "/" << controller.memory_budget_bytes
+                  << " bytes used, " << controller.bytes_evicted << " bytes evicted" << std::endl;
+    }
+    if (!stats.policy_stats.empty()) {
+        std::cout << "Cache policy hit ratios (same requests):" << std::endl;
+        for (const CachePolicyStats& policy : stats.policy_stats) {
+            std::cout << "  " << policy.policy
+                      << (policy.policy == controller_service.get_cache_policy() ? " (active)" : "")
+                      << ": " << static_cast<int>(policy.hit_ratio() * 1000 + 0.5) / 10.0 << "% ("
+                      << policy.hits << " hits, " << policy.misses << " misses)" << std::endl;
+        }
+    }
+    if (controller_service.get_prefetch_depth() > 0) {
+        PrefetchStats prefetch = controller_service.get_prefetch_stats();
+        std::cout << "Prefetch hits: " << prefetch.hits << " (" << prefetch.waited
+                  << " waited on the worker)" << std::endl;
+        std::cout << "Wasted prefetches: " << prefetch.wasted << " of " << prefetch.completed << " prepared" << std::endl;
+        std::cout << "Transition latency: p50 " << percentile(stats.transition_us, 50) << " us, p95 "
+                  << percentile(stats.transition_us, 95) << " us, p99 "
+                  << percentile(stats.transition_us, 99) << " us" << std::endl;
+    }
+    AnalysisCacheStats analysis = AnalysisCache::instance().get_stats();
+    if (analysis.hits + analysis.misses > 0 || !session_config.analysis_cache_file.empty()) {
+        std::cout << "Beat analysis cache: " << analysis.hits << " hits, " << analysis.misses << " misses ("
+                  << analysis.entries << " entries)" << std::endl;
+    }
+    if (mixing_service.get_renderer()) {
+        RenderStats render = mixing_service.get_renderer()->get_stats();
+        std::cout << "Render blocks: " << render.blocks << " (" << render.commands << " deck commands, "
+                  << render.deadline_misses << " deadline misses, " << render.dropped_blocks << " dropped)" << std::endl;
+        std::cout << "Render time per block: mean " << static_cast<int>(render.mean_us + 0.5) << " us, p99 "
+                  << static_cast<int>(render.p99_us + 0.5) << " us, max " << static_cast<int>(render.max_us + 0.5)
+                  << " us of " << static_cast<int>(render.budget_us) << " us" << std::endl;
+    }
+    if (!stats.suggestion_us.empty()) {
+        std::cout << "Mix suggestion queries: " << stats.suggestion_us.size() << " over "
+                  << library_service.getLibrarySize() << " tracks, p50 " << percentile(stats.suggestion_us, 50)
+                  << " us, max " << percentile(stats.suggestion_us, 100) << " us" << std::endl;
+    }
+    if (session_config.session_allocation_stats) {
+        std::cout << "Playlist switches: " << stats.playlist_switches << " (" << stats.playlist_clones
+                  << " track clones)" << std::endl;
+        const TrackAllocationStats& a = stats.allocations;
+        double per_transition = stats.transitions > 0 ? 1.0 / stats.transitions : 0.0;
+        std::cout << "Track copies: " << a.track_copies
+                  << " (" << a.track_copies * per_transition << " per transition)" << std::endl;
+        std::cout << "Waveform allocations: " << a.waveform_allocations
+                  << " (" << a.waveform_allocations * per_transition << " per transition)" << std::endl;
+        std::cout << "Waveform bytes copied: " << a.waveform_bytes_copied
+                  << " (" << a.waveform_bytes_copied * per_transition << " per transition)" << std::endl;
+        std::cout << "Pooled allocations: " << a.pool_allocations
+                  << " (" << a.pool_allocations * per_transition << " per transition, "
+                  << a.heap_allocations << " from the system heap)" << std::endl;
+        TrackAllocationStats total = AudioTrack::get_allocation_stats();
+        std::cout << "Waveforms materialized: " << total.waveform_allocations << " of "
+                  << total.tracks_constructed << " tracks, " << total.waveform_releases << " released" << std::endl;
+    }
     std::cout << "=== Session Complete ===" << std::endl;
 }
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "DeckScheduler.h"
+#include <algorithm>
+#include <cstdlib>
+
+static bool all_empty(const std::vector<MixerDeck>& decks) {
+    for (const MixerDeck& deck : decks) {
+        if (deck.track) return false;
+    }
+    return true;
+}
+
+// Lowest-numbered empty deck other than the active one, or decks.size()
+static size_t first_empty(const std::vector<MixerDeck>& decks, size_t active) {
+    for (size_t i = 0; i < decks.size(); ++i) {
+        if (i != active && !decks[i].track) return i;
+    }
+    return decks.size();
+}
+
+size_t RoundRobinScheduler::choose(const std::vector<MixerDeck>& decks, size_t active, const AudioTrack&) const {
+    if (decks.empty() || all_empty(decks)) return 0;
+    return (active + 1) % decks.size();
+}
+
+size_t LeastRecentlyFinishedScheduler::choose(const std::vector<MixerDeck>& decks, size_t active,
+                                              const AudioTrack&) const {
+    if (decks.size() < 2 || all_empty(decks)) return 0;
+    size_t empty = first_empty(decks, active);
+    if (empty < decks.size()) return empty;
+
+    size_t best = decks.size();
+    for (size_t i = 0; i < decks.size(); ++i) {
+        if (i == active) continue;
+        if (best == decks.size() || decks[i].finished_at < decks[best].finished_at) best = i;
+    }
+    return best;
+}
+
+size_t BpmNearestScheduler::choose(const std::vector<MixerDeck>& decks, size_t active,
+                                   const AudioTrack& incoming) const {
+    if (decks.size() < 2 || all_empty(decks)) return 0;
+    size_t empty = first_empty(decks, active);
+    if (empty < decks.size()) return empty;
+
+    size_t best = decks.size();
+    int best_gap = 0;
+    for (size_t i = 0; i < decks.size(); ++i) {
+        if (i == active) continue;
+        int gap = std::abs(decks[i].track->get_bpm() - incoming.get_bpm());
+        if (best == decks.size() || gap < best_gap
+            || (gap == best_gap && decks[i].finished_at < decks[best].finished_at)) {
+            best = i;
+            best_gap = gap;
+        }
+    }
+    return best;
+}
+
+// ========== Factory ==========
+
+PointerWrapper<DeckScheduler> make_deck_scheduler(const std::string& name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+
+    if (lower.empty() || lower == "round_robin") {
+        return PointerWrapper<DeckScheduler>(new RoundRobinScheduler());
+    }
+    if (lower == "least_recently_finished" || lower == "lrf") {
+        return PointerWrapper<DeckScheduler>(new LeastRecentlyFinishedScheduler());
+    }
+    if (lower == "bpm_nearest") {
+        return PointerWrapper<DeckScheduler>(new BpmNearestScheduler());
+    }
+    return PointerWrapper<DeckScheduler>();
+}
@@ -0,0 +1,77 @@
+#include "DspKernels.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// ========== SCALAR ==========
+
+float DspKernels::dot_scalar(const float* a, const float* b, size_t n) {
+    float s = 0.0f;
+    for (size_t i = 0; i < n; ++i) s += a[i] * b[i];
+    return s;
+}
+
+void DspKernels::multiply_add_scalar(float* out, const float* in, const float* gain, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] += in[i] * gain[i];
+}
+
+void DspKernels::interleave_scalar(const float* left, const float* right, float* out, size_t frames) {
+    for (size_t i = 0; i < frames; ++i) {
+        out[2 * i] = left[i];
+        out[2 * i + 1] = right[i];
+    }
+}
+
+// ========== SSE2 ==========
+
+#ifdef __SSE2__
+
+bool DspKernels::vectorized() { return true; }
+
+float DspKernels::dot(const float* a, const float* b, size_t n) {
+    // Two accumulators so consecutive adds do not wait on each other
+    __m128 s0 = _mm_setzero_ps();
+    __m128 s1 = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        s0 = _mm_add_ps(s0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        s1 = _mm_add_ps(s1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, _mm_add_ps(s0, s1));
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + dot_scalar(a + i, b + i, n - i);
+}
+
+void DspKernels::multiply_add(float* out, const float* in, const float* gain, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 product = _mm_mul_ps(_mm_loadu_ps(in + i), _mm_loadu_ps(gain + i));
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), product));
+    }
+    multiply_add_scalar(out + i, in + i, gain + i, n - i);
+}
+
+void DspKernels::interleave(const float* left, const float* right, float* out, size_t frames) {
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        __m128 l = _mm_loadu_ps(left + i);
+        __m128 r = _mm_loadu_ps(right + i);
+        _mm_storeu_ps(out + 2 * i, _mm_unpacklo_ps(l, r));
+        _mm_storeu_ps(out + 2 * i + 4, _mm_unpackhi_ps(l, r));
+    }
+    interleave_scalar(left + i, right + i, out + 2 * i, frames - i);
+}
+
+#else
+
+bool DspKernels::vectorized() { return false; }
+float DspKernels::dot(const float* a, const float* b, size_t n) { return dot_scalar(a, b, n); }
+void DspKernels::multiply_add(float* out, const float* in, const float* gain, size_t n) {
+    multiply_add_scalar(out, in, gain, n);
+}
+void DspKernels::interleave(const float* left, const float* right, float* out, size_t frames) {
+    interleave_scalar(left, right, out, frames);
+}
+
+#endif
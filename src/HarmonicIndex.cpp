@@ -0,0 +1,219 @@
+#include "HarmonicIndex.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <queue>
+
+const double HarmonicIndex::UNKNOWN_KEY_COST = 1.5;
+const double HarmonicIndex::UNKNOWN_ENERGY_COST = 0.5;
+const double HarmonicIndex::HALF_DOUBLE_COST = 0.5;
+
+static const int MAX_KEY_DISTANCE = 1;      // same key, a fifth up/down, or relative major/minor
+
+HarmonicIndex::HarmonicIndex() : buckets((KEY_COUNT + 1) * (MAX_ENERGY + 1)), track_count(0) {}
+
+void HarmonicIndex::build(const std::vector<AudioTrack*>& tracks) {
+    clear();
+    for (size_t i = 0; i < tracks.size(); ++i) {
+        AudioTrack* track = tracks[i];
+        if (!track) continue;
+        int key = track->get_key() >= 0 && track->get_key() < KEY_COUNT ? track->get_key() : -1;
+        int energy = track->get_energy() >= 1 && track->get_energy() <= MAX_ENERGY ? track->get_energy() : 0;
+        Entry entry;
+        entry.bpm = track->get_bpm();
+        entry.order = static_cast<uint32_t>(i);
+        entry.track = track;
+        buckets[bucket_index(key, energy)].push_back(entry);
+        track_count++;
+    }
+    // Stable so equal BPMs keep library order
+    for (std::vector<Entry>& bucket : buckets) {
+        std::stable_sort(bucket.begin(), bucket.end(), [](const Entry& a, const Entry& b) { return a.bpm < b.bpm; });
+    }
+}
+
+void HarmonicIndex::clear() {
+    for (std::vector<Entry>& bucket : buckets) bucket.clear();
+    track_count = 0;
+}
+
+struct RankedCandidate {
+    MixCandidate candidate;
+    uint32_t order;
+
+    RankedCandidate() : candidate(), order(0) {}
+};
+
+// Heap order: the worst candidate kept is on top
+struct WorseCandidateFirst {
+    bool operator()(const RankedCandidate& a, const RankedCandidate& b) const {
+        if (a.candidate.score != b.candidate.score) return a.candidate.score < b.candidate.score;
+        return a.order < b.order;
+    }
+};
+
+// A bucket a query visits, with the part of the score its key and energy fix
+struct BucketVisit {
+    double cost;
+    int key_distance;
+    int energy_gap;
+    size_t bucket;
+};
+
+// Tempo gap as can_mix_tracks measures it: direct, candidate at double, candidate at half time
+static int window_gap(size_t window, int candidate, int playing) {
+    if (window == 1) return std::abs(candidate - 2 * playing);
+    if (window == 2) return std::abs(playing - 2 * candidate);
+    return std::abs(candidate - playing);
+}
+
+std::vector<MixCandidate> HarmonicIndex::find_compatible(const MixQuery& query, size_t k) const {
+    std::vector<MixCandidate> result;
+    if (k == 0 || track_count == 0) return result;
+    int tolerance = std::abs(query.bpm_tolerance);
+    int energy_tolerance = std::abs(query.energy_tolerance);
+    bool known_key = query.key >= 0 && query.key < KEY_COUNT;
+    bool known_energy = query.energy >= 1 && query.energy <= MAX_ENERGY;
+    double tempo_scale = 1.0 / (tolerance + 1.0);
+
+    // Tempo windows in window_gap() order. The gap grows away from start on both sides.
+    int low[3] = {query.bpm - tolerance, 2 * query.bpm - tolerance, (query.bpm - tolerance + 1) / 2};
+    int high[3] = {query.bpm + tolerance, 2 * query.bpm + tolerance, (query.bpm + tolerance) / 2};
+    int start[3] = {query.bpm, 2 * query.bpm, (query.bpm + 1) / 2};
+    size_t window_count = query.half_double ? 3 : 1;
+
+    std::vector<BucketVisit> visits;
+    for (int key = -1; key < KEY_COUNT; ++key) {
+        int distance = -1;
+        if (key >= 0 && known_key) {
+            distance = key_distance(query.key, key);
+            if (distance > MAX_KEY_DISTANCE) continue;
+        }
+        for (int energy = 0; energy <= MAX_ENERGY; ++energy) {
+            int energy_gap = -1;
+            if (energy > 0 && known_energy) {
+                energy_gap = std::abs(energy - query.energy);
+                if (energy_gap > energy_tolerance) continue;
+            }
+            size_t bucket = bucket_index(key, energy);
+            if (buckets[bucket].empty()) continue;
+            BucketVisit visit;
+            visit.cost = (distance >= 0 ? distance : UNKNOWN_KEY_COST)
+                         + (energy_gap >= 0 ? energy_gap / (energy_tolerance + 1.0) : UNKNOWN_ENERGY_COST);
+            visit.key_distance = distance;
+            visit.energy_gap = energy_gap;
+            visit.bucket = bucket;
+            visits.push_back(visit);
+        }
+    }
+    std::sort(visits.begin(), visits.end(),
+              [](const BucketVisit& a, const BucketVisit& b) { return a.cost < b.cost; });
+
+    std::priority_queue<RankedCandidate, std::vector<RankedCandidate>, WorseCandidateFirst> best;
+    // Keeps the entry if it ranks in the top k; false once the scan direction can only get worse
+    auto offer = [&](const Entry& entry, size_t window, const BucketVisit& visit) -> bool {
+        int gap = window_gap(window, entry.bpm, query.bpm);
+        double score = visit.cost + gap * tempo_scale + (window > 0 ? HALF_DOUBLE_COST : 0.0);
+        if (best.size() == k && score > best.top().candidate.score) return false;
+        if (entry.track == query.exclude) return true;
+        if (window > 0) {
+            // A half/double match needs measured grids on both sides, as in can_mix_tracks
+            if (!entry.track->get_beat_grid()) return true;
+            // Tiny tempos can put a track in both windows; the direct match counts
+            if (std::abs(entry.bpm - query.bpm) <= tolerance) return true;
+        }
+        RankedCandidate ranked;
+        ranked.order = entry.order;
+        ranked.candidate.score = score;
+        if (best.size() == k && !WorseCandidateFirst()(ranked, best.top())) return true;
+        ranked.candidate.track = entry.track;
+        ranked.candidate.bpm_gap = gap;
+        ranked.candidate.key_distance = visit.key_distance;
+        ranked.candidate.energy_gap = visit.energy_gap;
+        ranked.candidate.half_double = window > 0;
+        best.push(ranked);
+        if (best.size() > k) best.pop();
+        return true;
+    };
+
+    for (const BucketVisit& visit : visits) {
+        // Visits come in cost order: once one cannot beat the k kept, none of the rest can
+        if (best.size() == k && visit.cost > best.top().candidate.score) break;
+        const std::vector<Entry>& bucket = buckets[visit.bucket];
+        for (size_t w = 0; w < window_count; ++w) {
+            // Walk outwards from the best tempo, stopping each side once it cannot rank
+            std::vector<Entry>::const_iterator middle = std::lower_bound(
+                bucket.begin(), bucket.end(), start[w], [](const Entry& e, int value) { return e.bpm < value; });
+            for (std::vector<Entry>::const_iterator it = middle; it != bucket.end() && it->bpm <= high[w]; ++it) {
+                if (!offer(*it, w, visit)) break;
+            }
+            for (std::vector<Entry>::const_iterator it = middle; it != bucket.begin();) {
+                --it;
+                if (it->bpm < low[w] || !offer(*it, w, visit)) break;
+            }
+        }
+    }
+
+    result.resize(best.size());
+    for (size_t i = result.size(); i > 0; --i) {
+        result[i - 1] = best.top().candidate;
+        best.pop();
+    }
+    return result;
+}
+
+// ========== CAMELOT KEYS ==========
+
+// Camelot number (1..12) of a major key from its pitch class (C = 0): C is 8B, each fifth up adds one
+static int camelot_number_of_major(int pitch_class) {
+    return (7 + 7 * pitch_class) % 12 + 1;
+}
+
+int HarmonicIndex::parse_key(const std::string& text) {
+    std::string s;
+    for (char c : text) {
+        if (!std::isspace(static_cast<unsigned char>(c))) s += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    if (s.empty()) return -1;
+
+    // Camelot: 1a..12b
+    if (std::isdigit(static_cast<unsigned char>(s[0]))) {
+        size_t digits = 0;
+        while (digits < s.size() && std::isdigit(static_cast<unsigned char>(s[digits]))) digits++;
+        if (digits + 1 != s.size() || digits > 2) return -1;
+        int number = std::atoi(s.substr(0, digits).c_str());
+        char letter = s[digits];
+        if (number < 1 || number > 12 || (letter != 'a' && letter != 'b')) return -1;
+        return (number - 1) * 2 + (letter == 'b' ? 1 : 0);
+    }
+
+    // Musical: note, optional #/b, optional m/min (minor)
+    static const int NOTE_PITCH[7] = {9, 11, 0, 2, 4, 5, 7};   // a b c d e f g
+    if (s[0] < 'a' || s[0] > 'g') return -1;
+    int pitch = NOTE_PITCH[s[0] - 'a'];
+    size_t pos = 1;
+    if (pos < s.size() && (s[pos] == '#' || s[pos] == 'b')) {
+        pitch += s[pos] == '#' ? 1 : 11;
+        pos++;
+    }
+    std::string mode = s.substr(pos);
+    bool minor;
+    if (mode.empty() || mode == "maj" || mode == "major") minor = false;
+    else if (mode == "m" || mode == "min" || mode == "minor") minor = true;
+    else return -1;
+    pitch %= 12;
+    // A minor key sits on the number of its relative major (three semitones up)
+    int number = camelot_number_of_major(minor ? (pitch + 3) % 12 : pitch);
+    return (number - 1) * 2 + (minor ? 0 : 1);
+}
+
+std::string HarmonicIndex::key_name(int key) {
+    if (key < 0 || key >= KEY_COUNT) return std::string();
+    return std::to_string(key / 2 + 1) + (key % 2 ? "B" : "A");
+}
+
+int HarmonicIndex::key_distance(int a, int b) {
+    int around = std::abs(a / 2 - b / 2);
+    if (around > 6) around = 12 - around;
+    return around + (a % 2 != b % 2 ? 1 : 0);
+}
@@ -1,8 +1,20 @@
 #include "LRUCache.h"
+#include "LogSink.h"
 #include <iostream>
+#include <algorithm>
 
 LRUCache::LRUCache(size_t capacity)
-    : slots(capacity), max_size(capacity), access_counter(0) {}
+    : LRUCache(capacity, PointerWrapper<CachePolicy>(new LRUPolicy())) {}
+
+LRUCache::LRUCache(size_t capacity, PointerWrapper<CachePolicy> cache_policy)
+    : slots(capacity), max_size(capacity), access_counter(0),
+      index(), policy(std::move(cache_policy)), used(0),
+      max_bytes(0), used_bytes(0), evicted_bytes(0), evictions(0), free_slots() {
+    if (!policy) policy.reset(new LRUPolicy());
+    policy->reset(capacity);
+    index.reserve(capacity);
+    resetFreeSlots();
+}
 
 bool LRUCache::contains(const std::string& track_id) const {
     return findSlot(track_id) != max_size;
@@ -11,6 +23,7 @@ bool LRUCache::contains(const std::string& track_id) const {
 AudioTrack* LRUCache::get(const std::string& track_id) {
     size_t idx = findSlot(track_id);
     if (idx == max_size) return nullptr;
+    policy->on_hit(slots, idx);
     return slots[idx].access(++access_counter);
 }
 
@@ -22,127 +35,183 @@ bool LRUCache::put(PointerWrapper<AudioTrack> track) {
     // Handle nullptr track by returning  false immediately
     if (!track) return false;
 
+    // A zero-capacity cache can never hold anything
+    if (max_size == 0) return false;
+
     // Update the access counter
     access_counter++;
 
-    // Initialize bool values
-    bool allSlotsAreFull = true;
-    bool evictionHappend = false;
+    // If a track with the same title already exists in the cache
+    size_t existing = findSlot(track->get_title());
+    if (existing != max_size) {
+        policy->on_hit(slots, existing);
+        slots[existing].access(access_counter);     // Updates the access time
+        return false;                               // We did not remove the LRU
+    }
 
-    // Iterate through all occupied slots
-    for (size_t i = 0; i < max_size; i++){
+    // Cache full -> Evict the policy's victim, then store in the freed slot
+    bool evictionHappend = false;
+    size_t slot = claimSlot(track->get_title(), track->get_memory_footprint(), evictionHappend);
+    slots[slot].store(std::move(track), access_counter);
+    used_bytes += slots[slot].getBytes();
+    policy->on_insert(slots, slot);
 
-        // If a track with the same title already exists in the cache
-        if (slots[i].isOccupied() && slots[i].getTrack()->get_title() == track->get_title()){
-            slots[i].access(access_counter);    // Updates the access time
-            return false;                       // We did not remove the LRU
-        }
+    // Return true if an eviction occurred, false otherwise
+    return evictionHappend;
+}
 
-        // If there is an empty slot
-        if (!slots[i].isOccupied()) allSlotsAreFull = false;
+bool LRUCache::touch(const std::string& track_id) {
+    if (max_size == 0) return false;
+    access_counter++;
 
+    size_t existing = findSlot(track_id);
+    if (existing != max_size) {
+        policy->on_hit(slots, existing);
+        slots[existing].access(access_counter);
+        return true;
     }
 
-    // Cache full -> Evict LRU
-    if (allSlotsAreFull) {
-        evictionHappend = true; 
-        evictLRU();
-    }
-    // Store the track in empty slot
-    slots[findEmptySlot()].store(std::move(track), access_counter); // didnt understaand why move was needed here
+    bool evicted = false;
+    size_t slot = claimSlot(track_id, 0, evicted);
+    slots[slot].reserve(track_id, access_counter);
+    policy->on_insert(slots, slot);
+    return false;
+}
 
+size_t LRUCache::claimSlot(const std::string& track_id, size_t bytes, bool& evicted) {
+    policy->before_insert(track_id);
+    evicted = false;
+    while (needsRoom(bytes) && evictLRU()) {
+        evicted = true;
+    }
 
-    // Return true if an eviction occurred, false otherwise
-    return evictionHappend;
+    size_t slot = findEmptySlot();
+    free_slots.pop_back();
+    index[track_id] = slot;
+    used++;
+    return slot;
 }
 
 bool LRUCache::evictLRU() {
     size_t lru = findLRUSlot();
     if (lru == max_size || !slots[lru].isOccupied()) return false;
+
+    policy->on_evict(slots, lru);
+    index.erase(slots[lru].getKey());
+    used_bytes -= slots[lru].getBytes();
+    evicted_bytes += slots[lru].getBytes();
+    evictions++;
     slots[lru].clear();
+    used--;
+
+    // The freed slot is the next one handed out by put()
+    free_slots.push_back(lru);
     return true;
 }
 
 size_t LRUCache::size() const {
-    size_t count = 0;
-    for (const auto& slot : slots) if (slot.isOccupied()) ++count;
-    return count;
+    return used;
 }
 
 void LRUCache::clear() {
     for (auto& slot : slots) {
         slot.clear();
     }
+    index.clear();
+    policy->reset(max_size);
+    used = 0;
+    used_bytes = 0;
+    resetFreeSlots();
+}
+
+bool LRUCache::needsRoom(size_t bytes) const {
+    if (free_slots.empty()) return true;
+    return max_bytes > 0 && used > 0 && used_bytes + bytes > max_bytes;
+}
+
+void LRUCache::set_byte_budget(size_t bytes) {
+    max_bytes = bytes;
+    while (max_bytes > 0 && used_bytes > max_bytes && evictLRU()) {}
 }
 
 void LRUCache::displayStatus() const {
-    std::cout << "[LRUCache] Status: " << size() << "/" << max_size << " slots used\n";
+    LogSink::out() << "[LRUCache] Status: " << size() << "/" << max_size << " slots used\n";
+    if (max_bytes > 0) {
+        LogSink::out() << "  Memory: " << used_bytes << "/" << max_bytes << " bytes used, "
+                  << evicted_bytes << " bytes evicted\n";
+    }
     for (size_t i = 0; i < max_size; ++i) {
         if(slots[i].isOccupied()){
-            std::cout << "  Slot " << i << ": " << slots[i].getTrack()->get_title()
+            LogSink::out() << "  Slot " << i << ": " << slots[i].getKey()
                       << " (last access: " << slots[i].getLastAccessTime() << ")\n";
         } else {
-            std::cout << "  Slot " << i << ": [EMPTY]\n";
+            LogSink::out() << "  Slot " << i << ": [EMPTY]\n";
         }
     }
 }
 
 size_t LRUCache::findSlot(const std::string& track_id) const {
-    for (size_t i = 0; i < max_size; ++i) {
-        if (slots[i].isOccupied() && slots[i].getTrack()->get_title() == track_id) return i;
-    }
-    return max_size;
-
+    std::unordered_map<std::string, size_t>::const_iterator it = index.find(track_id);
+    return it == index.end() ? max_size : it->second;
 }
 
 /**
- * TODO: Implement the findLRUSlot() method for LRUCache - COMPLETED
+ * The victim is whatever the policy picks (the LRU tail for LRUPolicy).
  */
-size_t LRUCache::findLRUSlot() const {
-
-    // Initialize min, Index and boolean value.
-    size_t min;
-    size_t index = max_size; // If every slot is empty we will return Max_size.
-    bool first_occupied_slot = true;
-
-
-    // Iterate over slots
-    for (size_t i = 0; i < max_size; i++){
-
-        // If every slot is empty we will not enter
-        if (slots[i].isOccupied()){
-
-            // Initialize min based on the first slot that is not empty.
-            if (first_occupied_slot){  // We reached the first occupied slot
-            first_occupied_slot = false; 
-            min = slots[i].getLastAccessTime();
-            index = i;
-            }
-
-            // If there are multipul slots that are full, these lines will choose the minimal value slot 
-            else {
-                if (slots[i].getLastAccessTime() < min) {
-                min = slots[i].getLastAccessTime(); // Saving the minimal value
-                index = i; // Saving the index of the minimal value
-                }
-            }
-        }
-    }
-    return index; // Placeholder - Return the index of the LRU
+size_t LRUCache::findLRUSlot() {
+    if (used == 0) return max_size;
+    size_t victim = policy->select_victim(slots);
+    return victim == CacheSlot::NO_SLOT ? max_size : victim;
 }
 
 size_t LRUCache::findEmptySlot() const {
-    for (size_t i = 0; i < max_size; ++i) {
-        if (!slots[i].isOccupied()) return i;
+    return free_slots.empty() ? max_size : free_slots.back();
+}
+
+void LRUCache::resetFreeSlots() {
+    free_slots.clear();
+    for (size_t i = max_size; i > 0; --i) {
+        if (!slots[i - 1].isOccupied()) free_slots.push_back(i - 1);
     }
-    return max_size;
 }
 
 void LRUCache::set_capacity(size_t capacity){
     if (max_size == capacity)
         return;
+
+    // Shrinking: drop LRU entries until the survivors fit
+    while (size() > capacity) evictLRU();
+
+    // Move survivors that live beyond the new bound into low empty slots
+    for (size_t i = capacity; i < max_size; ++i) {
+        if (!slots[i].isOccupied()) continue;
+        size_t target = 0;
+        while (slots[target].isOccupied()) ++target;
+        std::swap(slots[target], slots[i]);
+    }
+
     //udpate max size
     max_size = capacity;
     //update the slots vector
     slots.resize(capacity);
-}
\ No newline at end of file
+
+    // Rebuild index and policy order (oldest access first, so MRU ends on top)
+    index.clear();
+    index.reserve(capacity);
+    policy->reset(capacity);
+    std::vector<size_t> order;
+    for (size_t i = 0; i < max_size; ++i) {
+        if (slots[i].isOccupied()) order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return slots[a].getLastAccessTime() < slots[b].getLastAccessTime();
+    });
+    for (size_t i : order) {
+        index[slots[i].getKey()] = i;
+        slots[i].setPrev(CacheSlot::NO_SLOT);
+        slots[i].setNext(CacheSlot::NO_SLOT);
+        policy->before_insert(slots[i].getKey());
+        policy->on_insert(slots, i);
+    }
+    resetFreeSlots();
+}
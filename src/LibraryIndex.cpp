@@ -0,0 +1,64 @@
+#include "LibraryIndex.h"
+#include <algorithm>
+
+void LibraryIndex::build(const std::vector<AudioTrack*>& tracks) {
+    clear();
+    by_title.reserve(tracks.size());
+    by_bpm.reserve(tracks.size());
+
+    for (AudioTrack* track : tracks) {
+        if (!track) continue;
+        by_title.insert(std::make_pair(track->get_title(), track));
+
+        for (const std::string& artist : track->get_artists()) {
+            std::vector<AudioTrack*>& credited = by_artist[artist];
+            if (credited.empty() || credited.back() != track) credited.push_back(track);
+        }
+
+        by_bpm.push_back(BpmEntry(track->get_bpm(), track));
+    }
+
+    // Stable so equal BPMs keep library order
+    std::stable_sort(by_bpm.begin(), by_bpm.end(),
+                     [](const BpmEntry& a, const BpmEntry& b) { return a.first < b.first; });
+}
+
+void LibraryIndex::clear() {
+    by_title.clear();
+    by_artist.clear();
+    by_bpm.clear();
+}
+
+AudioTrack* LibraryIndex::find_title(const std::string& title) const {
+    auto found = by_title.find(title);
+    return found != by_title.end() ? found->second : nullptr;
+}
+
+const std::vector<AudioTrack*>& LibraryIndex::find_artist(const std::string& artist) const {
+    static const std::vector<AudioTrack*> none;
+    auto found = by_artist.find(artist);
+    return found != by_artist.end() ? found->second : none;
+}
+
+std::pair<LibraryIndex::BpmIterator, LibraryIndex::BpmIterator>
+LibraryIndex::bpm_range(int bpm, int tolerance) const {
+    if (tolerance < 0) tolerance = -tolerance;
+    BpmIterator first = std::lower_bound(by_bpm.begin(), by_bpm.end(), bpm - tolerance,
+                                         [](const BpmEntry& e, int value) { return e.first < value; });
+    BpmIterator last = std::upper_bound(first, by_bpm.end(), bpm + tolerance,
+                                        [](int value, const BpmEntry& e) { return value < e.first; });
+    return std::make_pair(first, last);
+}
+
+std::vector<AudioTrack*> LibraryIndex::find_bpm(int bpm, int tolerance) const {
+    std::pair<BpmIterator, BpmIterator> range = bpm_range(bpm, tolerance);
+    std::vector<AudioTrack*> result;
+    result.reserve(range.second - range.first);
+    for (BpmIterator it = range.first; it != range.second; ++it) result.push_back(it->second);
+    return result;
+}
+
+size_t LibraryIndex::count_bpm(int bpm, int tolerance) const {
+    std::pair<BpmIterator, BpmIterator> range = bpm_range(bpm, tolerance);
+    return static_cast<size_t>(range.second - range.first);
+}
@@ -0,0 +1,17 @@
+#include "LogSink.h"
+#include <iostream>
+
+// nullptr means std::cout
+static thread_local std::ostream* current_sink = nullptr;
+
+std::ostream& LogSink::out() {
+    return current_sink ? *current_sink : std::cout;
+}
+
+LogSink::Capture::Capture(std::ostream& target) : previous(current_sink) {
+    current_sink = &target;
+}
+
+LogSink::Capture::~Capture() {
+    current_sink = previous;
+}
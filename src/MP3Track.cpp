@@ -1,45 +1,102 @@
 #include "MP3Track.h"
+#include "LogSink.h"
 #include <iostream>
 #include <cmath>
 #include <algorithm>
 
+WaveformFormat MP3Track::default_waveform_format = WAVEFORM_F64;
+
+static BlockPool& track_pool() {
+    static BlockPool pool(sizeof(MP3Track), 256);
+    return pool;
+}
+
+void* MP3Track::operator new(size_t size) {
+    if (size != sizeof(MP3Track)) return ::operator new(size);
+    return track_pool().allocate();
+}
+
+void MP3Track::operator delete(void* block, size_t size) {
+    if (size != sizeof(MP3Track)) ::operator delete(block);
+    else track_pool().deallocate(block);
+}
+
+BlockPoolStats MP3Track::get_pool_stats() {
+    return track_pool().get_stats();
+}
+
 MP3Track::MP3Track(const std::string& title, const std::vector<std::string>& artists, 
-                   int duration, int bpm, int bitrate, bool has_tags)
-    : AudioTrack(title, artists, duration, bpm), bitrate(bitrate), has_id3_tags(has_tags) {
+                   int duration, int bpm, int bitrate, bool has_tags, const std::string& file_path)
+    : AudioTrack(title, artists, duration, bpm), bitrate(bitrate), has_id3_tags(has_tags),
+      file(file_path.empty() ? nullptr : std::make_shared<Mp3File>(file_path)) {
+    set_waveform_format(default_waveform_format);
 
-    std::cout << "MP3Track created: " << bitrate << " kbps" << std::endl;
+    LogSink::out() << "MP3Track created: " << bitrate << " kbps" << std::endl;
 }
 
 // ========== TODO: STUDENTS IMPLEMENT THESE VIRTUAL FUNCTIONS ==========
 
 void MP3Track::load() {
-    std::cout << "[MP3Track::load] Loading MP3: \"" << title
-              << "\" at " << bitrate << " kbps...\n";
+    // Measured from the stream rather than taken from the config
+    bool indexed = measure(bitrate, duration_seconds);
+    print_load(indexed, bitrate, duration_seconds);
+}
+
+bool MP3Track::measure(int& kbps, int& seconds) const {
+    if (!file || !file->open(has_id3_tags)) return false;
+    kbps = file->get_index().average_bitrate_kbps();
+    seconds = static_cast<int>(file->get_index().duration_seconds() + 0.5);
+    return true;
+}
+
+void MP3Track::print_load(bool indexed, int kbps, int seconds) const {
+    LogSink::out() << "[MP3Track::load] Loading MP3: \"" << get_title()
+              << "\" at " << kbps << " kbps...\n";
     // TODO: Implement MP3 loading with format-specific operations
     // NOTE: Use exactly 2 spaces before the arrow (→) character
     if (has_id3_tags) {
-        std::cout << "  → Processing ID3 metadata (artist info, album art, etc.)..." << std::endl;
+        LogSink::out() << "  → Processing ID3 metadata (artist info, album art, etc.)..." << std::endl;
 
     } else {
-        std::cout << "  → No ID3 tags found" << std::endl;
+        LogSink::out() << "  → No ID3 tags found" << std::endl;
     }
 
-    std::cout << "  → Decoding MP3 frames..." << std::endl;
-    std::cout << "  → Load complete." << std::endl;
+    LogSink::out() << "  → Decoding MP3 frames..." << std::endl;
+    if (indexed) {
+        const Mp3FrameIndex& index = file->get_index();
+        LogSink::out() << "  → Indexed " << index.frame_count() << " frames from " << file->get_path() << " ("
+                       << index.get_sample_rate() << "Hz, " << (index.is_vbr() ? "VBR" : "CBR") << ", "
+                       << seconds << "s)" << std::endl;
+    } else if (file) {
+        LogSink::out() << "  → [WARNING] Cannot index " << file->get_path() << ": " << file->get_error() << std::endl;
+    }
+    LogSink::out() << "  → Load complete." << std::endl;
 
 }
 
 void MP3Track::analyze_beatgrid() {
-     std::cout << "[MP3Track::analyze_beatgrid] Analyzing beat grid for: \"" << title << "\"\n";
+    print_analysis(bitrate, duration_seconds);
+}
+
+void MP3Track::print_analysis(int kbps, int seconds) const {
+     LogSink::out() << "[MP3Track::analyze_beatgrid] Analyzing beat grid for: \"" << get_title() << "\"\n";
     // TODO: Implement MP3-specific beat detection analysis
     // NOTE: Use exactly 2 spaces before each arrow (→) character
-    double beats_estimated = (duration_seconds / 60.0) * bpm;
-    double precision_factor = bitrate / 320.0;
+    double beats_estimated = (seconds / 60.0) * bpm;
+    double precision_factor = kbps / 320.0;
 
-    std::cout << "  → Estimated beats: "  << (int)beats_estimated << "  → Compression precision factor: " << precision_factor << std::endl;
+    LogSink::out() << "  → Estimated beats: "  << (int)beats_estimated << "  → Compression precision factor: " << precision_factor << std::endl;
     
 }
 
+void MP3Track::prepare() const {
+    int kbps = bitrate;
+    int seconds = duration_seconds;
+    bool indexed = measure(kbps, seconds);
+    print_load(indexed, kbps, seconds);
+    print_analysis(kbps, seconds);
+}
+
 
 double MP3Track::get_quality_score() const {
     // TODO: Implement comprehensive quality scoring
@@ -63,7 +120,7 @@ double MP3Track::get_quality_score() const {
     }
     
     #ifdef DEBUG
-    std::cout << "[MP3Track::get_quality_score] \"" << title << "\" score = " << (int)quality << "/100" << std::endl;
+    std::cout << "[MP3Track::get_quality_score] \"" << get_title() << "\" score = " << (int)quality << "/100" << std::endl;
     #endif
 
     return quality;
@@ -71,7 +128,23 @@ double MP3Track::get_quality_score() const {
     
 
 
+const Mp3FrameIndex* MP3Track::get_frame_index() const {
+    return file && file->is_open() ? &file->get_index() : nullptr;
+}
+
+size_t MP3Track::seek_offset(double seconds) const {
+    const Mp3FrameIndex* index = get_frame_index();
+    return index ? index->offset_at(seconds) : 0;
+}
+
 PointerWrapper<AudioTrack> MP3Track::clone() const {
     // TODO: Implement polymorphic cloning
     return PointerWrapper<AudioTrack>(new MP3Track(*this)); // Replace with your implementation
+}
+
+size_t MP3Track::get_memory_footprint() const {
+    // Compressed frames: bitrate is in kbps
+    size_t payload = static_cast<size_t>(duration_seconds > 0 ? duration_seconds : 0)
+                   * static_cast<size_t>(bitrate > 0 ? bitrate : 0) * 1000 / 8;
+    return AudioTrack::get_memory_footprint() + (sizeof(MP3Track) - sizeof(AudioTrack)) + payload;
 }
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "MappedFile.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+bool MappedFile::map(const std::string& path, std::string& error) {
+    unmap();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open file";
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        error = "empty file";
+        return false;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);    // the mapping keeps the file referenced
+    if (mapped == MAP_FAILED) {
+        error = "mmap failed";
+        return false;
+    }
+    bytes = static_cast<unsigned char*>(mapped);
+    length = size;
+    return true;
+}
+
+void MappedFile::unmap() {
+    if (bytes) munmap(bytes, length);
+    bytes = nullptr;
+    length = 0;
+}
+
+void MappedFile::advise_sequential() const {
+    if (bytes) madvise(bytes, length, MADV_SEQUENTIAL);
+}
+
+static const uint64_t HASH_PRIME = 0x9E3779B97F4A7C15ULL;
+
+// Final avalanche (splitmix64), so nearby inputs give unrelated hashes
+static uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+static uint64_t lane_step(uint64_t lane, uint64_t word) {
+    lane ^= word * HASH_PRIME;
+    lane = (lane << 31) | (lane >> 33);
+    return lane * 0xC2B2AE3D27D4EB4FULL;
+}
+
+uint64_t MappedFile::content_hash() const {
+    if (!bytes) return 0;
+    uint64_t lanes[4] = {HASH_PRIME, HASH_PRIME + 1, HASH_PRIME + 2, HASH_PRIME + 3};
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        for (int k = 0; k < 4; ++k) {
+            uint64_t word;
+            std::memcpy(&word, bytes + i + 8 * k, 8);
+            lanes[k] = lane_step(lanes[k], word);
+        }
+    }
+    uint64_t tail = 0;
+    for (size_t shift = 0; i < length; ++i, shift = (shift + 8) % 64) {
+        tail ^= static_cast<uint64_t>(bytes[i]) << shift;
+    }
+    uint64_t h = static_cast<uint64_t>(length);
+    for (int k = 0; k < 4; ++k) h = mix(h ^ lanes[k]);
+    return mix(h ^ tail);
+}
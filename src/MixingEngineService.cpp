@@ -1,4 +1,6 @@
 #include "MixingEngineService.h"
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
 #include <memory>
 
@@ -7,8 +9,9 @@
  * TODO: Implement MixingEngineService constructor
  */
 MixingEngineService::MixingEngineService()
-    : decks(), active_deck(0), auto_sync(false), bpm_tolerance(0) //reset all four componnets to initilize them 
-    // deck[0] and deck[1] are two  arrys reprsented with raw pointers (at start they nullptr) 
+    : decks(2), active_deck(0), loading_deck(0), loads(0), scheduler(new RoundRobinScheduler()), auto_sync(false),
+      bpm_tolerance(0), renderer(), crossfade_seconds(0.0) //reset all componnets to initilize them 
+    // deck[0] and deck[1] hold raw pointers to the deck tracks (at start they nullptr) 
 {
     std::cout << "[MixingEngineService] Initialized with 2 empty decks." << std::endl;
 }   
@@ -18,16 +21,35 @@ MixingEngineService::MixingEngineService()
  */
 MixingEngineService::~MixingEngineService() {
     std::cout << "[MixingEngineService] Cleaning up decks..." << std::endl;
-    for (size_t i = 0; i <= 1; i++){ // iterate on decks, freeing the memory and setting the pointers to nullptr again
-        if (decks[i] != nullptr){
-            delete decks[i];
-            decks[i] = nullptr;
+    renderer.reset();       // stop the render thread before the decks go
+    for (size_t i = 0; i < decks.size(); i++){ // iterate on decks, freeing the memory and setting the pointers to nullptr again
+        if (decks[i].track != nullptr){
+            delete decks[i].track;
+            decks[i].track = nullptr;
         }
         
     }
     
 }
 
+void MixingEngineService::set_deck_count(size_t count) {
+    if (count == 0) count = 1;
+    if (count > MAX_DECKS) count = MAX_DECKS;
+    for (size_t i = count; i < decks.size(); ++i) {
+        delete decks[i].track;
+        decks[i].track = nullptr;
+    }
+    decks.resize(count);
+    if (active_deck >= count) active_deck = 0;
+}
+
+bool MixingEngineService::set_deck_scheduler(const std::string& name) {
+    PointerWrapper<DeckScheduler> created = make_deck_scheduler(name);
+    if (!created) return false;
+    scheduler = std::move(created);
+    return true;
+}
+
 
 /**
  * TODO: Implement loadTrackToDeck method
@@ -45,45 +67,59 @@ int MixingEngineService::loadTrackToDeck(const AudioTrack& track) {
         std::cerr << "[ERROR] Track: \"" <<track.get_title() << "\" failed to clone" << std::endl;
         return -1;
     }
+    return place_on_deck(std::move(wrappedClone));
+}
 
-    size_t target_deck; // size t or int
+int MixingEngineService::loadTrackToDeck(PointerWrapper<AudioTrack> copy) {
+    std::cout << "\n=== Loading Track to Deck ===" << std::endl;
+    if (!copy) return -1;
+    return place_on_deck(std::move(copy));
+}
 
-    // finding the deck we want to load 
-    if (decks[0] == nullptr && decks[1] == nullptr){
-        target_deck = 0;
-    } else {
-        target_deck = 1 - active_deck;
-    }
+// Everything after the clone: pick the deck, prepare the copy, sync and switch
+int MixingEngineService::place_on_deck(PointerWrapper<AudioTrack> wrappedClone) {
+    // finding the deck we want to load (deck 0 while all are empty)
+    size_t target_deck = scheduler->choose(decks, active_deck, *wrappedClone);
+    loading_deck = target_deck;
 
     std::cout << "[Deck Switch] Target deck: " << target_deck << std::endl;
     
     
     // checking if the wanted deck is occuiped
-    if (decks[target_deck] != nullptr){
-        delete decks[target_deck];
-        decks[target_deck] = nullptr;
+    if (decks[target_deck].track != nullptr){
+        delete decks[target_deck].track;
+        decks[target_deck].track = nullptr;
     }
     
     // prepring the song to be loaded 
     wrappedClone->load(); //loading song
     wrappedClone->analyze_beatgrid(); // beatgrid check
+    if (renderer) renderer->load_deck(target_deck, *wrappedClone);
 
     // if the song in the active deck and the new song doesnt much by BPM - use sync_bpm
-    if (decks[active_deck] != nullptr && auto_sync){
+    bool any_empty = false;
+    for (const MixerDeck& deck : decks) any_empty = any_empty || deck.track == nullptr;
+    if (decks[active_deck].track != nullptr && auto_sync){
         if (can_mix_tracks(wrappedClone) == false){
             sync_bpm(wrappedClone);
         }
-    } else if (decks[0] == nullptr || decks[1] == nullptr) {
+    } else if (any_empty) {
         std::cout << "[Sync BPM] Cannot sync - one of the decks is empty." << std::endl;
     }
     
     // unwraping the pointer to be a raw pointer (.release)
-    decks[target_deck] = wrappedClone.release(); // entering the song to the target deck
+    decks[target_deck].track = wrappedClone.release(); // entering the song to the target deck
 
-    std::cout << "[Load Complete] '" << decks[target_deck]->get_title() << "' is now loaded on deck " << target_deck << std::endl;  
+    std::cout << "[Load Complete] '" << decks[target_deck].track->get_title() << "' is now loaded on deck " << target_deck << std::endl;  
 
+    loads++;
+    if (active_deck != target_deck) decks[active_deck].finished_at = loads;
     active_deck = target_deck;
     std::cout << "[Active Deck] Switched to deck " << target_deck << std::endl;
+    if (renderer) {
+        renderer->crossfade_to(target_deck, crossfade_seconds);
+        renderer->advance(crossfade_seconds);   // render the transition
+    }
     
     return active_deck;
 }
@@ -93,9 +129,9 @@ int MixingEngineService::loadTrackToDeck(const AudioTrack& track) {
  */
 void MixingEngineService::displayDeckStatus() const {
     std::cout << "\n=== Deck Status ===\n";
-    for (size_t i = 0; i < 2; ++i) {
-        if (decks[i])
-            std::cout << "Deck " << i << ": " << decks[i]->get_title() << "\n";
+    for (size_t i = 0; i < decks.size(); ++i) {
+        if (decks[i].track)
+            std::cout << "Deck " << i << ": " << decks[i].track->get_title() << "\n";
         else
             std::cout << "Deck " << i << ": [EMPTY]\n";
     }
@@ -112,7 +148,7 @@ void MixingEngineService::displayDeckStatus() const {
  * @return: true if BPM difference <= tolerance, false otherwise
  */
 bool MixingEngineService::can_mix_tracks(const PointerWrapper<AudioTrack>& track) const {
-    if (decks[active_deck] == nullptr){   // checking if the deck conatins a song or empty
+    if (decks[active_deck].track == nullptr){   // checking if the deck conatins a song or empty
         return false;
     }
 
@@ -120,7 +156,7 @@ bool MixingEngineService::can_mix_tracks(const PointerWrapper<AudioTrack>& track
         return false;
     }
 
-    int current_BPM = decks[active_deck]->get_bpm(); // playing song bpm
+    int current_BPM = decks[active_deck].track->get_bpm(); // playing song bpm
     int new_BPM = track->get_bpm();                  // loading song bpm
     int gap_BPM = 0;
     
@@ -130,7 +166,14 @@ bool MixingEngineService::can_mix_tracks(const PointerWrapper<AudioTrack>& track
         gap_BPM = new_BPM - current_BPM;   // calculating the gap between playing song BPM and loading song BPM
     }
     
-    return gap_BPM <= bpm_tolerance;  
+    if (gap_BPM <= bpm_tolerance) return true;
+
+    // Measured grids are trusted enough to mix half/double time (e.g. 87 over 174)
+    if (decks[active_deck].track->get_beat_grid() && track->get_beat_grid()) {
+        int half_gap = std::min(std::abs(current_BPM - 2 * new_BPM), std::abs(2 * current_BPM - new_BPM));
+        return half_gap <= bpm_tolerance;
+    }
+    return false;
 }
 
 /**
@@ -138,7 +181,7 @@ bool MixingEngineService::can_mix_tracks(const PointerWrapper<AudioTrack>& track
  * @param track: Track to synchronize with active deck
  */
 void MixingEngineService::sync_bpm(const PointerWrapper<AudioTrack>& track) const {
-    if (decks[active_deck] ==nullptr) {
+    if (decks[active_deck].track ==nullptr) {
         return;
     }
     
@@ -146,7 +189,25 @@ void MixingEngineService::sync_bpm(const PointerWrapper<AudioTrack>& track) cons
         return;
     }
     int old_bpm = track->get_bpm();
-    int new_BPM = (track->get_bpm()+ decks[active_deck]->get_bpm()) / 2;
+    int new_BPM = (track->get_bpm()+ decks[active_deck].track->get_bpm()) / 2;
     track->set_bpm(new_BPM);
+    // Only the track being loaded is synced
+    if (renderer) renderer->set_deck_bpm(loading_deck, new_BPM);
     std::cout << "[Sync BPM] Syncing BPM from " << old_bpm << " to " << new_BPM << std::endl;   
-}
\ No newline at end of file
+}
+
+bool MixingEngineService::enable_rendering(const std::string& sink_spec, size_t block_frames, int sample_rate,
+                                           double crossfade_seconds) {
+    std::string why;
+    AudioSink* sink = AudioSink::create(sink_spec, sample_rate, why);
+    if (!sink) {
+        std::cout << "[WARNING] Mixer rendering disabled: " << why << std::endl;
+        return false;
+    }
+    renderer = PointerWrapper<AudioRenderer>(new AudioRenderer(sink, block_frames, sample_rate, decks.size()));
+    this->crossfade_seconds = crossfade_seconds;
+    renderer->set_on_demand(true);
+    renderer->set_auto_sync(auto_sync);
+    renderer->start();
+    return true;
+}
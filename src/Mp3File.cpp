@@ -0,0 +1,48 @@
+#include "Mp3File.h"
+#include <atomic>
+
+static std::atomic<size_t> builds(0);
+
+Mp3File::Mp3File(const std::string& path)
+    : lock(), path(path), attempted(false), error(), mapping(), index() {}
+
+Mp3File::~Mp3File() {}
+
+bool Mp3File::open(bool skip_id3) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (attempted) return mapping.is_mapped();
+    attempted = true;
+
+    if (!mapping.map(path, error)) return false;
+    mapping.advise_sequential();
+    builds++;
+    if (!index.build(mapping.data(), mapping.size(), skip_id3, error)) {
+        mapping.unmap();
+        return false;
+    }
+    return true;
+}
+
+bool Mp3File::is_open() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return mapping.is_mapped();
+}
+
+std::string Mp3File::get_error() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return error;
+}
+
+size_t Mp3File::file_bytes() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return mapping.size();
+}
+
+const unsigned char* Mp3File::data() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return mapping.data();
+}
+
+size_t Mp3File::index_builds() {
+    return builds;
+}
@@ -0,0 +1,174 @@
+#include "Mp3FrameIndex.h"
+#include <algorithm>
+#include <cstring>
+
+// kbps by [row][bitrate index]; rows: V1 L1, V1 L2, V1 L3, V2/2.5 L1, V2/2.5 L2 & L3
+static const int BITRATES[5][16] = {
+    {0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448, 0},
+    {0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 0},
+    {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 0},
+    {0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256, 0},
+    {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, 0},
+};
+
+static const int SAMPLE_RATES[3] = {44100, 48000, 32000};   // MPEG-1; halved for 2, quartered for 2.5
+
+Mp3FrameIndex::Mp3FrameIndex()
+    : frames(), sample_rate(0), total_samples(0), audio_bytes(0), id3_bytes(0), skipped_bytes(0),
+      variable_bitrate(false) {}
+
+bool Mp3FrameIndex::parse_header(const unsigned char* p, Mp3FrameHeader& header) {
+    if (p[0] != 0xFF || (p[1] & 0xE0) != 0xE0) return false;     // 11-bit sync
+
+    int version_bits = (p[1] >> 3) & 0x3;
+    int layer_bits = (p[1] >> 1) & 0x3;
+    int bitrate_index = (p[2] >> 4) & 0xF;
+    int rate_index = (p[2] >> 2) & 0x3;
+    if (version_bits == 1 || layer_bits == 0 || bitrate_index == 0 || bitrate_index == 15 || rate_index == 3) {
+        return false;
+    }
+
+    header.version = version_bits == 3 ? 10 : (version_bits == 2 ? 20 : 25);
+    header.layer = 4 - layer_bits;
+    header.padding = (p[2] >> 1) & 0x1;
+    header.mono = ((p[3] >> 6) & 0x3) == 3;
+
+    int row = header.version == 10 ? header.layer - 1 : (header.layer == 1 ? 3 : 4);
+    header.bitrate_kbps = BITRATES[row][bitrate_index];
+    header.sample_rate = SAMPLE_RATES[rate_index] / (header.version == 10 ? 1 : (header.version == 20 ? 2 : 4));
+
+    size_t bits_per_second = static_cast<size_t>(header.bitrate_kbps) * 1000;
+    size_t pad = header.padding ? 1 : 0;
+    if (header.layer == 1) {
+        header.samples = 384;
+        header.frame_bytes = (12 * bits_per_second / header.sample_rate + pad) * 4;
+    } else if (header.layer == 2 || header.version == 10) {
+        header.samples = 1152;
+        header.frame_bytes = 144 * bits_per_second / header.sample_rate + pad;
+    } else {
+        header.samples = 576;
+        header.frame_bytes = 72 * bits_per_second / header.sample_rate + pad;
+    }
+    return true;
+}
+
+// Same stream parameters: a real next frame shares version, layer and sample rate
+static bool same_stream(const Mp3FrameHeader& a, const Mp3FrameHeader& b) {
+    return a.version == b.version && a.layer == b.layer && a.sample_rate == b.sample_rate;
+}
+
+// A Xing/Info tag sits after the side information of the first Layer III frame
+static bool is_info_frame(const unsigned char* p, const Mp3FrameHeader& header) {
+    if (header.layer != 3) return false;
+    size_t side_info = header.version == 10 ? (header.mono ? 17 : 32) : (header.mono ? 9 : 17);
+    if (4 + side_info + 4 > header.frame_bytes) return false;
+    const unsigned char* tag = p + 4 + side_info;
+    return std::memcmp(tag, "Xing", 4) == 0 || std::memcmp(tag, "Info", 4) == 0;
+}
+
+bool Mp3FrameIndex::build(const unsigned char* data, size_t size, bool skip_id3, std::string& error) {
+    clear();
+    size_t pos = 0;
+
+    // ID3v2: "ID3", version (2), flags (1), syncsafe size (4); the size excludes the 10-byte header
+    if (skip_id3 && size >= 10 && std::memcmp(data, "ID3", 3) == 0) {
+        size_t tag = (static_cast<size_t>(data[6] & 0x7F) << 21) | (static_cast<size_t>(data[7] & 0x7F) << 14)
+                   | (static_cast<size_t>(data[8] & 0x7F) << 7) | static_cast<size_t>(data[9] & 0x7F);
+        tag += 10;
+        if (data[5] & 0x10) tag += 10;      // footer present
+        pos = id3_bytes = std::min(tag, size);
+    }
+
+    Mp3FrameHeader current;
+    Mp3FrameHeader next;
+    Mp3FrameHeader stream;
+    bool locked = false;
+    int first_bitrate = 0;
+    uint64_t samples = 0;
+
+    while (pos + 4 <= size) {
+        if (!parse_header(data + pos, current) || (locked && !same_stream(current, stream))) {
+            locked = false;
+            ++skipped_bytes;
+            ++pos;
+            continue;
+        }
+        size_t end = pos + current.frame_bytes;
+        if (end > size) break;      // truncated final frame
+
+        if (!locked) {
+            // Confirm a fresh sync by what follows the candidate frame
+            bool confirmed = end == size
+                          || (end + 4 <= size && parse_header(data + end, next) && same_stream(current, next))
+                          || (size - end >= 3 && std::memcmp(data + end, "TAG", 3) == 0);
+            if (!confirmed) {
+                ++skipped_bytes;
+                ++pos;
+                continue;
+            }
+            locked = true;
+            stream = current;
+        }
+
+        // A leading Xing/Info frame carries metadata, not audio
+        if (!frames.empty() || !is_info_frame(data + pos, current)) {
+            if (pos > UINT32_MAX || samples > UINT32_MAX) {
+                error = "stream too large for the seek table";
+                return false;
+            }
+            Entry entry;
+            entry.offset = static_cast<uint32_t>(pos);
+            entry.first_sample = static_cast<uint32_t>(samples);
+            frames.push_back(entry);
+            samples += current.samples;
+            audio_bytes += current.frame_bytes;
+            if (frames.size() == 1) first_bitrate = current.bitrate_kbps;
+            else if (current.bitrate_kbps != first_bitrate) variable_bitrate = true;
+        }
+        pos = end;
+    }
+
+    if (frames.empty()) {
+        error = "no MPEG audio frames found";
+        return false;
+    }
+    frames.shrink_to_fit();
+    sample_rate = stream.sample_rate;
+    total_samples = samples;
+    return true;
+}
+
+void Mp3FrameIndex::clear() {
+    frames.clear();
+    sample_rate = 0;
+    total_samples = 0;
+    audio_bytes = 0;
+    id3_bytes = 0;
+    skipped_bytes = 0;
+    variable_bitrate = false;
+}
+
+double Mp3FrameIndex::duration_seconds() const {
+    return sample_rate > 0 ? static_cast<double>(total_samples) / sample_rate : 0.0;
+}
+
+int Mp3FrameIndex::average_bitrate_kbps() const {
+    double seconds = duration_seconds();
+    return seconds > 0 ? static_cast<int>(audio_bytes * 8 / seconds / 1000 + 0.5) : 0;
+}
+
+size_t Mp3FrameIndex::frame_at(double seconds) const {
+    if (frames.empty() || seconds <= 0) return 0;
+    double sample = seconds * sample_rate;
+    uint32_t target = sample >= UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(sample);
+
+    // Last frame starting at or before the target sample
+    std::vector<Entry>::const_iterator after = std::upper_bound(
+        frames.begin(), frames.end(), target,
+        [](uint32_t value, const Entry& entry) { return value < entry.first_sample; });
+    return static_cast<size_t>(after - frames.begin()) - 1;
+}
+
+size_t Mp3FrameIndex::offset_at(double seconds) const {
+    return frames.empty() ? 0 : frames[frame_at(seconds)].offset;
+}
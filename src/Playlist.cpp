@@ -2,25 +2,17 @@
 #include "AudioTrack.h"
 #include <iostream>
 #include <algorithm>
-Playlist::Playlist(const std::string& name) 
-    : head(nullptr), playlist_name(name), track_count(0) {
+
+const size_t Playlist::NO_INDEX;
+
+Playlist::Playlist(const std::string& name, TrackOwnership ownership) 
+    : tracks(), prev_same_title(), title_index(), playlist_name(name), track_count(0), ownership(ownership) {
     std::cout << "Created playlist: " << name << std::endl;
 }
 // TODO: Fix memory leaks!
 // Students must fix this in Phase 1
 Playlist::~Playlist() {
-    PlaylistNode* current = head;
-
-    while (current != nullptr) {
-        PlaylistNode* next = current->next;
-
-        delete current->track; 
-        delete current;         
-        current = next;       
-    }
-
-    head = nullptr;
-    track_count = 0;
+    clear();
     #ifdef DEBUG
     std::cout << "Destroying playlist: " << playlist_name << std::endl;
     #endif
@@ -28,108 +20,89 @@ Playlist::~Playlist() {
 
 // Copy constructor - deep copy
 Playlist::Playlist(const Playlist& other) 
-    : head(nullptr), playlist_name(other.playlist_name), track_count(0) {
-    // Deep copy all nodes and tracks
-    PlaylistNode* current = other.head;
-    PlaylistNode* last = nullptr;
-    
-    while (current != nullptr) {
-        // Clone the track
-        PointerWrapper<AudioTrack> cloned_track = current->track->clone();
-        if (cloned_track) {
-            PlaylistNode* new_node = new PlaylistNode(cloned_track.release());
-            if (last == nullptr) {
-                head = new_node;
-            } else {
-                last->next = new_node;
-            }
-            last = new_node;
-            track_count++;
-        }
-        current = current->next;
-    }
+    : tracks(), prev_same_title(), title_index(), playlist_name(other.playlist_name), track_count(0),
+      ownership(other.ownership) {
+    copy_from(other);
 }
 
 // Copy assignment operator - deep copy
 Playlist& Playlist::operator=(const Playlist& other) {
     if (this != &other) {
         // Clear existing data
-        PlaylistNode* current = head;
-        while (current != nullptr) {
-            PlaylistNode* next = current->next;
-            delete current->track;
-            delete current;
-            current = next;
-        }
-        head = nullptr;
-        track_count = 0;
-        
+        clear();
+
         // Copy from other
         playlist_name = other.playlist_name;
-        PlaylistNode* src = other.head;
-        PlaylistNode* last = nullptr;
-        
-        while (src != nullptr) {
-            PointerWrapper<AudioTrack> cloned_track = src->track->clone();
-            if (cloned_track) {
-                PlaylistNode* new_node = new PlaylistNode(cloned_track.release());
-                if (last == nullptr) {
-                    head = new_node;
-                } else {
-                    last->next = new_node;
-                }
-                last = new_node;
-                track_count++;
-            }
-            src = src->next;
-        }
+        ownership = other.ownership;
+        copy_from(other);
     }
     return *this;
 }
 
+// Move constructor - no clones
+Playlist::Playlist(Playlist&& other) noexcept
+    : tracks(std::move(other.tracks)), prev_same_title(std::move(other.prev_same_title)),
+      title_index(std::move(other.title_index)), playlist_name(std::move(other.playlist_name)),
+      track_count(other.track_count), ownership(other.ownership) {
+    other.tracks.clear();
+    other.prev_same_title.clear();
+    other.title_index.clear();
+    other.track_count = 0;
+}
+
+// Move assignment operator - no clones
+Playlist& Playlist::operator=(Playlist&& other) noexcept {
+    if (this != &other) {
+        clear();
+        tracks.swap(other.tracks);
+        prev_same_title.swap(other.prev_same_title);
+        title_index.swap(other.title_index);
+        playlist_name.swap(other.playlist_name);
+        track_count = other.track_count;
+        ownership = other.ownership;
+        other.track_count = 0;
+    }
+    return *this;
+}
+
+void Playlist::reserve(size_t count) {
+    tracks.reserve(count);
+    prev_same_title.reserve(count);
+    title_index.reserve(count);
+}
+
 void Playlist::add_track(AudioTrack* track) {
     if (!track) {
         std::cout << "[Error] Cannot add null track to playlist" << std::endl;
         return;
     }
 
-    // Create new node - this allocates memory!
-    PlaylistNode* new_node = new PlaylistNode(track);
-
-    // Add to front of list
-    new_node->next = head;
-    head = new_node;
-    track_count++;
+    append(track);
 
     std::cout << "Added '" << track->get_title() << "' to playlist '" 
               << playlist_name << "'" << std::endl;
 }
 
 void Playlist::remove_track(const std::string& title) {
-    PlaylistNode* current = head;
-    PlaylistNode* prev = nullptr;
+    auto found = title_index.find(title);
 
-    // Find the track to remove
-    while (current && current->track->get_title() != title) {
-        prev = current;
-        current = current->next;
-    }
+    if (found != title_index.end()) {
+        size_t slot = found->second;
 
-    if (current) {
-        // Remove from linked list
-        if (prev) {
-            prev->next = current->next;
-        
+        // Expose the previous track with the same title, if any
+        if (prev_same_title[slot] == NO_INDEX) {
+            title_index.erase(found);
         } else {
-            head = current->next;
-            
+            found->second = prev_same_title[slot];
         }
-        delete current->track;
-        delete current;
+        if (owns_tracks()) delete tracks[slot];
+        tracks[slot] = nullptr;
 
         track_count--;
         std::cout << "Removed '" << title << "' from playlist" << std::endl;
 
+        if (tracks.size() >= 2 * static_cast<size_t>(track_count)) compact();
+
     } else {
         std::cout << "Track '" << title << "' not found in playlist" << std::endl;
     }
@@ -139,11 +112,13 @@ void Playlist::display() const {
     std::cout << "\n=== Playlist: " << playlist_name << " ===" << std::endl;
     std::cout << "Track count: " << track_count << std::endl;
 
-    PlaylistNode* current = head;
     int index = 1;
 
-    while (current) {
-        std::vector<std::string> artists = current->track->get_artists();
+    for (auto it = tracks.rbegin(); it != tracks.rend(); ++it) {
+        AudioTrack* track = *it;
+        if (!track) continue;
+
+        const std::vector<std::string>& artists = track->get_artists();
         std::string artist_list;
 
         std::for_each(artists.begin(), artists.end(), [&](const std::string& artist) {
@@ -153,12 +128,10 @@ void Playlist::display() const {
             artist_list += artist;
         });
 
-        AudioTrack* track = current->track;
         std::cout << index << ". " << track->get_title() 
                   << " by " << artist_list
                   << " (" << track->get_duration() << "s, " 
                   << track->get_bpm() << " BPM)" << std::endl;
-        current = current->next;
         index++;
     }
 
@@ -169,37 +142,72 @@ void Playlist::display() const {
 }
 
 AudioTrack* Playlist::find_track(const std::string& title) const {
-    PlaylistNode* current = head;
-
-    while (current) {
-        if (current->track->get_title() == title) {
-            return current->track;
-        }
-        current = current->next;
-    }
-
-    return nullptr;
+    auto found = title_index.find(title);
+    return found != title_index.end() ? tracks[found->second] : nullptr;
 }
 
 int Playlist::get_total_duration() const {
     int total = 0;
-    PlaylistNode* current = head;
 
-    while (current) {
-        total += current->track->get_duration();
-        current = current->next;
+    for (AudioTrack* track : tracks) {
+        if (track) total += track->get_duration();
     }
 
     return total;
 }
 
-std::vector<AudioTrack*> Playlist::getTracks() const {
-    std::vector<AudioTrack*> tracks;
-    PlaylistNode* current = head;
-    while (current) {
-        if (current->track)
-            tracks.push_back(current->track);
-        current = current->next;
+void Playlist::clear() {
+    if (owns_tracks()) {
+        for (AudioTrack* track : tracks) {
+            delete track;
+        }
     }
-    return tracks;
-}
\ No newline at end of file
+    tracks.clear();
+    prev_same_title.clear();
+    title_index.clear();
+    track_count = 0;
+}
+
+// Drop the nullptr holes left by remove_track and rebuild the links
+void Playlist::compact() {
+    tracks.erase(std::remove(tracks.begin(), tracks.end(), static_cast<AudioTrack*>(nullptr)), tracks.end());
+    prev_same_title.assign(tracks.size(), NO_INDEX);
+    title_index.clear();
+    for (size_t slot = 0; slot < tracks.size(); ++slot) {
+        auto inserted = title_index.insert(std::make_pair(tracks[slot]->get_title(), slot));
+        if (!inserted.second) {
+            prev_same_title[slot] = inserted.first->second;
+            inserted.first->second = slot;
+        }
+    }
+}
+
+void Playlist::copy_from(const Playlist& other) {
+    reserve(other.track_count);
+    for (AudioTrack* track : other.tracks) {
+        if (!track) continue;
+
+        // Borrowed tracks are shared, not cloned
+        if (!other.owns_tracks()) {
+            append(track);
+            continue;
+        }
+
+        // Clone the track
+        PointerWrapper<AudioTrack> cloned_track = track->clone();
+        if (cloned_track) {
+            append(cloned_track.release());
+        }
+    }
+}
+
+void Playlist::append(AudioTrack* track) {
+    size_t slot = tracks.size();
+    tracks.push_back(track);
+
+    // Newest track with this title shadows older ones
+    auto inserted = title_index.insert(std::make_pair(track->get_title(), slot));
+    prev_same_title.push_back(inserted.second ? NO_INDEX : inserted.first->second);
+    inserted.first->second = slot;
+    track_count++;
+}
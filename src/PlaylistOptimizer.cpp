@@ -0,0 +1,323 @@
+#include "PlaylistOptimizer.h"
+#include "HarmonicIndex.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <utility>
+
+const double PlaylistOptimizer::KEY_STEP_COST = 3.0;
+const double PlaylistOptimizer::UNKNOWN_KEY_COST = 3.0;
+const double PlaylistOptimizer::SYNC_COST = 10.0;
+
+static const double EPSILON = 1e-9;     // smallest improvement a move must make
+
+PlaylistOptimizer::PlaylistOptimizer(int bpm_tolerance)
+    : bpm_tolerance(std::abs(bpm_tolerance)), nodes(), by_bpm(), neighbours(), order(), position(), seen(), stamp(0) {}
+
+// Same gap as can_mix_tracks: half/double time only between measured grids
+static int gap_of(int a, int b, bool measured) {
+    int gap = std::abs(a - b);
+    if (measured) gap = std::min(gap, std::min(std::abs(a - 2 * b), std::abs(2 * a - b)));
+    return gap;
+}
+
+static double key_cost(int a, int b) {
+    if (a < 0 || b < 0) return PlaylistOptimizer::UNKNOWN_KEY_COST;
+    return PlaylistOptimizer::KEY_STEP_COST * HarmonicIndex::key_distance(a, b);
+}
+
+static int known_key(const AudioTrack& track) {
+    return track.get_key() >= 0 && track.get_key() < HarmonicIndex::KEY_COUNT ? track.get_key() : -1;
+}
+
+int PlaylistOptimizer::bpm_gap(const AudioTrack& a, const AudioTrack& b) {
+    return gap_of(a.get_bpm(), b.get_bpm(), a.get_beat_grid() && b.get_beat_grid());
+}
+
+double PlaylistOptimizer::transition_cost(const AudioTrack& from, const AudioTrack& to) const {
+    int gap = bpm_gap(from, to);
+    return gap + key_cost(known_key(from), known_key(to)) + (gap > bpm_tolerance ? SYNC_COST : 0.0);
+}
+
+double PlaylistOptimizer::sequence_cost(const std::vector<AudioTrack*>& tracks) const {
+    double total = 0.0;
+    const AudioTrack* previous = nullptr;
+    for (const AudioTrack* track : tracks) {
+        if (!track) continue;
+        if (previous) total += transition_cost(*previous, *track);
+        previous = track;
+    }
+    return total;
+}
+
+size_t PlaylistOptimizer::sequence_syncs(const std::vector<AudioTrack*>& tracks) const {
+    size_t syncs = 0;
+    const AudioTrack* previous = nullptr;
+    for (const AudioTrack* track : tracks) {
+        if (!track) continue;
+        if (previous && bpm_gap(*previous, *track) > bpm_tolerance) syncs++;
+        previous = track;
+    }
+    return syncs;
+}
+
+PlaylistPlan PlaylistOptimizer::optimize(const std::vector<AudioTrack*>& tracks) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    PlaylistPlan plan;
+    std::vector<AudioTrack*> input;
+    for (AudioTrack* track : tracks) {
+        if (track) input.push_back(track);
+    }
+    plan.cost_before = sequence_cost(input);
+    plan.syncs_before = sequence_syncs(input);
+
+    nodes.clear();
+    for (const AudioTrack* track : input) {
+        Node node;
+        node.bpm = track->get_bpm();
+        node.key = known_key(*track);
+        node.measured = track->get_beat_grid() != nullptr;
+        nodes.push_back(node);
+    }
+    order.resize(nodes.size());
+    position.resize(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        order[i] = static_cast<int>(i);
+        position[i] = static_cast<int>(i);
+    }
+
+    // Fewer than three tracks have nothing to reorder behind the opener
+    if (nodes.size() >= 3) {
+        build_neighbours();
+        nearest_neighbour();
+        plan.cost_nearest = path_cost();
+        while (plan.passes < MAX_PASSES) {
+            bool improved = two_opt_pass(plan.two_opt_moves);
+            improved = or_opt_pass(plan.or_opt_moves) || improved;
+            plan.passes++;
+            if (!improved) break;
+        }
+    } else {
+        plan.cost_nearest = plan.cost_before;
+    }
+
+    for (int node : order) plan.order.push_back(input[node]);
+    plan.cost_after = sequence_cost(plan.order);
+    plan.syncs_after = sequence_syncs(plan.order);
+    plan.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return plan;
+}
+
+// ========== SOLVER ==========
+
+double PlaylistOptimizer::cost(int a, int b) const {
+    const Node& x = nodes[a];
+    const Node& y = nodes[b];
+    int gap = gap_of(x.bpm, y.bpm, x.measured && y.measured);
+    return gap + key_cost(x.key, y.key) + (gap > bpm_tolerance ? SYNC_COST : 0.0);
+}
+
+// Cost of the transition leaving a position (0 for the last track)
+double PlaylistOptimizer::edge(size_t from_position) const {
+    return from_position + 1 < order.size() ? cost(order[from_position], order[from_position + 1]) : 0.0;
+}
+
+double PlaylistOptimizer::path_cost() const {
+    double total = 0.0;
+    for (size_t i = 0; i + 1 < order.size(); ++i) total += edge(i);
+    return total;
+}
+
+// The count cheapest partners of node (cost, then node), ascending, ignoring
+// skipped nodes. BPM gap is a lower bound on cost, so the search walks out
+// from the node's tempo in BPM order (and from half/double its tempo when it
+// has a measured grid) and stops each walk once the gap alone is too large.
+void PlaylistOptimizer::closest(int node, size_t count, const std::vector<bool>* skip,
+                                std::vector<std::pair<double, int>>& found) {
+    found.clear();
+    stamp++;
+    seen[node] = stamp;
+    const Node& x = nodes[node];
+    // Walk targets: direct, candidate at double, candidate at half the tempo
+    int targets[3] = {x.bpm, 2 * x.bpm, (x.bpm + 1) / 2};
+    size_t walks = x.measured ? 3 : 1;
+
+    for (size_t w = 0; w < walks; ++w) {
+        std::vector<int>::const_iterator middle = std::lower_bound(
+            by_bpm.begin(), by_bpm.end(), targets[w], [this](int n, int value) { return nodes[n].bpm < value; });
+        for (int direction = 0; direction < 2; ++direction) {
+            std::vector<int>::const_iterator it = middle;
+            while (direction == 0 ? it != by_bpm.end() : it != by_bpm.begin()) {
+                if (direction == 1) --it;
+                int candidate = *it;
+                if (direction == 0) ++it;
+                const Node& y = nodes[candidate];
+                int bound = w == 0 ? std::abs(y.bpm - x.bpm)
+                                   : (w == 1 ? std::abs(y.bpm - 2 * x.bpm) : std::abs(x.bpm - 2 * y.bpm));
+                if (found.size() == count && bound > found.front().first) break;
+                if (seen[candidate] == stamp || (skip && (*skip)[candidate])) continue;
+                if (w > 0 && !y.measured) continue;
+                seen[candidate] = stamp;
+                std::pair<double, int> entry(cost(node, candidate), candidate);
+                if (found.size() == count) {
+                    if (!(entry < found.front())) continue;
+                    std::pop_heap(found.begin(), found.end());
+                    found.back() = entry;
+                } else {
+                    found.push_back(entry);
+                }
+                std::push_heap(found.begin(), found.end());
+            }
+        }
+    }
+    std::sort_heap(found.begin(), found.end());
+}
+
+void PlaylistOptimizer::build_neighbours() {
+    size_t n = nodes.size();
+    size_t count = n - 1 < NEIGHBOURS ? n - 1 : NEIGHBOURS;
+    by_bpm.resize(n);
+    for (size_t i = 0; i < n; ++i) by_bpm[i] = static_cast<int>(i);
+    std::stable_sort(by_bpm.begin(), by_bpm.end(), [this](int a, int b) { return nodes[a].bpm < nodes[b].bpm; });
+    seen.assign(n, 0);
+    stamp = 0;
+
+    neighbours.assign(n, std::vector<int>());
+    std::vector<std::pair<double, int>> found;
+    for (size_t i = 0; i < n; ++i) {
+        closest(static_cast<int>(i), count, nullptr, found);
+        neighbours[i].reserve(found.size());
+        for (const std::pair<double, int>& entry : found) neighbours[i].push_back(entry.second);
+    }
+}
+
+// Greedy path from the opener: always on to the cheapest unplayed track
+void PlaylistOptimizer::nearest_neighbour() {
+    size_t n = nodes.size();
+    std::vector<bool> used(n, false);
+    std::vector<std::pair<double, int>> found;
+    int current = 0;
+    used[0] = true;
+    for (size_t step = 1; step < n; ++step) {
+        int next = -1;
+        // The first unused neighbour is cheaper than any track outside the list
+        for (int candidate : neighbours[current]) {
+            if (!used[candidate]) {
+                next = candidate;
+                break;
+            }
+        }
+        if (next < 0) {
+            closest(current, 1, &used, found);
+            next = found.front().second;
+        }
+        used[next] = true;
+        order[step] = next;
+        position[next] = static_cast<int>(step);
+        current = next;
+    }
+}
+
+void PlaylistOptimizer::reverse(size_t first, size_t last) {
+    std::reverse(order.begin() + first, order.begin() + last + 1);
+    for (size_t i = first; i <= last; ++i) position[order[i]] = static_cast<int>(i);
+}
+
+// Try joining each track to a near neighbour by reversing the stretch between them
+bool PlaylistOptimizer::two_opt_pass(size_t& moves) {
+    size_t n = order.size();
+    bool improved = false;
+    for (size_t i = 0; i < n; ++i) {
+        int a = order[i];
+        double current = edge(i);
+        for (int c : neighbours[a]) {
+            double joined = cost(a, c);
+            // Neighbours are cheapest first: past this point no new edge at a helps
+            if (i + 1 < n && joined >= current - EPSILON) break;
+            size_t j = static_cast<size_t>(position[c]);
+            double delta;
+            size_t first;
+            size_t last;
+            if (j > i + 1) {
+                // a -> [b .. c] -> d   becomes   a -> [c .. b] -> d
+                delta = joined + (j + 1 < n ? cost(order[i + 1], order[j + 1]) : 0.0) - current - edge(j);
+                first = i + 1;
+                last = j;
+            } else if (j + 1 < i) {
+                // c -> [d .. a] -> b   becomes   c -> [a .. d] -> b
+                delta = joined + (i + 1 < n ? cost(order[j + 1], order[i + 1]) : 0.0) - edge(j) - current;
+                first = j + 1;
+                last = i;
+            } else {
+                continue;
+            }
+            if (delta < -EPSILON) {
+                reverse(first, last);
+                moves++;
+                improved = true;
+                break;
+            }
+        }
+    }
+    return improved;
+}
+
+// Take a segment out and put it back next to a neighbour of one of its ends
+void PlaylistOptimizer::move_segment(size_t first, size_t length, int after, bool reversed) {
+    std::vector<int> segment(order.begin() + first, order.begin() + first + length);
+    if (reversed) std::reverse(segment.begin(), segment.end());
+    order.erase(order.begin() + first, order.begin() + first + length);
+    size_t at = static_cast<size_t>(position[after]);
+    if (at > first) at -= length;
+    order.insert(order.begin() + at + 1, segment.begin(), segment.end());
+    for (size_t i = 0; i < order.size(); ++i) position[order[i]] = static_cast<int>(i);
+}
+
+bool PlaylistOptimizer::or_opt_pass(size_t& moves) {
+    size_t n = order.size();
+    bool improved = false;
+    for (size_t length = 1; length <= MAX_SEGMENT; ++length) {
+        for (size_t i = 1; i + length <= n; ++i) {
+            int p = order[i - 1];
+            int s0 = order[i];
+            int s1 = order[i + length - 1];
+            int q = i + length < n ? order[i + length] : -1;
+            double removed = cost(p, s0) + (q >= 0 ? cost(s1, q) - cost(p, q) : 0.0);
+            if (removed <= EPSILON) continue;
+
+            bool moved = false;
+            for (int side = 0; side < 2 && !moved; ++side) {
+                int end = side == 0 ? s0 : s1;
+                for (int c : neighbours[end]) {
+                    if (cost(end, c) >= removed - EPSILON) break;
+                    size_t at = static_cast<size_t>(position[c]);
+                    if (at >= i && at < i + length) continue;
+                    // Neighbours of c once the segment is out
+                    int next = c == p ? q : (at + 1 < n ? order[at + 1] : -1);
+                    int prev = c == q ? p : (at > 0 ? order[at - 1] : -1);
+
+                    // c before the segment, end next to it; then c after it
+                    for (int place = 0; place < 2; ++place) {
+                        int a = place == 0 ? c : prev;
+                        int b = place == 0 ? next : c;
+                        if (a < 0) continue;    // nothing goes before the opener
+                        bool forward = (place == 0) == (end == s0);
+                        if (forward && a == p && b == q) continue;
+                        int in = forward ? s0 : s1;
+                        int out = forward ? s1 : s0;
+                        double added = cost(a, in) + (b >= 0 ? cost(out, b) - cost(a, b) : 0.0);
+                        if (added - removed < -EPSILON) {
+                            move_segment(i, length, a, !forward);
+                            moves++;
+                            improved = true;
+                            moved = true;
+                            break;
+                        }
+                    }
+                    if (moved) break;
+                }
+            }
+        }
+    }
+    return improved;
+}
@@ -0,0 +1,65 @@
+#include "PolyphaseResampler.h"
+#include "DspKernels.h"
+#include <cmath>
+
+static const double PI = 3.14159265358979324;
+static const double KAISER_BETA = 8.0;
+static const double CUTOFF = 0.94;      // of the lower Nyquist rate, leaves room for the transition band
+
+// Zeroth-order modified Bessel function (power series)
+static double bessel_i0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 30; ++k) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+        if (term < sum * 1e-12) break;
+    }
+    return sum;
+}
+
+PolyphaseResampler::PolyphaseResampler(double input_rate, double output_rate, bool vectorized)
+    : step(output_rate > 0.0 ? input_rate / output_rate : 1.0), coefficients((PHASES + 1) * TAPS, 0.0f),
+      use_simd(vectorized && DspKernels::vectorized()) {
+    // Downsampling moves the cutoff below the output Nyquist rate
+    double cutoff = CUTOFF * (step > 1.0 ? 1.0 / step : 1.0);
+    double window_norm = bessel_i0(KAISER_BETA);
+    for (size_t phase = 0; phase <= PHASES; ++phase) {
+        double frac = phase / static_cast<double>(PHASES);
+        float* row = &coefficients[phase * TAPS];
+        double sum = 0.0;
+        for (size_t j = 0; j < TAPS; ++j) {
+            // Distance of tap j from the output position, in input frames
+            double d = static_cast<double>(j) + 1.0 - HALF_TAPS - frac;
+            double x = cutoff * d;
+            double sinc = std::fabs(x) < 1e-9 ? 1.0 : std::sin(PI * x) / (PI * x);
+            double r = d / HALF_TAPS;
+            double window = std::fabs(r) >= 1.0 ? 0.0 : bessel_i0(KAISER_BETA * std::sqrt(1.0 - r * r)) / window_norm;
+            double value = cutoff * sinc * window;
+            row[j] = static_cast<float>(value);
+            sum += value;
+        }
+        // Unity gain at DC for every phase
+        for (size_t j = 0; j < TAPS; ++j) row[j] = static_cast<float>(row[j] / sum);
+    }
+}
+
+size_t PolyphaseResampler::process(const float* in, size_t in_frames, double& position, float* out,
+                                   size_t out_frames) const {
+    const float* table = coefficients.data();
+    size_t made = 0;
+    while (made < out_frames) {
+        size_t base = static_cast<size_t>(position);
+        if (base + HALF_TAPS >= in_frames) break;
+        double scaled = (position - base) * PHASES;
+        size_t phase = static_cast<size_t>(scaled);
+        float frac = static_cast<float>(scaled - phase);
+        const float* window = in + base + 1 - HALF_TAPS;
+        const float* low = table + phase * TAPS;
+        float a = use_simd ? DspKernels::dot(low, window, TAPS) : DspKernels::dot_scalar(low, window, TAPS);
+        float b = use_simd ? DspKernels::dot(low + TAPS, window, TAPS) : DspKernels::dot_scalar(low + TAPS, window, TAPS);
+        out[made++] = a + (b - a) * frac;
+        position += step;
+    }
+    return made;
+}
@@ -1,7 +1,12 @@
 #include "SessionFileParser.h"
+#include "HarmonicIndex.h"
+#include <cmath>
+#include <cstdlib>
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <limits>
+#include <stdexcept>
 
 // ========== PUBLIC METHODS (PROVIDED FOR STUDENTS) ==========
 
@@ -51,6 +56,69 @@ bool SessionFileParser::parse_config_file(const std::string& config_path, Sessio
                     std::cout << "[WARNING] Invalid cache size at line " << line_number << std::endl;
                 }
                 
+            } else if (key == "library_build_threads") {
+                try {
+                    config.library_build_threads = std::stoi(value);
+                } catch (const std::exception& e) {
+                    std::cout << "[WARNING] Invalid library build thread count at line " << line_number << std::endl;
+                }
+                
+            } else if (key == "waveform_memory_budget") {
+                try {
+                    config.waveform_memory_budget = parse_byte_size(value);
+                } catch (const std::exception& e) {
+                    std::cout << "[WARNING] Invalid waveform memory budget at line " << line_number << std::endl;
+                }
+                
+            } else if (key == "waveform_format") {
+                config.waveform_format_mp3 = value;
+                config.waveform_format_wav = value;
+                
+            } else if (key == "waveform_format_mp3") {
+                config.waveform_format_mp3 = value;
+                
+            } else if (key == "waveform_format_wav") {
+                config.waveform_format_wav = value;
+                
+            } else if (key == "controller_cache_shards") {
+                try {
+                    config.controller_cache_shards = std::stoi(value);
+                } catch (const std::exception& e) {
+                    std::cout << "[WARNING] Invalid cache shard count at line " << line_number << std::endl;
+                }
+                
+            } else if (key == "controller_cache_bytes") {
+                try {
+                    config.controller_cache_bytes = parse_byte_size(value);
+                } catch (const std::exception& e) {
+                    std::cout << "[WARNING] Invalid cache byte budget at line " << line_number << std::endl;
+                }
+                
+            } else if (key == "controller_cache_policy") {
+                config.controller_cache_policy = value;
+                
+            } else if (key == "controller_cache_compare_policies") {
+                config.controller_cache_compare_policies = parse_bool(value);
+                
+            } else if (key == "controller_prefetch_depth") {
+                try {
+                    config.controller_prefetch_depth = std::stoi(value);
+                } catch (const std::exception& e) {
+                    std::cout << "[WARNING] Invalid prefetch depth at line " << line_number << std::endl;
+                }
+                
+            } else if (key == "session_trace_file") {
+                config.session_trace_file = value;
+                
+            } else if (key == "session_allocation_stats") {
+                config.session_allocation_stats = parse_bool(value);
+                
+            } else if (key == "session_pipeline") {
+                config.session_pipeline = parse_bool(value);
+                
+            } else if (key == "analysis_cache_file") {
+                config.analysis_cache_file = value;
+                
             } else if (key == "bpm_tolerance") {
                 try {
                     config.bpm_tolerance = std::stoi(value);
@@ -61,6 +129,54 @@ bool SessionFileParser::parse_config_file(const std::string& config_path, Sessio
             } else if (key == "auto_sync") {
                 config.auto_sync = parse_bool(value);
                 
+            } else if (key == "default_crossfade_time") {
+                try {
+                    config.default_crossfade_time = std::stoi(value);
+                } catch (const std::exception& e) {
+                    std::cout << "[WARNING] Invalid crossfade time at line " << line_number << std::endl;
+                }
+                
+            } else if (key == "mixer_deck_count") {
+                try {
+                    config.mixer_deck_count = std::stoi(value);
+                } catch (const std::exception& e) {
+                    std::cout << "[WARNING] Invalid mixer deck count at line " << line_number << std::endl;
+                }
+                
+            } else if (key == "mixer_deck_scheduler") {
+                config.mixer_deck_scheduler = value;
+                
+            } else if (key == "mixer_suggestions") {
+                try {
+                    config.mixer_suggestions = std::stoi(value);
+                } catch (const std::exception& e) {
+                    std::cout << "[WARNING] Invalid mixer suggestion count at line " << line_number << std::endl;
+                }
+                
+            } else if (key == "mixer_energy_tolerance") {
+                try {
+                    config.mixer_energy_tolerance = std::stoi(value);
+                } catch (const std::exception& e) {
+                    std::cout << "[WARNING] Invalid mixer energy tolerance at line " << line_number << std::endl;
+                }
+                
+            } else if (key == "mixer_render_sink") {
+                config.mixer_render_sink = value;
+                
+            } else if (key == "mixer_block_frames") {
+                try {
+                    config.mixer_block_frames = std::stoi(value);
+                } catch (const std::exception& e) {
+                    std::cout << "[WARNING] Invalid mixer block size at line " << line_number << std::endl;
+                }
+                
+            } else if (key == "mixer_sample_rate") {
+                try {
+                    config.mixer_sample_rate = std::stoi(value);
+                } catch (const std::exception& e) {
+                    std::cout << "[WARNING] Invalid mixer sample rate at line " << line_number << std::endl;
+                }
+                
             } else {
                 // Check if it's a playlist definition (any other key=value where value contains numbers/commas)
                 std::string playlist_name;
@@ -156,6 +272,30 @@ bool SessionFileParser::parse_bool(const std::string& str) {
     return (lower_str == "true" || lower_str == "1" || lower_str == "yes");
 }
 
+size_t SessionFileParser::parse_byte_size(const std::string& str) {
+    size_t consumed = 0;
+    double number = std::stod(str, &consumed);
+    if (!std::isfinite(number)) {
+        throw std::invalid_argument("byte size is not a finite number");
+    }
+    if (number < 0) {
+        throw std::invalid_argument("negative byte size");
+    }
+
+    std::string suffix = trim_string(str.substr(consumed));
+    std::transform(suffix.begin(), suffix.end(), suffix.begin(), ::toupper);
+    if (suffix == "K" || suffix == "KB") number *= 1024.0;
+    else if (suffix == "M" || suffix == "MB") number *= 1024.0 * 1024.0;
+    else if (suffix == "G" || suffix == "GB") number *= 1024.0 * 1024.0 * 1024.0;
+    else if (!suffix.empty() && suffix != "B") throw std::invalid_argument("unknown size suffix");
+
+    // The conversion below is only defined for values size_t can hold
+    if (number >= static_cast<double>(std::numeric_limits<size_t>::max())) {
+        throw std::invalid_argument("byte size too large");
+    }
+    return static_cast<size_t>(number);
+}
+
 bool SessionFileParser::is_comment_line(const std::string& line) {
     return !line.empty() && line[0] == '#';
 }
@@ -194,6 +334,21 @@ bool SessionFileParser::parse_library_track(const std::string& line, SessionConf
         track_info.extra_param1 = std::stoi(parts[5]);  // bitrate or sample_rate
         track_info.extra_param2 = std::stoi(parts[6]);  // has_tags or bit_depth
         
+        // Optional name=value attributes; unknown names are ignored
+        for (size_t i = 7; i < parts.size(); ++i) {
+            std::string name;
+            std::string value;
+            if (!parse_key_value(parts[i], name, value)) continue;
+            if (name == "path") {
+                track_info.file_path = value;
+            } else if (name == "key") {
+                track_info.key = HarmonicIndex::parse_key(value);
+            } else if (name == "energy") {
+                int energy = std::atoi(value.c_str());
+                track_info.energy = energy >= 1 && energy <= HarmonicIndex::MAX_ENERGY ? energy : 0;
+            }
+        }
+        
         // Validate track type is MP3 or WAV
         if (track_info.type != "MP3" && track_info.type != "WAV") {
             return false;
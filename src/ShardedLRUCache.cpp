@@ -0,0 +1,176 @@
+#include "ShardedLRUCache.h"
+#include "LogSink.h"
+#include <iostream>
+#include <functional>
+
+ShardedLRUCache::ShardedLRUCache(size_t capacity, size_t shard_count, const std::string& policy_name)
+    : shards(), max_size(0), max_bytes(0), policy("lru") {
+    PointerWrapper<CachePolicy> probe = make_cache_policy(policy_name);
+    if (probe) policy = probe->name();
+    buildShards(capacity, shard_count);
+}
+
+bool ShardedLRUCache::contains(const std::string& track_id) const {
+    Shard& shard = shardFor(track_id);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.cache.contains(track_id);
+}
+
+AudioTrack* ShardedLRUCache::get(const std::string& track_id) {
+    Shard& shard = shardFor(track_id);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.cache.get(track_id);
+}
+
+PointerWrapper<AudioTrack> ShardedLRUCache::getClone(const std::string& track_id) {
+    Shard& shard = shardFor(track_id);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    AudioTrack* track = shard.cache.get(track_id);
+    if (!track) return PointerWrapper<AudioTrack>();
+    return track->clone();
+}
+
+bool ShardedLRUCache::put(PointerWrapper<AudioTrack> track) {
+    if (!track) return false;
+    Shard& shard = shardFor(track->get_title());
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.cache.put(std::move(track));
+}
+
+bool ShardedLRUCache::evictLRU() {
+    // Pick the fullest shard; sizes may move under us, which only affects the choice
+    size_t fullest = 0;
+    size_t fullest_size = 0;
+    for (size_t i = 0; i < shards.size(); ++i) {
+        std::lock_guard<std::mutex> guard(shards[i]->lock);
+        size_t s = shards[i]->cache.size();
+        if (s > fullest_size) {
+            fullest = i;
+            fullest_size = s;
+        }
+    }
+    if (fullest_size == 0) return false;
+
+    std::lock_guard<std::mutex> guard(shards[fullest]->lock);
+    return shards[fullest]->cache.evictLRU();
+}
+
+size_t ShardedLRUCache::size() const {
+    size_t total = 0;
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> guard(shard->lock);
+        total += shard->cache.size();
+    }
+    return total;
+}
+
+void ShardedLRUCache::set_byte_budget(size_t bytes) {
+    max_bytes = bytes;
+    for (size_t i = 0; i < shards.size(); ++i) {
+        std::lock_guard<std::mutex> guard(shards[i]->lock);
+        shards[i]->cache.set_byte_budget(shardCapacity(bytes, shards.size(), i));
+    }
+}
+
+size_t ShardedLRUCache::bytes_used() const {
+    size_t total = 0;
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> guard(shard->lock);
+        total += shard->cache.bytes_used();
+    }
+    return total;
+}
+
+size_t ShardedLRUCache::bytes_evicted() const {
+    size_t total = 0;
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> guard(shard->lock);
+        total += shard->cache.bytes_evicted();
+    }
+    return total;
+}
+
+size_t ShardedLRUCache::eviction_count() const {
+    size_t total = 0;
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> guard(shard->lock);
+        total += shard->cache.eviction_count();
+    }
+    return total;
+}
+
+void ShardedLRUCache::clear() {
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> guard(shard->lock);
+        shard->cache.clear();
+    }
+}
+
+void ShardedLRUCache::displayStatus() const {
+    if (shards.size() == 1) {
+        std::lock_guard<std::mutex> guard(shards[0]->lock);
+        shards[0]->cache.displayStatus();
+        return;
+    }
+
+    LogSink::out() << "[ShardedLRUCache] " << shards.size() << " shards, "
+              << size() << "/" << max_size << " slots used\n";
+    if (max_bytes > 0) {
+        LogSink::out() << "Memory: " << bytes_used() << "/" << max_bytes << " bytes used, "
+                  << bytes_evicted() << " bytes evicted\n";
+    }
+    for (size_t i = 0; i < shards.size(); ++i) {
+        std::lock_guard<std::mutex> guard(shards[i]->lock);
+        LogSink::out() << "Shard " << i << ": ";
+        shards[i]->cache.displayStatus();
+    }
+}
+
+bool ShardedLRUCache::configure(size_t capacity, size_t shard_count, const std::string& policy_name) {
+    PointerWrapper<CachePolicy> probe = make_cache_policy(policy_name);
+    bool known = static_cast<bool>(probe);
+    std::string requested = known ? probe->name() : "lru";
+
+    if (shard_count == 0) shard_count = 1;
+    if (capacity > 0 && shard_count > capacity) shard_count = capacity;
+
+    if (shard_count == shards.size() && requested == policy) {
+        // Same layout: resize shards in place and keep their entries
+        for (size_t i = 0; i < shards.size(); ++i) {
+            shards[i]->cache.set_capacity(shardCapacity(capacity, shard_count, i));
+        }
+        max_size = capacity;
+        return known;
+    }
+    policy = requested;
+    buildShards(capacity, shard_count);
+    return known;
+}
+
+ShardedLRUCache::Shard& ShardedLRUCache::shardFor(const std::string& track_id) const {
+    if (shards.size() == 1) return *shards[0];
+    return *shards[std::hash<std::string>()(track_id) % shards.size()];
+}
+
+void ShardedLRUCache::buildShards(size_t capacity, size_t shard_count) {
+    if (shard_count == 0) shard_count = 1;
+    if (capacity > 0 && shard_count > capacity) shard_count = capacity;
+
+    shards.clear();
+    for (size_t i = 0; i < shard_count; ++i) {
+        shards.push_back(PointerWrapper<Shard>(new Shard(shardCapacity(capacity, shard_count, i), newPolicy())));
+    }
+    max_size = capacity;
+    if (max_bytes > 0) set_byte_budget(max_bytes);
+}
+
+PointerWrapper<CachePolicy> ShardedLRUCache::newPolicy() const {
+    PointerWrapper<CachePolicy> created = make_cache_policy(policy);
+    if (!created) created.reset(new LRUPolicy());
+    return created;
+}
+
+// Spread the remainder over the first shards so the total matches exactly
+size_t ShardedLRUCache::shardCapacity(size_t capacity, size_t shard_count, size_t shard) {
+    return capacity / shard_count + (shard < capacity % shard_count ? 1 : 0);
+}
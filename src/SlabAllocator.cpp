@@ -0,0 +1,63 @@
+#include "SlabAllocator.h"
+#include <atomic>
+#include <new>
+
+const size_t BufferSlabs::MIN_POOLED;
+const size_t BufferSlabs::MAX_POOLED;
+
+static std::atomic<size_t> oversized(0);
+
+/**
+ * One pool per power-of-two class from MIN_POOLED to MAX_POOLED; each slab
+ * holds at least 256 KB so small classes do not refill constantly.
+ */
+struct SizeClasses {
+    static const size_t COUNT = 11;     // 64 B .. 64 KB
+    BlockPool* pools[COUNT];
+
+    SizeClasses() : pools() {
+        for (size_t i = 0; i < COUNT; ++i) {
+            size_t block = BufferSlabs::MIN_POOLED << i;
+            size_t per_slab = (256 * 1024) / block;
+            pools[i] = new BlockPool(block, per_slab < 4 ? 4 : per_slab);
+        }
+    }
+
+    ~SizeClasses() {
+        for (size_t i = 0; i < COUNT; ++i) delete pools[i];
+    }
+
+private:
+    SizeClasses(const SizeClasses&);
+    SizeClasses& operator=(const SizeClasses&);
+};
+
+BlockPool* BufferSlabs::pool_for(size_t bytes) {
+    static SizeClasses classes;
+    if (bytes > MAX_POOLED) return nullptr;
+    size_t index = 0;
+    size_t block = MIN_POOLED;
+    while (block < bytes) {
+        block <<= 1;
+        ++index;
+    }
+    return classes.pools[index];
+}
+
+void* BufferSlabs::allocate(size_t bytes) {
+    BlockPool* pool = pool_for(bytes);
+    if (pool) return pool->allocate();
+    oversized++;
+    return ::operator new(bytes);
+}
+
+void BufferSlabs::deallocate(void* buffer, size_t bytes) {
+    if (!buffer) return;
+    BlockPool* pool = pool_for(bytes);
+    if (pool) pool->deallocate(buffer);
+    else ::operator delete(buffer);
+}
+
+size_t BufferSlabs::heap_allocations() {
+    return oversized;
+}
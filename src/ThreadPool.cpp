@@ -0,0 +1,62 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(size_t threads)
+    : workers(), tasks(), active(0), stopping(false), first_error(),
+      lock(), task_ready(), all_done() {
+    if (threads == 0) threads = 1;
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers.push_back(std::thread(&ThreadPool::run, this));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    task_ready.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        tasks.push_back(std::move(task));
+    }
+    task_ready.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> guard(lock);
+    all_done.wait(guard, [this] { return tasks.empty() && active == 0; });
+    if (first_error) {
+        std::exception_ptr error = first_error;
+        first_error = std::exception_ptr();
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::run() {
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        task_ready.wait(guard, [this] { return stopping || !tasks.empty(); });
+        if (tasks.empty()) return;      // stopping and drained
+
+        std::function<void()> task = std::move(tasks.front());
+        tasks.pop_front();
+        active++;
+        guard.unlock();
+
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard<std::mutex> error_guard(lock);
+            if (!first_error) first_error = std::current_exception();
+        }
+
+        guard.lock();
+        active--;
+        if (tasks.empty() && active == 0) all_done.notify_all();
+    }
+}
@@ -0,0 +1,178 @@
+#include "TimeStretcher.h"
+#include "DspKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+const double TimeStretcher::MIN_RATIO = 0.5;
+const double TimeStretcher::MAX_RATIO = 2.0;
+
+static const double PI = 3.14159265358979324;
+static const size_t COARSE_STEP = 8;    // search stride before refining around the best offset
+
+TimeStretcher::TimeStretcher(int sample_rate, size_t max_block, bool vectorized)
+    : window(sample_rate > 48000 ? 2048 : 1024), hop(window / 2), tolerance(window / 4), max_block(max_block),
+      ratio(1.0), use_simd(vectorized && DspKernels::vectorized()), hann(window), in_left(), in_right(), in_mono(),
+      in_count(0), next_position(0.0), previous(0), have_previous(false), energy(window + 2, 0.0),
+      overlap_left(window, 0.0f), overlap_right(window, 0.0f), output(), out_read(0), out_count(0), segments(0) {
+    // Periodic Hann: copies hop frames apart sum to exactly 1
+    for (size_t i = 0; i < window; ++i) {
+        hann[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * PI * i / window));
+    }
+    // What is kept between segments never exceeds hop + 2 * tolerance + window frames
+    size_t capacity = 4 * window;
+    in_left.assign(capacity, 0.0f);
+    in_right.assign(capacity, 0.0f);
+    in_mono.assign(capacity, 0.0f);
+    output.assign((max_block + 2 * hop) * 2, 0.0f);
+}
+
+void TimeStretcher::reset() {
+    in_count = 0;
+    next_position = 0.0;
+    previous = 0;
+    have_previous = false;
+    std::fill(overlap_left.begin(), overlap_left.end(), 0.0f);
+    std::fill(overlap_right.begin(), overlap_right.end(), 0.0f);
+    out_read = 0;
+    out_count = 0;
+}
+
+void TimeStretcher::set_ratio(double value) {
+    if (!(value >= MIN_RATIO)) value = MIN_RATIO;
+    if (value > MAX_RATIO) value = MAX_RATIO;
+    ratio = value;
+}
+
+size_t TimeStretcher::input_wanted() const {
+    size_t nominal = static_cast<size_t>(next_position + 0.5);
+    size_t needed = nominal + window + (have_previous ? tolerance : 0);
+    return needed > in_count ? needed - in_count : 0;
+}
+
+size_t TimeStretcher::push(const float* left, const float* right, size_t frames) {
+    size_t taken = 0;
+    while (true) {
+        size_t room = in_left.size() - in_count;
+        size_t count = std::min(room, frames - taken);
+        for (size_t i = 0; i < count; ++i) {
+            float l = left[taken + i];
+            float r = right[taken + i];
+            in_left[in_count + i] = l;
+            in_right[in_count + i] = r;
+            in_mono[in_count + i] = 0.5f * (l + r);
+        }
+        in_count += count;
+        taken += count;
+
+        bool made = false;
+        while (make_segment()) made = true;
+        if (taken == frames || !made) break;
+    }
+    return taken;
+}
+
+size_t TimeStretcher::pull(float* out, size_t frames) {
+    size_t count = std::min(frames, out_count);
+    std::memcpy(out, &output[out_read * 2], count * 2 * sizeof(float));
+    out_read += count;
+    out_count -= count;
+    if (out_count == 0) out_read = 0;
+    return count;
+}
+
+bool TimeStretcher::make_segment() {
+    if (input_wanted() > 0) return false;
+    size_t capacity = output.size() / 2;
+    if (out_count + hop > capacity) return false;
+
+    size_t nominal = static_cast<size_t>(next_position + 0.5);
+    size_t start = nominal;
+    if (have_previous) {
+        size_t low = nominal > tolerance ? nominal - tolerance : 0;
+        start = find_offset(low, nominal + tolerance, previous + hop);
+    }
+
+    if (use_simd) {
+        DspKernels::multiply_add(overlap_left.data(), &in_left[start], hann.data(), window);
+        DspKernels::multiply_add(overlap_right.data(), &in_right[start], hann.data(), window);
+    } else {
+        DspKernels::multiply_add_scalar(overlap_left.data(), &in_left[start], hann.data(), window);
+        DspKernels::multiply_add_scalar(overlap_right.data(), &in_right[start], hann.data(), window);
+    }
+
+    // The first hop frames now have both of their segments
+    if (out_read + out_count + hop > capacity) {
+        std::memmove(output.data(), &output[out_read * 2], out_count * 2 * sizeof(float));
+        out_read = 0;
+    }
+    float* dest = &output[(out_read + out_count) * 2];
+    if (use_simd) DspKernels::interleave(overlap_left.data(), overlap_right.data(), dest, hop);
+    else DspKernels::interleave_scalar(overlap_left.data(), overlap_right.data(), dest, hop);
+    out_count += hop;
+    std::memmove(overlap_left.data(), &overlap_left[hop], (window - hop) * sizeof(float));
+    std::memmove(overlap_right.data(), &overlap_right[hop], (window - hop) * sizeof(float));
+    std::fill(overlap_left.begin() + (window - hop), overlap_left.end(), 0.0f);
+    std::fill(overlap_right.begin() + (window - hop), overlap_right.end(), 0.0f);
+
+    previous = start;
+    have_previous = true;
+    next_position += hop * ratio;
+    segments++;
+    discard_consumed();
+    return true;
+}
+
+// Normalized cross-correlation of hop frames at candidate with the frames at target
+float TimeStretcher::similarity(size_t candidate, size_t target, size_t low) const {
+    const float* a = &in_mono[candidate];
+    const float* b = &in_mono[target];
+    float dot = use_simd ? DspKernels::dot(a, b, hop) : DspKernels::dot_scalar(a, b, hop);
+    double power = energy[candidate - low + hop] - energy[candidate - low];
+    return static_cast<float>(dot / std::sqrt(power + 1e-9));
+}
+
+size_t TimeStretcher::find_offset(size_t low, size_t high, size_t target) {
+    // Candidate energies in O(1) each from prefix sums over the search range
+    energy[0] = 0.0;
+    for (size_t i = low; i < high + hop; ++i) {
+        double x = in_mono[i];
+        energy[i - low + 1] = energy[i - low] + x * x;
+    }
+
+    size_t best = low;
+    float best_score = similarity(low, target, low);
+    for (size_t c = low + COARSE_STEP; c <= high; c += COARSE_STEP) {
+        float score = similarity(c, target, low);
+        if (score > best_score) {
+            best_score = score;
+            best = c;
+        }
+    }
+    size_t from = best > low + COARSE_STEP - 1 ? best - (COARSE_STEP - 1) : low;
+    size_t to = std::min(high, best + COARSE_STEP - 1);
+    for (size_t c = from; c <= to; ++c) {
+        float score = similarity(c, target, low);
+        if (score > best_score) {
+            best_score = score;
+            best = c;
+        }
+    }
+    return best;
+}
+
+// Keep only what the next search can still reach
+void TimeStretcher::discard_consumed() {
+    double earliest = next_position - tolerance;
+    size_t drop = earliest > 0.0 ? static_cast<size_t>(earliest) : 0;
+    drop = std::min(drop, previous + hop);
+    drop = std::min(drop, in_count);
+    if (drop == 0) return;
+    size_t keep = in_count - drop;
+    std::memmove(in_left.data(), &in_left[drop], keep * sizeof(float));
+    std::memmove(in_right.data(), &in_right[drop], keep * sizeof(float));
+    std::memmove(in_mono.data(), &in_mono[drop], keep * sizeof(float));
+    in_count = keep;
+    next_position -= drop;
+    previous -= drop;
+}
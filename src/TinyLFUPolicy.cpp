@@ -0,0 +1,158 @@
+#include "TinyLFUPolicy.h"
+#include <algorithm>
+#include <functional>
+
+// ========== FrequencySketch ==========
+
+void FrequencySketch::resize(size_t expected_entries) {
+    width = 16;
+    while (width < expected_entries) width <<= 1;
+    table.assign(DEPTH * width, 0);
+    additions = 0;
+    sample_size = 10 * width;
+}
+
+size_t FrequencySketch::indexOf(uint64_t hash, size_t row) const {
+    static const uint64_t seeds[DEPTH] = {
+        0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL,
+        0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL
+    };
+    uint64_t h = (hash + seeds[row]) * 0x9E3779B97F4A7C15ULL;
+    h ^= h >> 32;
+    return row * width + static_cast<size_t>(h & (width - 1));
+}
+
+void FrequencySketch::increment(const std::string& key) {
+    if (width == 0) return;
+    uint64_t hash = std::hash<std::string>()(key);
+    for (size_t row = 0; row < DEPTH; ++row) {
+        uint8_t& counter = table[indexOf(hash, row)];
+        if (counter < 15) counter++;
+    }
+    if (++additions >= sample_size) age();
+}
+
+unsigned FrequencySketch::frequency(const std::string& key) const {
+    if (width == 0) return 0;
+    uint64_t hash = std::hash<std::string>()(key);
+    unsigned result = 15;
+    for (size_t row = 0; row < DEPTH; ++row) {
+        result = std::min<unsigned>(result, table[indexOf(hash, row)]);
+    }
+    return result;
+}
+
+// Halve every counter so the sketch tracks recent popularity
+void FrequencySketch::age() {
+    for (uint8_t& counter : table) counter >>= 1;
+    additions /= 2;
+}
+
+// ========== TinyLFUPolicy ==========
+
+TinyLFUPolicy::TinyLFUPolicy()
+    : capacity(0), window_capacity(0), protected_capacity(0),
+      window(), probation(), protected_list(), segment(), sketch() {}
+
+void TinyLFUPolicy::reset(size_t new_capacity) {
+    capacity = new_capacity;
+    window_capacity = std::max<size_t>(1, capacity / 100);
+    size_t main_capacity = capacity > window_capacity ? capacity - window_capacity : 0;
+    protected_capacity = main_capacity * 80 / 100;
+
+    window.reset();
+    probation.reset();
+    protected_list.reset();
+    segment.assign(capacity, NONE);
+    sketch.resize(capacity);
+}
+
+void TinyLFUPolicy::on_hit(std::vector<CacheSlot>& slots, size_t slot) {
+    ensureSlot(slot);
+    sketch.increment(slots[slot].getKey());
+
+    switch (segment[slot]) {
+    case WINDOW:
+        window.move_to_front(slots, slot);
+        break;
+    case PROBATION:
+        // Second chance earned: promote, demoting protected's LRU if it overflows
+        moveTo(slots, slot, PROTECTED);
+        if (protected_list.size() > protected_capacity) {
+            moveTo(slots, protected_list.back(), PROBATION);
+        }
+        break;
+    case PROTECTED:
+        protected_list.move_to_front(slots, slot);
+        break;
+    default:
+        break;
+    }
+}
+
+void TinyLFUPolicy::before_insert(const std::string& key) {
+    sketch.increment(key);
+}
+
+size_t TinyLFUPolicy::select_victim(std::vector<CacheSlot>& slots) {
+    bool main_empty = probation.empty() && protected_list.empty();
+    if (window.empty()) return mainVictim();
+    if (main_empty) return window.back();
+    if (window.size() < window_capacity) return mainVictim();
+
+    // Admission: the window's LRU candidate must beat the main area's victim
+    size_t candidate = window.back();
+    size_t victim = mainVictim();
+    if (sketch.frequency(slots[candidate].getKey()) > sketch.frequency(slots[victim].getKey())) {
+        moveTo(slots, candidate, PROBATION);
+        return victim;
+    }
+    return candidate;
+}
+
+void TinyLFUPolicy::on_evict(std::vector<CacheSlot>& slots, size_t slot) {
+    ensureSlot(slot);
+    if (segment[slot] != NONE) {
+        listFor(static_cast<Segment>(segment[slot])).unlink(slots, slot);
+    }
+    segment[slot] = NONE;
+}
+
+void TinyLFUPolicy::on_insert(std::vector<CacheSlot>& slots, size_t slot) {
+    ensureSlot(slot);
+    window.push_front(slots, slot);
+    segment[slot] = WINDOW;
+
+    // While the cache is filling up, window overflow moves straight to main
+    while (window.size() > window_capacity) {
+        moveTo(slots, window.back(), PROBATION);
+    }
+}
+
+PointerWrapper<CachePolicy> TinyLFUPolicy::create_empty() const {
+    return PointerWrapper<CachePolicy>(new TinyLFUPolicy());
+}
+
+void TinyLFUPolicy::ensureSlot(size_t slot) {
+    if (slot >= segment.size()) segment.resize(slot + 1, NONE);
+}
+
+void TinyLFUPolicy::moveTo(std::vector<CacheSlot>& slots, size_t slot, Segment target) {
+    if (segment[slot] != NONE) {
+        listFor(static_cast<Segment>(segment[slot])).unlink(slots, slot);
+    }
+    listFor(target).push_front(slots, slot);
+    segment[slot] = target;
+}
+
+CacheSlotList& TinyLFUPolicy::listFor(Segment seg) {
+    if (seg == WINDOW) return window;
+    if (seg == PROBATION) return probation;
+    return protected_list;
+}
+
+size_t TinyLFUPolicy::mainVictim() const {
+    if (!probation.empty()) return probation.back();
+    if (!protected_list.empty()) return protected_list.back();
+    return window.back();
+}
@@ -0,0 +1,135 @@
+#include "TrackPrefetcher.h"
+#include "LogSink.h"
+#include <sstream>
+
+TrackPrefetcher::TrackPrefetcher()
+    : max_depth(0), pending(), staged(), in_flight(), busy(false), stopping(false), stats(),
+      lock(), work_ready(), work_done(), worker() {}
+
+TrackPrefetcher::~TrackPrefetcher() {
+    stop();
+}
+
+void TrackPrefetcher::set_depth(size_t depth) {
+    if (depth == 0) {
+        stop();
+        discard_all();
+        max_depth = 0;
+        return;
+    }
+    max_depth = depth;
+    if (!worker.joinable()) {
+        stopping = false;
+        worker = std::thread(&TrackPrefetcher::run, this);
+    }
+}
+
+void TrackPrefetcher::request(const AudioTrack& track) {
+    if (!enabled()) return;
+    std::lock_guard<std::mutex> guard(lock);
+    const std::string& title = track.get_title();
+    if ((busy && in_flight == title) || staged.count(title)) return;
+    for (const AudioTrack* queued : pending) {
+        if (queued->get_title() == title) return;
+    }
+    pending.push_back(&track);
+    stats.requested++;
+    work_ready.notify_one();
+}
+
+PointerWrapper<AudioTrack> TrackPrefetcher::take(const std::string& title, std::string& log) {
+    if (!enabled()) return PointerWrapper<AudioTrack>();
+    std::unique_lock<std::mutex> guard(lock);
+
+    // Still queued: the caller is about to do the work itself
+    for (auto it = pending.begin(); it != pending.end(); ++it) {
+        if ((*it)->get_title() == title) {
+            pending.erase(it);
+            return PointerWrapper<AudioTrack>();
+        }
+    }
+
+    bool was_in_flight = busy && in_flight == title;
+    if (was_in_flight) {
+        work_done.wait(guard, [this, &title] { return !(busy && in_flight == title); });
+    }
+
+    auto found = staged.find(title);
+    if (found == staged.end()) return PointerWrapper<AudioTrack>();
+
+    PointerWrapper<AudioTrack> track = std::move(found->second.track);
+    log.swap(found->second.log);
+    staged.erase(found);
+    stats.hits++;
+    if (was_in_flight) stats.waited++;
+    return track;
+}
+
+void TrackPrefetcher::discard(const std::string& title) {
+    if (!enabled()) return;
+    std::lock_guard<std::mutex> guard(lock);
+    for (auto it = pending.begin(); it != pending.end(); ++it) {
+        if ((*it)->get_title() == title) {
+            pending.erase(it);
+            return;
+        }
+    }
+    if (staged.erase(title)) stats.wasted++;
+}
+
+void TrackPrefetcher::discard_all() {
+    std::unique_lock<std::mutex> guard(lock);
+    pending.clear();
+    // Let the worker finish its current track so it does not outlive the request
+    work_done.wait(guard, [this] { return !busy; });
+    stats.wasted += staged.size();
+    staged.clear();
+}
+
+PrefetchStats TrackPrefetcher::get_stats() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return stats;
+}
+
+void TrackPrefetcher::run() {
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        work_ready.wait(guard, [this] { return stopping || !pending.empty(); });
+        if (stopping) return;
+
+        const AudioTrack* source = pending.front();
+        pending.pop_front();
+        in_flight = source->get_title();
+        busy = true;
+        guard.unlock();
+
+        // Same work as a controller cache miss, with its log kept aside
+        std::ostringstream log;
+        PointerWrapper<AudioTrack> track = source->clone();
+        if (track) {
+            LogSink::Capture capture(log);
+            track->load();
+            track->analyze_beatgrid();
+        }
+
+        guard.lock();
+        if (track) {
+            Staged& slot = staged[in_flight];
+            slot.track = std::move(track);
+            slot.log = log.str();
+            stats.completed++;
+        }
+        busy = false;
+        in_flight.clear();
+        work_done.notify_all();
+    }
+}
+
+void TrackPrefetcher::stop() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    if (worker.joinable()) worker.join();
+}
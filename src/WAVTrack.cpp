@@ -1,40 +1,138 @@
 #include "WAVTrack.h"
+#include "AnalysisCache.h"
+#include "LogSink.h"
+#include <iomanip>
 #include <iostream>
+#include <sstream>
+
+WaveformFormat WAVTrack::default_waveform_format = WAVEFORM_F64;
+
+static BlockPool& track_pool() {
+    static BlockPool pool(sizeof(WAVTrack), 256);
+    return pool;
+}
+
+void* WAVTrack::operator new(size_t size) {
+    if (size != sizeof(WAVTrack)) return ::operator new(size);
+    return track_pool().allocate();
+}
+
+void WAVTrack::operator delete(void* block, size_t size) {
+    if (size != sizeof(WAVTrack)) ::operator delete(block);
+    else track_pool().deallocate(block);
+}
+
+BlockPoolStats WAVTrack::get_pool_stats() {
+    return track_pool().get_stats();
+}
 
 WAVTrack::WAVTrack(const std::string& title, const std::vector<std::string>& artists, 
-                   int duration, int bpm, int sample_rate, int bit_depth)
-    : AudioTrack(title, artists, duration, bpm), sample_rate(sample_rate), bit_depth(bit_depth) {
+                   int duration, int bpm, int sample_rate, int bit_depth, const std::string& file_path)
+    : AudioTrack(title, artists, duration, bpm), sample_rate(sample_rate), bit_depth(bit_depth),
+      file(file_path.empty() ? nullptr : std::make_shared<WavFile>(file_path)) {
+    set_waveform_format(default_waveform_format);
 
-    std::cout << "WAVTrack created: " << sample_rate << "Hz/" << bit_depth << "bit" << std::endl;
+    LogSink::out() << "WAVTrack created: " << sample_rate << "Hz/" << bit_depth << "bit" << std::endl;
 }
 
 // ========== TODO: STUDENTS IMPLEMENT THESE VIRTUAL FUNCTIONS ==========
 
 void WAVTrack::load() {
+    // The header is authoritative over the config metadata
+    bool mapped = read_header(sample_rate, bit_depth, duration_seconds);
+    print_load(mapped, sample_rate, bit_depth, duration_seconds);
+}
+
+bool WAVTrack::read_header(int& rate, int& depth, int& seconds) const {
+    if (!file || !file->open()) return false;
+    rate = file->sample_rate();
+    depth = file->bit_depth();
+    seconds = static_cast<int>(file->duration_seconds() + 0.5);
+    return true;
+}
+
+void WAVTrack::print_load(bool mapped, int rate, int depth, int seconds) const {
     // TODO: Implement realistic WAV loading simulation
     // NOTE: Use exactly 2 spaces before the arrow (→) character
-    std::cout << "[WAVTrack::load] Loading WAV: \"" << title 
-              << "\" at " << sample_rate << "Hz/" << bit_depth<< "bit (uncompressed)..." << std::endl;
-    
-    long long size = (long long)duration_seconds * sample_rate * (bit_depth /8) * 2;
+    LogSink::out() << "[WAVTrack::load] Loading WAV: \"" << get_title() 
+              << "\" at " << rate << "Hz/" << depth<< "bit (uncompressed)..." << std::endl;
     
-    std::cout << "  → Estimated file size: " << size << " bytes" << std::endl;
+    if (mapped) {
+        LogSink::out() << "  → Mapped file: " << file->get_path() << " (" << file->file_bytes() << " bytes, "
+                       << file->frame_count() << " frames, " << file->channels() << " ch)" << std::endl;
+    } else {
+        if (file) {
+            LogSink::out() << "  → [WARNING] Cannot read " << file->get_path() << ": " << file->get_error()
+                           << "; using configured format" << std::endl;
+        }
+        long long size = (long long)seconds * rate * (depth /8) * 2;
+        LogSink::out() << "  → Estimated file size: " << size << " bytes" << std::endl;
+    }
     
-    std::cout << "  → Fast loading due to uncompressed format." << std::endl;
+    LogSink::out() << "  → Fast loading due to uncompressed format." << std::endl;
 
 }
 
 void WAVTrack::analyze_beatgrid() {
-    std::cout << "[WAVTrack::analyze_beatgrid] Analyzing beat grid for: \"" << title << "\"\n";
+    std::shared_ptr<const BeatGrid> grid = measure_grid();
+    if (grid && grid->valid()) {
+        // The measured tempo replaces the metadata BPM for mixing
+        beat_grid = grid;
+        bpm = static_cast<int>(grid->bpm + 0.5);
+    }
+    print_analysis(grid.get(), duration_seconds);
+}
+
+std::shared_ptr<const BeatGrid> WAVTrack::measure_grid() const {
+    if (!file || !file->is_open()) return nullptr;
+    // Copies of an analyzed track carry its grid; otherwise ask the shared cache
+    if (beat_grid) return beat_grid;
+    std::shared_ptr<WavFile> source = file;
+    return AnalysisCache::instance().beat_grid("WAV", get_title(), file->content_hash(), [source]() {
+        return BeatAnalyzer().analyze(source->pcm(), source->sample_rate());
+    });
+}
+
+void WAVTrack::print_analysis(const BeatGrid* grid, int seconds) const {
+    LogSink::out() << "[WAVTrack::analyze_beatgrid] Analyzing beat grid for: \"" << get_title() << "\"\n";
     // TODO: Implement WAV-specific beat detection analysis
     // Requirements:
     // 1. Print analysis message with track title
     // 2. Calculate beats: (duration_seconds / 60.0) * bpm
     // 3. Print number of beats and mention uncompressed precision
     // should print "  → Estimated beats: <beats>  → Precision factor: 1.0 (uncompressed audio)"
-    double beats_estimated = (duration_seconds / 60.0) * bpm;
+    if (grid && grid->valid()) {
+        std::ostringstream detail;
+        detail << std::fixed << std::setprecision(2) << grid->bpm << " BPM, first beat at "
+               << grid->first_beat << "s, confidence " << grid->confidence;
+        LogSink::out() << "  → Detected beats: " << grid->beat_count << "  → Tempo: " << detail.str() << std::endl;
+        return;
+    }
+    if (grid) {
+        LogSink::out() << "  → [WARNING] No steady tempo in " << file->get_path() << "; keeping " << bpm << " BPM" << std::endl;
+    }
+    double beats_estimated = (seconds / 60.0) * bpm;
 
-    std::cout << "  → Estimated beats: " << (int)beats_estimated << "  → Precision factor: 1 (uncompressed audio)" << std::endl; 
+    LogSink::out() << "  → Estimated beats: " << (int)beats_estimated << "  → Precision factor: 1 (uncompressed audio)" << std::endl; 
+}
+
+void WAVTrack::prepare() const {
+    int rate = sample_rate;
+    int depth = bit_depth;
+    int seconds = duration_seconds;
+    bool mapped = read_header(rate, depth, seconds);
+    print_load(mapped, rate, depth, seconds);
+    std::shared_ptr<const BeatGrid> grid = measure_grid();
+    print_analysis(grid.get(), seconds);
+}
+
+bool WAVTrack::apply_cached_beatgrid() {
+    if (!file || !file->open()) return false;
+    std::shared_ptr<const BeatGrid> grid = AnalysisCache::instance().find("WAV", get_title(), file->content_hash());
+    if (!grid || !grid->valid()) return false;
+    beat_grid = grid;
+    bpm = static_cast<int>(grid->bpm + 0.5);
+    return true;
 }
 
 double WAVTrack::get_quality_score() const {
@@ -54,7 +152,7 @@ double WAVTrack::get_quality_score() const {
     if (quality >= 100.0) quality = 100.0;
     
     #ifdef DEBUG
-    std::cout << "[WAVTrack::get_quality_score] \"" << title << "\" score = " << (int)quality << "/100" << std::endl;
+    std::cout << "[WAVTrack::get_quality_score] \"" << get_title() << "\" score = " << (int)quality << "/100" << std::endl;
     #endif
     
     return quality;
@@ -63,4 +161,12 @@ double WAVTrack::get_quality_score() const {
 PointerWrapper<AudioTrack> WAVTrack::clone() const {
     // TODO: Implement the clone method
     return PointerWrapper<AudioTrack>(new WAVTrack(*this)); // Replace with your implementation
+}
+
+size_t WAVTrack::get_memory_footprint() const {
+    // Uncompressed stereo PCM, same estimate load() reports
+    size_t payload = static_cast<size_t>(duration_seconds > 0 ? duration_seconds : 0)
+                   * static_cast<size_t>(sample_rate > 0 ? sample_rate : 0)
+                   * static_cast<size_t>(bit_depth > 0 ? bit_depth / 8 : 0) * 2;
+    return AudioTrack::get_memory_footprint() + (sizeof(WAVTrack) - sizeof(AudioTrack)) + payload;
 }
\ No newline at end of file
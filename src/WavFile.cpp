@@ -0,0 +1,200 @@
+#include "WavFile.h"
+#include <cstring>
+
+// RIFF fields are little-endian and not necessarily aligned
+static uint16_t read_u16(const unsigned char* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static uint32_t read_u32(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+         | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static const uint16_t FORMAT_PCM = 1;
+static const uint16_t FORMAT_FLOAT = 3;
+static const uint16_t FORMAT_EXTENSIBLE = 0xFFFE;
+
+double PcmView::sample(size_t frame, int channel) const {
+    const unsigned char* p = bytes + frame * block_align + static_cast<size_t>(channel) * (bits_per_sample / 8);
+    if (is_float) {
+        float value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+    switch (bits_per_sample) {
+        case 8:
+            return (static_cast<int>(p[0]) - 128) / 128.0;
+        case 16:
+            return static_cast<int16_t>(read_u16(p)) / 32768.0;
+        case 24: {
+            int32_t value = static_cast<int32_t>(static_cast<uint32_t>(p[0] | (p[1] << 8) | (p[2] << 16)) << 8) >> 8;
+            return value / 8388608.0;
+        }
+        default:
+            return static_cast<int32_t>(read_u32(p)) / 2147483648.0;
+    }
+}
+
+// One tight loop per sample format, so scanning runs at memory speed
+size_t PcmView::decode(size_t first, size_t count, float* out) const {
+    if (first >= frames) return 0;
+    if (count > frames - first) count = frames - first;
+    const unsigned char* p = bytes + first * block_align;
+    size_t n = count * static_cast<size_t>(channels);
+
+    if (is_float) {
+        std::memcpy(out, p, n * sizeof(float));
+    } else if (bits_per_sample == 16) {
+        for (size_t i = 0; i < n; ++i, p += 2) {
+            out[i] = static_cast<int16_t>(read_u16(p)) * (1.0f / 32768.0f);
+        }
+    } else if (bits_per_sample == 24) {
+        for (size_t i = 0; i < n; ++i, p += 3) {
+            int32_t value = static_cast<int32_t>(static_cast<uint32_t>(p[0] | (p[1] << 8) | (p[2] << 16)) << 8) >> 8;
+            out[i] = value * (1.0f / 8388608.0f);
+        }
+    } else if (bits_per_sample == 8) {
+        for (size_t i = 0; i < n; ++i, ++p) {
+            out[i] = (static_cast<int>(*p) - 128) * (1.0f / 128.0f);
+        }
+    } else {
+        for (size_t i = 0; i < n; ++i, p += 4) {
+            out[i] = static_cast<float>(static_cast<int32_t>(read_u32(p)) * (1.0 / 2147483648.0));
+        }
+    }
+    return count;
+}
+
+WavFile::WavFile(const std::string& path)
+    : lock(), path(path), attempted(false), error(), mapping(), view(), rate(0), hash(0) {}
+
+WavFile::~WavFile() {}
+
+bool WavFile::open() {
+    std::lock_guard<std::mutex> guard(lock);
+    if (attempted) return mapping.is_mapped();
+    attempted = true;
+
+    if (!mapping.map(path, error)) return false;
+    if (mapping.size() < 12) {
+        error = "file too small";
+        mapping.unmap();
+        return false;
+    }
+    if (!parse(error)) {
+        mapping.unmap();
+        view = PcmView();
+        return false;
+    }
+    mapping.advise_sequential();
+    return true;
+}
+
+// Walk the chunk list; fmt must precede data, unknown chunks are skipped
+bool WavFile::parse(std::string& why) {
+    const unsigned char* base = mapping.data();
+    size_t mapped_bytes = mapping.size();
+    if (std::memcmp(base, "RIFF", 4) != 0 || std::memcmp(base + 8, "WAVE", 4) != 0) {
+        why = "not a RIFF/WAVE file";
+        return false;
+    }
+
+    bool have_format = false;
+    size_t offset = 12;
+    while (offset + 8 <= mapped_bytes) {
+        const unsigned char* chunk = base + offset;
+        size_t size = read_u32(chunk + 4);
+        size_t body = offset + 8;
+        size_t available = mapped_bytes - body;
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            if (size < 16 || size > available) {
+                why = "truncated fmt chunk";
+                return false;
+            }
+            const unsigned char* fmt = base + body;
+            uint16_t tag = read_u16(fmt);
+            if (tag == FORMAT_EXTENSIBLE && size >= 40) tag = read_u16(fmt + 24);   // SubFormat GUID
+            view.channels = read_u16(fmt + 2);
+            rate = static_cast<int>(read_u32(fmt + 4));
+            view.block_align = read_u16(fmt + 12);
+            view.bits_per_sample = read_u16(fmt + 14);
+            view.is_float = (tag == FORMAT_FLOAT);
+
+            bool supported = (tag == FORMAT_PCM && (view.bits_per_sample == 8 || view.bits_per_sample == 16
+                                                    || view.bits_per_sample == 24 || view.bits_per_sample == 32))
+                          || (tag == FORMAT_FLOAT && view.bits_per_sample == 32);
+            if (!supported || view.channels == 0 || rate <= 0
+                || view.block_align != static_cast<size_t>(view.channels) * (view.bits_per_sample / 8)) {
+                why = "unsupported sample format";
+                return false;
+            }
+            have_format = true;
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            if (!have_format) {
+                why = "data chunk before fmt chunk";
+                return false;
+            }
+            // Streaming writers leave the size at 0 or 0xFFFFFFFF; take what the file holds
+            if (size == 0 || size > available) size = available;
+            view.bytes = base + body;
+            view.frames = size / view.block_align;
+            return true;
+        }
+        offset = body + size + (size & 1);     // chunks are padded to even sizes
+    }
+    why = have_format ? "no data chunk" : "no fmt chunk";
+    return false;
+}
+
+bool WavFile::is_open() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return mapping.is_mapped();
+}
+
+std::string WavFile::get_error() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return error;
+}
+
+int WavFile::sample_rate() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return mapping.is_mapped() ? rate : 0;
+}
+
+int WavFile::bit_depth() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return view.bits_per_sample;
+}
+
+int WavFile::channels() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return view.channels;
+}
+
+size_t WavFile::frame_count() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return view.frames;
+}
+
+double WavFile::duration_seconds() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return mapping.is_mapped() ? static_cast<double>(view.frames) / rate : 0.0;
+}
+
+size_t WavFile::file_bytes() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return mapping.size();
+}
+
+PcmView WavFile::pcm() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return view;
+}
+
+uint64_t WavFile::content_hash() {
+    std::lock_guard<std::mutex> guard(lock);
+    if (hash == 0) hash = mapping.content_hash();
+    return hash;
+}
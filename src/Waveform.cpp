@@ -0,0 +1,343 @@
+#include "Waveform.h"
+#include "WaveformKernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <random>
+
+// Process-wide counters behind get_stats()
+static std::atomic<size_t> allocations(0);
+static std::atomic<size_t> bytes_allocated(0);
+static std::atomic<size_t> bytes_copied(0);
+static std::atomic<size_t> releases(0);
+
+/**
+ * Budget-managed waveforms, MRU at head. Lock order: registry, then a
+ * waveform's own lock; never the other way round.
+ */
+struct WaveformRegistry {
+    std::mutex lock;
+    Waveform* head;
+    Waveform* tail;
+    size_t resident_bytes;
+    std::atomic<size_t> budget;
+
+    WaveformRegistry() : lock(), head(nullptr), tail(nullptr), resident_bytes(0), budget(0) {}
+};
+static WaveformRegistry registry;
+
+const char* waveform_format_name(WaveformFormat format) {
+    switch (format) {
+        case WAVEFORM_F32: return "f32";
+        case WAVEFORM_I16: return "i16";
+        case WAVEFORM_PEAKS: return "peaks";
+        case WAVEFORM_F64: break;
+    }
+    return "f64";
+}
+
+bool parse_waveform_format(const std::string& name, WaveformFormat& format) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+
+    if (lower == "f64" || lower == "double") format = WAVEFORM_F64;
+    else if (lower == "f32" || lower == "float") format = WAVEFORM_F32;
+    else if (lower == "i16" || lower == "int16") format = WAVEFORM_I16;
+    else if (lower == "peaks" || lower == "mipmap") format = WAVEFORM_PEAKS;
+    else return false;
+    return true;
+}
+
+// ========== MIPMAP ==========
+
+const size_t WaveformMipmap::BASE_BLOCK;
+
+void WaveformMipmap::build(const double* samples, size_t n) {
+    levels.clear();
+    if (n == 0) return;
+
+    std::vector<PeakRms> base((n + BASE_BLOCK - 1) / BASE_BLOCK);
+    for (size_t b = 0; b < base.size(); ++b) {
+        size_t start = b * BASE_BLOCK;
+        size_t count = std::min(BASE_BLOCK, n - start);
+        double peak = 0.0;
+        double sumsq = 0.0;
+        WaveformKernels::peak_sumsq(samples + start, count, peak, sumsq);
+        base[b].peak = static_cast<float>(peak);
+        base[b].rms = static_cast<float>(std::sqrt(sumsq / count));
+    }
+    levels.push_back(std::move(base));
+
+    // Pairwise reduction; RMS is weighted by the samples each block covers
+    while (levels.back().size() > 1) {
+        const std::vector<PeakRms>& below = levels.back();
+        size_t below_block = block_size(levels.size() - 1);
+        std::vector<PeakRms> above((below.size() + 1) / 2);
+        for (size_t b = 0; b < above.size(); ++b) {
+            const PeakRms& left = below[2 * b];
+            size_t left_count = std::min(below_block, n - 2 * b * below_block);
+            if (2 * b + 1 == below.size()) {
+                above[b] = left;
+                continue;
+            }
+            const PeakRms& right = below[2 * b + 1];
+            size_t right_count = std::min(below_block, n - (2 * b + 1) * below_block);
+            double sumsq = double(left.rms) * left.rms * left_count + double(right.rms) * right.rms * right_count;
+            above[b].peak = std::max(left.peak, right.peak);
+            above[b].rms = static_cast<float>(std::sqrt(sumsq / (left_count + right_count)));
+        }
+        levels.push_back(std::move(above));
+    }
+}
+
+size_t WaveformMipmap::bytes() const {
+    size_t total = 0;
+    for (const auto& level : levels) total += level.size() * sizeof(PeakRms);
+    return total;
+}
+
+size_t WaveformMipmap::bytes_for(size_t samples) {
+    size_t total = 0;
+    size_t blocks = (samples + BASE_BLOCK - 1) / BASE_BLOCK;
+    while (blocks > 0) {
+        total += blocks * sizeof(PeakRms);
+        if (blocks == 1) break;
+        blocks = (blocks + 1) / 2;
+    }
+    return total;
+}
+
+// ========== STORAGE ==========
+
+static size_t format_bytes(WaveformFormat format, size_t samples) {
+    switch (format) {
+        case WAVEFORM_F32: return samples * sizeof(float);
+        case WAVEFORM_I16: return samples * sizeof(int16_t);
+        case WAVEFORM_PEAKS: return WaveformMipmap::bytes_for(samples);
+        case WAVEFORM_F64: break;
+    }
+    return samples * sizeof(double);
+}
+
+size_t WaveformStorage::bytes() const {
+    return format_bytes(format, samples);
+}
+
+void WaveformStorage::copy_to(double* out, size_t n) const {
+    if (n > samples) n = samples;
+    switch (format) {
+        case WAVEFORM_F64: std::copy(f64.begin(), f64.begin() + n, out); break;
+        case WAVEFORM_F32: WaveformKernels::f32_to_f64(f32.data(), out, n); break;
+        case WAVEFORM_I16: WaveformKernels::i16_to_f64(i16.data(), out, n); break;
+        case WAVEFORM_PEAKS: Waveform::generate(seed, out, n); break;
+    }
+}
+
+// ========== WAVEFORM ==========
+
+Waveform::Waveform(size_t samples, uint64_t seed, WaveformFormat format)
+    : lock(), data(), samples(samples), seed(seed), format(format), dirty(false),
+      lru_prev(nullptr), lru_next(nullptr), listed(false), listed_bytes(0) {}
+
+// The storage is immutable once published, so copies share it; mutable_data() detaches
+Waveform::Waveform(const Waveform& other)
+    : lock(), data(), samples(other.samples), seed(other.seed), format(WAVEFORM_F64), dirty(false),
+      lru_prev(nullptr), lru_next(nullptr), listed(false), listed_bytes(0) {
+    std::lock_guard<std::mutex> guard(other.lock);
+    data = other.data;
+    format = other.format;
+    dirty = other.dirty;
+}
+
+Waveform::~Waveform() {
+    unlist();
+}
+
+bool Waveform::resident() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return static_cast<bool>(data);
+}
+
+WaveformFormat Waveform::get_format() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return format;
+}
+
+size_t Waveform::storage_bytes() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return format_bytes(format, samples);
+}
+
+void Waveform::set_format(WaveformFormat new_format) {
+    bool dropped = false;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (dirty || format == new_format) return;
+        format = new_format;
+        if (data) {
+            data.reset();
+            dropped = true;
+        }
+    }
+    if (dropped) {
+        releases++;
+        unlist();
+    }
+}
+
+WaveformSamples Waveform::acquire() const {
+    std::shared_ptr<WaveformStorage> pinned = materialize();
+    if (registry.budget > 0) touch();
+    return WaveformSamples(pinned);
+}
+
+double* Waveform::mutable_data() {
+    std::shared_ptr<WaveformStorage> pinned = materialize();
+    if (!pinned) return nullptr;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        // Detach from copies and readers, converting to f64 on the way
+        if (data.use_count() > 2 || data->format != WAVEFORM_F64) {
+            std::shared_ptr<WaveformStorage> own = std::allocate_shared<WaveformStorage>(
+                SlabAllocator<WaveformStorage>(), WAVEFORM_F64, samples, seed);
+            own->f64.resize(samples);
+            data->copy_to(own->f64.data(), samples);
+            allocations++;
+            bytes_allocated += samples * sizeof(double);
+            if (data->format == WAVEFORM_F64) bytes_copied += samples * sizeof(double);
+            data = own;
+        }
+        pinned = data;
+        format = WAVEFORM_F64;
+        dirty = true;
+    }
+    unlist();   // edits cannot be regenerated, so the budget may not release them
+    return pinned->f64.data();
+}
+
+bool Waveform::release() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!data || dirty) return false;
+        data.reset();
+    }
+    releases++;
+    unlist();
+    return true;
+}
+
+void Waveform::generate(uint64_t seed, double* out, size_t n) {
+    // Dummy analysis data, reproducible per track
+    std::mt19937 gen(static_cast<std::mt19937::result_type>(seed ^ (seed >> 32)));
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = dis(gen);
+    }
+}
+
+std::shared_ptr<WaveformStorage> Waveform::materialize() const {
+    std::lock_guard<std::mutex> guard(lock);
+    if (data || samples == 0) return data;
+
+    std::shared_ptr<WaveformStorage> built = std::allocate_shared<WaveformStorage>(
+        SlabAllocator<WaveformStorage>(), format, samples, seed);
+    if (format == WAVEFORM_F64) {
+        built->f64.resize(samples);
+        generate(seed, built->f64.data(), samples);
+    } else {
+        std::vector<double> scratch(samples);
+        generate(seed, scratch.data(), samples);
+        switch (format) {
+            case WAVEFORM_F32:
+                built->f32.resize(samples);
+                WaveformKernels::f64_to_f32(scratch.data(), built->f32.data(), samples);
+                break;
+            case WAVEFORM_I16:
+                built->i16.resize(samples);
+                WaveformKernels::f64_to_i16(scratch.data(), built->i16.data(), samples);
+                break;
+            case WAVEFORM_PEAKS:
+                built->mipmap.build(scratch.data(), samples);
+                break;
+            case WAVEFORM_F64:
+                break;
+        }
+    }
+    allocations++;
+    bytes_allocated += built->bytes();
+    data = built;
+    return data;
+}
+
+// Move to the MRU end of the registry, then release from the LRU end until within budget
+void Waveform::touch() const {
+    std::lock_guard<std::mutex> registry_guard(registry.lock);
+    Waveform* self = const_cast<Waveform*>(this);
+
+    if (listed) {
+        if (registry.head == self) return;
+        lru_prev->lru_next = lru_next;
+        if (lru_next) lru_next->lru_prev = lru_prev;
+        else registry.tail = lru_prev;
+    } else {
+        // A concurrent release() may have emptied it since acquire()
+        std::lock_guard<std::mutex> guard(lock);
+        if (!data || dirty) return;
+        self->listed = true;
+        self->listed_bytes = data->bytes();
+        registry.resident_bytes += listed_bytes;
+    }
+    self->lru_prev = nullptr;
+    self->lru_next = registry.head;
+    if (registry.head) registry.head->lru_prev = self;
+    registry.head = self;
+    if (!registry.tail) registry.tail = self;
+
+    while (registry.resident_bytes > registry.budget && registry.tail != self) {
+        Waveform* victim = registry.tail;
+        registry.tail = victim->lru_prev;
+        registry.tail->lru_next = nullptr;
+        victim->lru_prev = nullptr;
+        victim->listed = false;
+        registry.resident_bytes -= victim->listed_bytes;
+
+        std::lock_guard<std::mutex> victim_guard(victim->lock);
+        victim->data.reset();
+        releases++;
+    }
+}
+
+void Waveform::unlist() const {
+    std::lock_guard<std::mutex> registry_guard(registry.lock);
+    if (!listed) return;
+    Waveform* self = const_cast<Waveform*>(this);
+
+    if (lru_prev) lru_prev->lru_next = lru_next;
+    else registry.head = lru_next;
+    if (lru_next) lru_next->lru_prev = lru_prev;
+    else registry.tail = lru_prev;
+    self->lru_prev = nullptr;
+    self->lru_next = nullptr;
+    self->listed = false;
+    registry.resident_bytes -= listed_bytes;
+}
+
+void Waveform::set_memory_budget(size_t bytes) {
+    registry.budget = bytes;
+}
+
+size_t Waveform::memory_budget() {
+    return registry.budget;
+}
+
+WaveformStats Waveform::get_stats() {
+    WaveformStats stats;
+    stats.allocations = allocations;
+    stats.bytes_allocated = bytes_allocated;
+    stats.bytes_copied = bytes_copied;
+    stats.releases = releases;
+    std::lock_guard<std::mutex> registry_guard(registry.lock);
+    stats.resident_bytes = registry.resident_bytes;
+    return stats;
+}
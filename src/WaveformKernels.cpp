@@ -0,0 +1,138 @@
+#include "WaveformKernels.h"
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+static const double I16_SCALE = 32767.0;
+
+// ========== SCALAR ==========
+
+void WaveformKernels::f64_to_f32_scalar(const double* in, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = static_cast<float>(in[i]);
+}
+
+void WaveformKernels::f32_to_f64_scalar(const float* in, double* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = in[i];
+}
+
+void WaveformKernels::f64_to_i16_scalar(const double* in, int16_t* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        double scaled = std::nearbyint(in[i] * I16_SCALE);
+        if (scaled > 32767.0) scaled = 32767.0;
+        if (scaled < -32768.0) scaled = -32768.0;
+        out[i] = static_cast<int16_t>(scaled);
+    }
+}
+
+void WaveformKernels::i16_to_f64_scalar(const int16_t* in, double* out, size_t n) {
+    const double inv = 1.0 / I16_SCALE;
+    for (size_t i = 0; i < n; ++i) out[i] = in[i] * inv;
+}
+
+void WaveformKernels::peak_sumsq_scalar(const double* in, size_t n, double& peak, double& sumsq) {
+    double p = 0.0, s = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        double a = std::fabs(in[i]);
+        if (a > p) p = a;
+        s += in[i] * in[i];
+    }
+    peak = p;
+    sumsq = s;
+}
+
+// ========== SSE2 ==========
+
+#ifdef __SSE2__
+
+bool WaveformKernels::vectorized() { return true; }
+
+void WaveformKernels::f64_to_f32(const double* in, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(in + i));
+        __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(in + i + 2));
+        _mm_storeu_ps(out + i, _mm_movelh_ps(lo, hi));
+    }
+    f64_to_f32_scalar(in + i, out + i, n - i);
+}
+
+void WaveformKernels::f32_to_f64(const float* in, double* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(in + i);
+        _mm_storeu_pd(out + i, _mm_cvtps_pd(v));
+        _mm_storeu_pd(out + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+    f32_to_f64_scalar(in + i, out + i, n - i);
+}
+
+void WaveformKernels::f64_to_i16(const double* in, int16_t* out, size_t n) {
+    const __m128d scale = _mm_set1_pd(I16_SCALE);
+    const __m128d lo_clamp = _mm_set1_pd(-32768.0);
+    const __m128d hi_clamp = _mm_set1_pd(32767.0);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i q[4];
+        for (int k = 0; k < 4; ++k) {
+            __m128d v = _mm_mul_pd(_mm_loadu_pd(in + i + 2 * k), scale);
+            v = _mm_min_pd(_mm_max_pd(v, lo_clamp), hi_clamp);
+            q[k] = _mm_cvtpd_epi32(v);      // round to nearest, two int32 in the low half
+        }
+        __m128i a = _mm_unpacklo_epi64(q[0], q[1]);
+        __m128i b = _mm_unpacklo_epi64(q[2], q[3]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(a, b));
+    }
+    f64_to_i16_scalar(in + i, out + i, n - i);
+}
+
+void WaveformKernels::i16_to_f64(const int16_t* in, double* out, size_t n) {
+    const __m128d inv = _mm_set1_pd(1.0 / I16_SCALE);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        // sign-extend to int32: put each int16 in the high half, then shift down
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_pd(out + i,     _mm_mul_pd(_mm_cvtepi32_pd(lo), inv));
+        _mm_storeu_pd(out + i + 2, _mm_mul_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(lo, 0x4E)), inv));
+        _mm_storeu_pd(out + i + 4, _mm_mul_pd(_mm_cvtepi32_pd(hi), inv));
+        _mm_storeu_pd(out + i + 6, _mm_mul_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(hi, 0x4E)), inv));
+    }
+    i16_to_f64_scalar(in + i, out + i, n - i);
+}
+
+void WaveformKernels::peak_sumsq(const double* in, size_t n, double& peak, double& sumsq) {
+    const __m128d sign = _mm_set1_pd(-0.0);
+    __m128d p = _mm_setzero_pd();
+    __m128d s = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d v = _mm_loadu_pd(in + i);
+        p = _mm_max_pd(p, _mm_andnot_pd(sign, v));
+        s = _mm_add_pd(s, _mm_mul_pd(v, v));
+    }
+    double lanes_p[2], lanes_s[2];
+    _mm_storeu_pd(lanes_p, p);
+    _mm_storeu_pd(lanes_s, s);
+    double tail_p = 0.0, tail_s = 0.0;
+    peak_sumsq_scalar(in + i, n - i, tail_p, tail_s);
+    peak = lanes_p[0] > lanes_p[1] ? lanes_p[0] : lanes_p[1];
+    if (tail_p > peak) peak = tail_p;
+    sumsq = lanes_s[0] + lanes_s[1] + tail_s;
+}
+
+#else
+
+bool WaveformKernels::vectorized() { return false; }
+
+void WaveformKernels::f64_to_f32(const double* in, float* out, size_t n) { f64_to_f32_scalar(in, out, n); }
+void WaveformKernels::f32_to_f64(const float* in, double* out, size_t n) { f32_to_f64_scalar(in, out, n); }
+void WaveformKernels::f64_to_i16(const double* in, int16_t* out, size_t n) { f64_to_i16_scalar(in, out, n); }
+void WaveformKernels::i16_to_f64(const int16_t* in, double* out, size_t n) { i16_to_f64_scalar(in, out, n); }
+void WaveformKernels::peak_sumsq(const double* in, size_t n, double& peak, double& sumsq) {
+    peak_sumsq_scalar(in, n, peak, sumsq);
+}
+
+#endif
@@ -0,0 +1,103 @@
+#include "WorkStealingPool.h"
+
+// Worker identity of the calling thread, so nested submits stay local
+static thread_local const WorkStealingPool* current_pool = nullptr;
+static thread_local size_t current_worker = 0;
+
+WorkStealingPool::WorkStealingPool(size_t threads)
+    : queues(), workers(), queued(0), stolen(0), unfinished(0), next_queue(0), stopping(false),
+      first_error(), lock(), work_ready(), all_done() {
+    if (threads == 0) threads = 1;
+    queues.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) queues.push_back(PointerWrapper<TaskQueue>(new TaskQueue()));
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers.push_back(std::thread(&WorkStealingPool::run, this, i));
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    size_t target;
+    {
+        // Count the task before it becomes visible, so it cannot finish first
+        std::lock_guard<std::mutex> guard(lock);
+        target = current_pool == this ? current_worker : next_queue++ % queues.size();
+        unfinished++;
+        queued++;
+    }
+    {
+        std::lock_guard<std::mutex> guard(queues[target]->lock);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+    work_ready.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> guard(lock);
+    all_done.wait(guard, [this] { return unfinished == 0; });
+    if (first_error) {
+        std::exception_ptr error = first_error;
+        first_error = std::exception_ptr();
+        std::rethrow_exception(error);
+    }
+}
+
+bool WorkStealingPool::take(size_t self, std::function<void()>& task) {
+    {
+        // Own deque, newest first: its data is most likely still in cache
+        TaskQueue& own = *queues[self];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued--;
+            return true;
+        }
+    }
+    for (size_t k = 1; k < queues.size(); ++k) {
+        // Steal the oldest task of the next worker that has any
+        TaskQueue& victim = *queues[(self + k) % queues.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued--;
+            stolen++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::run(size_t self) {
+    current_pool = this;
+    current_worker = self;
+    while (true) {
+        std::function<void()> task;
+        if (take(self, task)) {
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(lock);
+                if (!first_error) first_error = std::current_exception();
+            }
+            task = nullptr;     // release captures before wait() can return
+            std::lock_guard<std::mutex> guard(lock);
+            if (--unfinished == 0) all_done.notify_all();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(lock);
+        work_ready.wait(guard, [this] { return stopping || queued > 0; });
+        if (stopping && queued == 0) return;    // stopping and drained
+    }
+}
@@ -1,3 +1,4 @@
+#include <cstdlib>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -162,9 +163,24 @@ int main(int argc, char* argv[]) {
      * Command-line argument parsing
      * - If "-I" is provided as the first argument, run interactive DJ software
      * - If "-A" is provided as the second argument, enable play_all mode
+     * - "-B [threads] [sidecar]" runs batch beat analysis of the library instead
+     * - "-O [playlist]" reorders one playlist (default: all of them) for smoother transitions
      */
     bool run_software = false;
     bool play_all = false;
+
+    // -B [threads] [sidecar]: pre-analyze the whole library and exit
+    if (argc > 1 && std::string(argv[1]) == "-B") {
+        size_t threads = argc > 2 ? static_cast<size_t>(std::strtoul(argv[2], nullptr, 10)) : 0;
+        std::string sidecar = argc > 3 ? argv[3] : "bin/library_analysis.bin";
+        DJSession batch_session("Batch Analysis");
+        return batch_session.run_batch_analysis(threads, sidecar) ? 0 : 1;
+    }
+    // -O [playlist]: print the optimized playlist order and exit
+    if (argc > 1 && std::string(argv[1]) == "-O") {
+        DJSession optimizer_session("Playlist Optimizer");
+        return optimizer_session.run_playlist_optimizer(argc > 2 ? argv[2] : "") ? 0 : 1;
+    }
     if (argc > 1 && std::string(argv[1]) == "-I") {
         run_software = true;
     }
@@ -0,0 +1,117 @@
+/**
+ * cache_sim - offline, trace-driven controller cache simulator
+ *
+ * Replays a recorded sequence of track requests through LRUCache in
+ * key-only mode (no tracks are built, nothing is logged per operation) and
+ * reports hit ratio, evictions and ns/op for every policy and capacity.
+ *
+ * Trace format: one track title per line; empty lines and lines starting
+ * with '#' are ignored. DJSession writes such a file when the config sets
+ * session_trace_file=<path>.
+ *
+ * Usage: bin/cache_sim <trace_file> [policies] [capacities]
+ *   policies    comma separated, e.g. lru,arc,tinylfu (default: all)
+ *   capacities  comma separated list (e.g. 2,4,8) or min:max:step
+ *               (default: powers of two up to the number of distinct tracks)
+ */
+#include "LRUCache.h"
+#include "CachePolicy.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+static std::vector<std::string> split(const std::string& str, char delimiter) {
+    std::vector<std::string> parts;
+    std::stringstream ss(str);
+    std::string part;
+    while (std::getline(ss, part, delimiter)) {
+        if (!part.empty()) parts.push_back(part);
+    }
+    return parts;
+}
+
+static bool load_trace(const std::string& path, std::vector<std::string>& requests) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+        if (line.empty() || line[0] == '#') continue;
+        requests.push_back(line);
+    }
+    return true;
+}
+
+static std::vector<size_t> parse_capacities(const std::string& spec, size_t distinct) {
+    std::vector<size_t> capacities;
+    if (spec.empty()) {
+        for (size_t c = 1; c < distinct; c *= 2) capacities.push_back(c);
+        capacities.push_back(distinct > 0 ? distinct : 1);
+        return capacities;
+    }
+
+    std::vector<std::string> range = split(spec, ':');
+    if (range.size() == 3) {
+        size_t lo = std::strtoul(range[0].c_str(), nullptr, 10);
+        size_t hi = std::strtoul(range[1].c_str(), nullptr, 10);
+        size_t step = std::strtoul(range[2].c_str(), nullptr, 10);
+        for (size_t c = lo; c <= hi && step > 0; c += step) capacities.push_back(c);
+        return capacities;
+    }
+    for (const std::string& c : split(spec, ',')) {
+        capacities.push_back(std::strtoul(c.c_str(), nullptr, 10));
+    }
+    return capacities;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: %s <trace_file> [policies] [capacities]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<std::string> requests;
+    if (!load_trace(argv[1], requests)) {
+        std::fprintf(stderr, "[ERROR] Cannot open trace file: %s\n", argv[1]);
+        return 1;
+    }
+    std::unordered_set<std::string> distinct(requests.begin(), requests.end());
+
+    std::vector<std::string> policies = (argc > 2) ? split(argv[2], ',') : cache_policy_names();
+    std::vector<size_t> capacities = parse_capacities(argc > 3 ? argv[3] : "", distinct.size());
+
+    std::printf("trace: %s (%zu requests, %zu distinct tracks)\n",
+                argv[1], requests.size(), distinct.size());
+    std::printf("%-10s %10s %10s %10s %12s %10s\n",
+                "policy", "capacity", "hits", "hit ratio", "evictions", "ns/op");
+
+    for (const std::string& name : policies) {
+        if (!make_cache_policy(name)) {
+            std::fprintf(stderr, "[WARNING] Unknown policy '%s' skipped\n", name.c_str());
+            continue;
+        }
+        for (size_t capacity : capacities) {
+            LRUCache cache(capacity, make_cache_policy(name));
+
+            size_t hits = 0;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (const std::string& request : requests) {
+                if (cache.touch(request)) hits++;
+            }
+            double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count());
+
+            double ratio = requests.empty() ? 0.0 : static_cast<double>(hits) / requests.size();
+            std::printf("%-10s %10zu %10zu %9.2f%% %12zu %10.1f\n",
+                        cache.policy_name(), capacity, hits, ratio * 100.0,
+                        cache.eviction_count(), requests.empty() ? 0.0 : ns / requests.size());
+        }
+    }
+    return 0;
+}